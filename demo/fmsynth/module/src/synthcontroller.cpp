@@ -6,6 +6,8 @@
 
 #include <audio/object/multiply.h>
 
+#include <algorithm>
+
 // RTTI definitions
 
 RTTI_BEGIN_CLASS(nap::SynthController)
@@ -43,6 +45,8 @@ namespace nap
         mResource->mFrequencyModulation->valueChanged.connect(fmChangedSlot);
         mResource->mVoicing->valueChanged.connect(voicingChangedSlot);
         mResource->mFilterResonance->valueChanged.connect(filterResonanceChangedSlot);
+        mResource->mFilterCutoff->valueChanged.connect(filterModulationChangedSlot);
+        mResource->mEnvelopeModulation->valueChanged.connect(filterModulationChangedSlot);
         mResource->mWaveform->valueChanged.connect(waveformChangedSlot);
         mResource->mReverbLevel->valueChanged.connect(reverbLevelChangedSlot);
 
@@ -92,33 +96,13 @@ namespace nap
             return false;
         if (!mPolyphonic->getObjectMap("Envelope", mEnvelopes, errorState))
             return false;
+        if (!mPolyphonic->getObjectMap("FilterModulation", mFilterModulations, errorState))
+            return false;
 
         return true;
     }
 
 
-    void SynthControllerInstance::update(double deltaTime)
-    {
-        // Iterate through all playing voices to update their filter cutoff frequencies
-        // This is done on update because the cutoff frequency modulates with the ADSR envelope value
-        for (auto& pair : mNoteVoices)
-        {
-            // Grab the filter and the envelope for the playing voice
-            auto voice = pair.second;
-            auto filter = mFilters[voice]->getChannel(0);
-            auto envelope = mEnvelopes[voice];
-
-            auto cutoff = audio::mtof(mResource->mFilterCutoff->mValue); // Convert cutoff frequency parameter midi note value to Hz
-            auto envelopeValue = envelope->getValue(); // Get current ADSR envelope output
-            auto freq = math::lerp(cutoff, envelopeValue * cutoff, mResource->mEnvelopeModulation->mValue); // Combine cutoff parameter and ADSR value using envelope modulation parameter
-            // Make sure cutoff frequency value doesn't blow up in subsonic range and set the filter frequency
-            if (freq < 20.f)
-                freq = 20.f;
-            filter->setFrequency(freq);
-        }
-    }
-
-
     void SynthControllerInstance::noteOn(const MidiEvent& event)
     {
         // A note on event with velocity zero is handled as a note off
@@ -166,10 +150,6 @@ namespace nap
         oscB->setFrequency(freq, glideTime);
 
         auto filter = mFilters[voice]->getChannel(0); // Because the filter is mono we operate on channel 0
-        // Calculate the cutoff frequency of the filter, avoid low subsonic cutoff frequencies
-        auto cutoffFreq = audio::mtof(math::lerp<float>(mResource->mFilterCutoff->mValue, 0.0, mResource->mEnvelopeModulation->mValue));
-        if (cutoffFreq < 20.f)
-            cutoffFreq = 20.f;
 
         // Update the ADSR envelope's segment data
         auto envelope = mEnvelopes[voice];
@@ -177,6 +157,9 @@ namespace nap
         envelope->setSegmentData(1, mResource->mDecay->mValue, mResource->mSustain->mValue, false, true, true);
         envelope->setSegmentData(2, mResource->mRelease->mValue, 0, false, true, false);
 
+        // Let the envelope sweep the filter cutoff frequency on the audio thread, starting from the unmodulated cutoff frequency
+        auto cutoffFreq = updateFilterModulation(voice);
+
         // Update the note voice map and last played note variable for internal administration
         mNoteVoices[event.getNoteNumber()] = voice;
         mLastPlayedNote = event.getNoteNumber();
@@ -196,8 +179,8 @@ namespace nap
                 mMonophonicVoice = voice; // Update the pointer to the voice playing the monophonic line
             }
             else {
-                // If we are continuing an already playing monophonic line, just update the filter of the playing voice.
-                filter->setFrequency(cutoffFreq);
+                // If we are continuing an already playing monophonic line, just update the filter resonance of the playing voice.
+                // The cutoff frequency is driven by the modulation matrix.
                 filter->setResonance(mResource->mFilterResonance->mValue);
             }
         }
@@ -264,6 +247,28 @@ namespace nap
     }
 
 
+    void SynthControllerInstance::filterModulationChanged(float)
+    {
+        // Update the cutoff modulation of the filters in all playing voices
+        for (auto& pair : mNoteVoices)
+            updateFilterModulation(pair.second);
+    }
+
+
+    float SynthControllerInstance::updateFilterModulation(audio::VoiceInstance* voice)
+    {
+        // The cutoff frequency is lerp(cutoff, envelope * cutoff, envelopeModulation), written as a base value plus the envelope scaled by a depth.
+        // The matrix clamps the result to avoid subsonic cutoff frequencies.
+        auto cutoff = audio::mtof(mResource->mFilterCutoff->mValue);
+        auto modulation = mResource->mEnvelopeModulation->mValue;
+        auto base = cutoff * (1.f - modulation);
+        auto matrix = mFilterModulations[voice];
+        matrix->setBase(0, base);
+        matrix->setDepth(0, cutoff * modulation);
+        return std::max(base, 20.f);
+    }
+
+
     void SynthControllerInstance::waveformChanged(int value)
     {
         // Update the waveform for the carrier oscillators in all playing voices
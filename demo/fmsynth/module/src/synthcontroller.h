@@ -12,6 +12,7 @@
 #include <audio/object/oscillator.h>
 #include <audio/object/filter.h>
 #include <audio/object/envelope.h>
+#include <audio/object/modulationmatrix.h>
 
 #include <midiinputcomponent.h>
 
@@ -35,6 +36,7 @@ namespace nap
      * This component contains all the logic about the polyphonic FM synthesizer.
      * It responds to midi input and parameter changes by manipulating and playing voices within a Polyphonic object.
      * Each voice of the polyphonic synth has a carrier oscillator that can be set to sine, saw or squarewave mode and a modulating lowpassfilter.
+     * The cutoff frequency of the filter follows the ADSR envelope through a modulation matrix in the voice, which runs on the audio thread.
      * The frequency of the carrier oscillator can be modulated by another modulator oscillator.
      */
     class SynthController : public Component
@@ -75,7 +77,6 @@ namespace nap
 
         // Inherited from ComponentInstance
         bool init(utility::ErrorState &errorState) override;
-        void update(double deltaTime) override;
 
     private:
         // Slots to respond to incoming midi note events
@@ -91,11 +92,17 @@ namespace nap
         void voicingChanged(int);
         Slot<float> filterResonanceChangedSlot = { this, &SynthControllerInstance::filterResonanceChanged };
         void filterResonanceChanged(float);
+        Slot<float> filterModulationChangedSlot = { this, &SynthControllerInstance::filterModulationChanged };
+        void filterModulationChanged(float);
         Slot<int> waveformChangedSlot = { this, &SynthControllerInstance::waveformChanged };
         void waveformChanged(int);
         Slot<float> reverbLevelChangedSlot = { this, &SynthControllerInstance::reverbLevelChanged };
         void reverbLevelChanged(float);
 
+        // Updates the base cutoff frequency and the envelope modulation depth of the filter of a voice from the parameters.
+        // Returns the cutoff frequency at the start of the envelope.
+        float updateFilterModulation(audio::VoiceInstance* voice);
+
         SynthController* mResource = nullptr; // Pointer to this component's resource
         audio::PolyphonicInstance* mPolyphonic = nullptr; // Polyphonic object performing the DSP for the synthesizer's voices
 
@@ -107,6 +114,7 @@ namespace nap
         audio::PolyphonicInstance::ObjectMap<audio::OscillatorInstance> mModulatorOscillators; // This is a helper map with the modulator oscillator object for each voice mapped to its voice  for lookup purposes
         audio::PolyphonicInstance::ObjectMap<audio::OscillatorInstance> mCarrierOscillators; // This is a helper map with the carrier oscillator object for each voice mapped to its voice for lookup purposes
         audio::PolyphonicInstance::ObjectMap<audio::FilterInstance> mFilters; // This is a helper map with the filter object for each voice mapped to its voice for lookup purposes
+        audio::PolyphonicInstance::ObjectMap<audio::ModulationMatrixInstance> mFilterModulations; // This is a helper map with the modulation matrix that sweeps the filter cutoff for each voice mapped to its voice for lookup purposes
         audio::ControlInstance* mReverbLevelControl = nullptr; // Pointer to the control object that controls the level of the reverberated signal
 
         ComponentInstancePtr<audio::AudioComponent> mAudioComponent = { this, &SynthController::mAudioComponent }; // Sibling AudioComponent that contains all the DSP objects in a audio::GraphObject
@@ -14,7 +14,7 @@ if(NAP_BUILD_CONTEXT MATCHES "source")
     add_source_dir("node" "src/audio/node" ${AUDIO_FILE_SUPPORT_FILTER})
     add_source_dir("object" "src/audio/object" ${AUDIO_FILE_SUPPORT_FILTER})
     add_source_dir("component" "src/audio/component")
-    add_source_dir("service" "src/audio/service")
+    add_source_dir("service" "src/audio/service" ${AUDIO_FILE_SUPPORT_FILTER})
     add_source_dir("resource" "src/audio/resource" ${AUDIO_FILE_SUPPORT_FILTER})
     add_source_dir("utility" "src/audio/utility")
 endif()
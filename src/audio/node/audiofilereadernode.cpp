@@ -4,6 +4,9 @@
 
 #include "audiofilereadernode.h"
 
+// Std includes
+#include <algorithm>
+
 // Audio includes
 #include <audio/core/audionodemanager.h>
 
@@ -14,90 +17,157 @@ namespace nap
     {
 
 
-        AudioFileReaderNode::AudioFileReaderNode(NodeManager& nodeManager, unsigned int bufferSize) : Node(nodeManager)
+        AudioFileReaderNode::AudioFileReaderNode(NodeManager& nodeManager, int channelCount, TimeValue readAhead, ControllerValue maxSpeed, int cueCount) :
+            Node(nodeManager), mReadAhead(readAhead), mMaxSpeed(std::max(maxSpeed, 0.f)), mCueCount(cueCount)
         {
-            mCircularBuffer.resize(bufferSize);
-            mDiskReadBuffer.resize(getBufferSize());
-
-            mThread.start();
+            for (auto channel = 0; channel < channelCount; ++channel)
+                mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+            mScratch.resize(PolyphaseResampler::ScratchSize);
+            mSpeed = std::min(1.f, mMaxSpeed);
+            mService = StreamingService::get(nodeManager);
         }
 
 
 		void AudioFileReaderNode::setPlaying(bool value)
 		{
-			assert(mAudioFileDescriptor != nullptr);
-			mPlaying = value ? 1 : 0;
+			assert(mFileStream != nullptr);
+			mPlaying = value;
 		}
 
 
+        void AudioFileReaderNode::setLooping(bool value)
+        {
+            mLooping = value;
+            if (mFileStream != nullptr)
+                mFileStream->setLooping(value);
+        }
+
+
         void AudioFileReaderNode::setAudioFile(const SafePtr<AudioFileDescriptor>& audioFileDescriptor)
         {
 			assert(audioFileDescriptor != nullptr);
-			assert(mPlaying == 0); // cannot set audio file descriptor while playing
-            mAudioFileDescriptor = audioFileDescriptor;
-            mWritePosition = 0;
-            mReadPosition = 0;
-			auto framesRead = mAudioFileDescriptor->read(&mCircularBuffer[0], mDiskReadBuffer.size());
-			if (framesRead != mDiskReadBuffer.size())
-			{
-				if (mLooping)
-					mAudioFileDescriptor->seek(0);
-				else
-					mPlaying = 0;
-			}
-			mWritePosition = framesRead;
+			assert(!mPlaying); // cannot set audio file descriptor while playing
+			assert(audioFileDescriptor->getChannelCount() == getChannelCount());
+
+            // Release the streams the audio thread no longer uses here, so they are never destroyed on the audio thread
+            auto inUse = mStreamInUse.load(std::memory_order_acquire);
+            mRetiredStreams.erase(std::remove_if(mRetiredStreams.begin(), mRetiredStreams.end(), [inUse](auto& retired){ return retired.first < inUse; }), mRetiredStreams.end());
+            if (mFileStream != nullptr)
+                mRetiredStreams.emplace_back(mStreamCount, std::move(mFileStream));
+
+            auto readAhead = StreamingService::getReadAhead(mReadAhead, mMaxSpeed, audioFileDescriptor->getSampleRate());
+            mFileStream = mService->createStream<AudioFileStream>(audioFileDescriptor, readAhead, mCueCount);
+            mFileStream->setLooping(mLooping);
+
+            auto stream = mFileStream.get();
+            auto number = ++mStreamCount;
+            getNodeManager().enqueueTask([&, stream, number](){
+                mStream = stream;
+                mPosition = 0.;
+                mStreamInUse.store(number, std::memory_order_release);
+            });
+        }
+
+
+        void AudioFileReaderNode::setQuality(PolyphaseResampler::Quality quality)
+        {
+            mQuality = quality;
+            PolyphaseResampler resampler(quality);
+            getNodeManager().enqueueTask([&, resampler](){
+                mResampler = resampler;
+            });
+        }
+
+
+        void AudioFileReaderNode::setCue(int index, DiscreteTimeValue frame)
+        {
+            assert(mFileStream != nullptr);
+            mFileStream->setCue(index, frame);
+        }
+
+
+        int AudioFileReaderNode::getUnderrunCount() const
+        {
+            return mFileStream != nullptr ? mFileStream->getUnderrunCount() : 0;
         }
 
 
         void AudioFileReaderNode::process()
         {
-            auto& outputBuffer = getOutputBuffer(audioOutput);
+            auto stream = mStream;
+            auto bufferSize = getBufferSize();
+            auto channelCount = std::min(getChannelCount(), stream != nullptr ? stream->getChannelCount() : 0);
 
-            if (mPlaying == 0)
+            if (stream != nullptr)
             {
-                for (auto i = 0; i < outputBuffer.size(); ++i)
-                    outputBuffer[i] = 0.f;
-                return;
+                auto seek = mSeekRequest.exchange(NoSeek);
+                if (seek != NoSeek)
+                {
+                    stream->seek(seek);
+                    mPosition = 0.;
+                }
+                auto cue = mCueRequest.exchange(-1);
+                if (cue >= 0)
+                {
+                    stream->cue(cue);
+                    mPosition = 0.;
+                }
             }
 
-            for (auto i = 0; i < outputBuffer.size(); ++i)
+            auto i = 0;
+            if (stream != nullptr && mPlaying.load())
             {
-                if (mReadPosition < mWritePosition)
+                auto speed = double(mSpeed.load()) * stream->getSampleRate() / getNodeManager().getSampleRate();
+                // Check the end first, so the available frames include the last frames of the file when it has been reached
+                auto endReached = stream->isEndReached();
+                auto available = stream->getAvailable();
+
+                // Render as far as the resampler has frames that have been read from disk, at the end of the file it reads silence
+                auto limit = endReached ? double(available) : double(available) - mResampler.getPadding(speed) - 1;
+                if (mPosition < limit)
+                    i = speed > 0. ? int(std::min<double>(bufferSize, std::ceil((limit - mPosition) / speed))) : bufferSize;
+
+                for (auto channel = 0; channel < channelCount; ++channel)
                 {
-                    int mReadPositionFloor = int(mReadPosition);
-                    float remainder = mReadPosition - mReadPositionFloor;
-                    SampleValue start = mCircularBuffer[wrap(mReadPositionFloor, mCircularBuffer.size())];
-                    SampleValue end = mCircularBuffer[wrap(mReadPositionFloor + 1, mCircularBuffer.size())];
-                    auto value = lerp(start, end, remainder);
-                    outputBuffer[i] = value;
-                    mReadPosition += mAudioFileDescriptor->getSampleRate() / getNodeManager().getSampleRate();
+                    auto reader = [stream, available, channel](float* destination, int64_t first, int count)
+                    {
+                        for (auto j = 0; j < count; ++j)
+                        {
+                            auto frame = first + j;
+                            destination[j] = frame >= 0 && frame < int64_t(available) ? stream->getSample(frame, channel) : 0.f;
+                        }
+                    };
+                    mResampler.process(reader, mPosition, speed, getOutputBuffer(*mOutputs[channel]).data(), i, mScratch.data());
+                }
+                mPosition += speed * i;
+
+                // Keep the frames before the position the resampler may still read
+                auto consumed = std::min<int64_t>(int64_t(mPosition) - mResampler.getMaxPadding(), available);
+                if (consumed > 0)
+                {
+                    stream->consume(consumed);
+                    mPosition -= consumed;
+                }
+                stream->setConsumptionRate(speed * getNodeManager().getSampleRate());
+
+                if (i < bufferSize)
+                {
+                    if (endReached)
+                    {
+                        // Rewind, so the next playback starts at the beginning of the file
+                        mPlaying = false;
+                        stream->seek(0);
+                        mPosition = 0.;
+                    }
+                    else
+                        stream->reportUnderrun();
                 }
-                else
-                    outputBuffer[i] = 0.f;
             }
-            if (mReadPosition > mWritePosition - mDiskReadBuffer.size())
+
+            for (auto channel = 0; channel < getChannelCount(); ++channel)
             {
-               mThread.enqueue([&](){
-                   if (mPlaying == 0)
-                       return;
-                   auto framesRead = mAudioFileDescriptor->read(mDiskReadBuffer.data(), mDiskReadBuffer.size());
-                   if (framesRead != mDiskReadBuffer.size())
-                   {
-                       if (mLooping)
-                           mAudioFileDescriptor->seek(0);
-                       else
-                           mPlaying = 0;
-                   }
-                   int wrappedWritePos = wrap(mWritePosition, mCircularBuffer.size());
-                   for (auto i = 0; i < framesRead; ++i)
-                   {
-                       mCircularBuffer[wrappedWritePos] = mDiskReadBuffer[i];
-                       wrappedWritePos++;
-                       if (wrappedWritePos >= mCircularBuffer.size())
-                           wrappedWritePos = 0;
-                   }
-                   mWritePosition += framesRead;
-               });
+                auto& outputBuffer = getOutputBuffer(*mOutputs[channel]);
+                std::fill(outputBuffer.begin() + (channel < channelCount ? i : 0), outputBuffer.end(), 0.f);
             }
         }
 
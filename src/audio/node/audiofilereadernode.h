@@ -4,13 +4,18 @@
 
 #pragma once
 
-// Nap includes
-#include <utility/threading.h>
+// Std includes
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
 
 // Audio includes
 #include <audio/core/audionode.h>
 #include <audio/resource/audiofileio.h>
-#include <audio/utility/audiofunctions.h>
+#include <audio/service/audiofilestream.h>
+#include <audio/service/streamingservice.h>
+#include <audio/utility/polyphaseresampler.h>
 
 namespace nap
 {
@@ -19,62 +24,148 @@ namespace nap
     {
 
 		/**
-		* Node used to read an audio signal from an audio file using an @AudioFileDescriptor.
-		*/
+		 * Node used to stream an audio file from disk using an @AudioFileDescriptor.
+		 * The file is read ahead by the shared I/O threads of the @StreamingService, the node itself does not start any threads.
+		 * Files with any number of interleaved channels are supported, every channel of the file has its own output pin.
+		 * Playback can start immediately at a seek position or, without waiting for the disk, at a cue whose first frames are preloaded.
+		 * Differences in sample rate and playback speed are resampled by a @PolyphaseResampler, medium quality by default.
+		 */
 		class NAPAPI AudioFileReaderNode : public Node
         {
             RTTI_ENABLE(Node)
 
         public:
-            AudioFileReaderNode(NodeManager& nodeManager, unsigned int bufferSize);
+            /**
+             * Constructor
+             * @param nodeManager The node manager this node is processed on.
+             * @param channelCount Number of output channels, should match the number of channels of the audio file.
+             * @param readAhead Time in ms that is read ahead of the playback position to cover the latency of the disk.
+             * @param maxSpeed Maximum playback speed, the read ahead is scaled by it.
+             * @param cueCount Number of cues that can be set.
+             */
+            AudioFileReaderNode(NodeManager& nodeManager, int channelCount = 1, TimeValue readAhead = 500.f, ControllerValue maxSpeed = 1.f, int cueCount = 0);
 
 			/**
-			 * Sets the audio file descriptor. Needs to ba called before starting playback.
+			 * Sets the audio file descriptor and reads the first frames. Needs to be called before starting playback.
+			 * This method and the other methods that are not marked otherwise should all be called from the same thread.
 			 * @param audioFileDescriptor to read audio from
 			 */
             void setAudioFile(const SafePtr<AudioFileDescriptor>& audioFileDescriptor);
 
 			/**
 			 * Starts playback. setAudioFile() needs to be called first.
+			 * Playback stops by itself at the end of the file if it is not looping, and the next playback starts at the beginning of the file.
 			 */
 			void setPlaying(bool value);
 
 			/**
-			 * @return wether the node is currently playing back.
+			 * @return wether the node is currently playing back. Can be called from any thread.
 			 */
-            bool isPlaying() const { return mPlaying > 0; }
+            bool isPlaying() const { return mPlaying.load(); }
 
 			/**
 			 * Specifies if the audio file will loop.
 			 * @param value True if the audio file will loop, false if not
 			 */
-            void setLooping(bool value) { mLooping = value ? 1 : 0; }
+            void setLooping(bool value);
 
 			/**
 			 * @return whether the audio file is looping.
 			 */
-            bool isLooping() const { return mLooping > 0; }
+            bool isLooping() const { return mLooping; }
+
+            /**
+             * @param speed Playback speed, 1 plays the file at its own sample rate. Clamped between 0 and the maximum speed. Can be called from any thread.
+             */
+            void setSpeed(ControllerValue speed) { mSpeed = std::min(std::max(speed, 0.f), mMaxSpeed); }
+
+            /**
+             * @return The playback speed
+             */
+            ControllerValue getSpeed() const { return mSpeed.load(); }
+
+            /**
+             * @param quality Quality of the resampling
+             */
+            void setQuality(PolyphaseResampler::Quality quality);
+
+            /**
+             * @return Quality of the resampling
+             */
+            PolyphaseResampler::Quality getQuality() const { return mQuality.load(); }
+
+            /**
+             * Continues playback at another position in the file. The frames after the new position are read with the next refill of the stream.
+             * @param frame Frame in the file
+             */
+            void seek(DiscreteTimeValue frame) { mSeekRequest = frame; }
 
             /**
-             * Connect this pin to another node's input
+             * Sets a cue. The frames after the cue are preloaded by the streaming service.
+             * @param index Index of the cue, smaller than the cue count.
+             * @param frame Frame in the file the cue points to.
              */
-            OutputPin audioOutput = { this };
+            void setCue(int index, DiscreteTimeValue frame);
+
+            /**
+             * Continues playback at a cue, starting with its preloaded frames.
+             * @param index Index of the cue, smaller than the cue count.
+             */
+            void cue(int index) { mCueRequest = index; }
+
+            /**
+             * @return Number of cues that can be set.
+             */
+            int getCueCount() const { return mCueCount; }
+
+            /**
+             * @return The number of times playback needed frames that had not been read from disk yet, since the audio file was set.
+             */
+            int getUnderrunCount() const;
+
+            /**
+             * @param channel Index of the channel
+             * @return The output pin of the channel
+             */
+            OutputPin& getOutput(int channel) { return *mOutputs[channel]; }
+
+            /**
+             * @return Number of output channels
+             */
+            int getChannelCount() const { return mOutputs.size(); }
 
         private:
-            void process() override;
+            static constexpr DiscreteTimeValue NoSeek = -1;
 
-            WorkerThread mThread;
-            SafePtr<AudioFileDescriptor> mAudioFileDescriptor = nullptr;
-            SampleBuffer mCircularBuffer;
-            SampleBuffer mDiskReadBuffer;
-            DiscreteTimeValue mWritePosition = 0;
-            double mReadPosition = 0;
-			std::atomic<int> mPlaying = { 0 };
-            std::atomic<int> mLooping = { 0 };
+            void process() override;
 
+            std::vector<std::unique_ptr<OutputPin>> mOutputs;
+            TimeValue mReadAhead = 500.f;
+            ControllerValue mMaxSpeed = 1.f;
+            int mCueCount = 0;
+            bool mLooping = false;
+
+            std::shared_ptr<StreamingService> mService = nullptr; // Declared before the streams, so they are released before its threads are joined
+
+            // Control thread, owns the streams. Replaced streams are kept until the audio thread has switched to a newer one.
+            std::shared_ptr<AudioFileStream> mFileStream = nullptr;
+            std::vector<std::pair<int, std::shared_ptr<AudioFileStream>>> mRetiredStreams; // Replaced streams with their number
+            int mStreamCount = 0;                                   // Number of the current stream
+
+            AudioFileStream* mStream = nullptr;                     // The stream as seen by the audio thread
+            std::atomic<int> mStreamInUse = { 0 };                  // Number of the stream the audio thread has switched to
+            double mPosition = 0.;                                  // Fractional frame position relative to the read position of the stream
+            PolyphaseResampler mResampler;
+            std::vector<float> mScratch;
+            std::atomic<PolyphaseResampler::Quality> mQuality = { PolyphaseResampler::Quality::Medium };
+
+            std::atomic<bool> mPlaying = { false };
+            std::atomic<ControllerValue> mSpeed = { 1.f };
+            std::atomic<DiscreteTimeValue> mSeekRequest = { NoSeek };
+            std::atomic<int> mCueRequest = { -1 };
         };
 
 
     }
 
-}
\ No newline at end of file
+}
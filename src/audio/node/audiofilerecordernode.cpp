@@ -0,0 +1,226 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "audiofilerecordernode.h"
+
+// Std includes
+#include <algorithm>
+#include <chrono>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::AudioFileRecorderNode)
+	RTTI_FUNCTION("setRecording", &nap::audio::AudioFileRecorderNode::setRecording)
+	RTTI_FUNCTION("isRecording", &nap::audio::AudioFileRecorderNode::isRecording)
+	RTTI_FUNCTION("startAt", &nap::audio::AudioFileRecorderNode::startAt)
+	RTTI_FUNCTION("stopAt", &nap::audio::AudioFileRecorderNode::stopAt)
+	RTTI_FUNCTION("getOverrunCount", &nap::audio::AudioFileRecorderNode::getOverrunCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		AudioFileRecorderNode::AudioFileRecorderNode(NodeManager& nodeManager, int channelCount, unsigned int bufferSize, bool rootProcess) : Node(nodeManager), mRootProcess(rootProcess)
+		{
+			for (auto channel = 0; channel < channelCount; ++channel)
+				mInputs.emplace_back(std::make_unique<InputPin>(this));
+			mInputBuffers.resize(channelCount, nullptr);
+
+			mCapacity = 1;
+			while (mCapacity < bufferSize)
+				mCapacity *= 2;
+			mRing.resize(size_t(mCapacity) * channelCount, 0.f);
+			mSilence.resize(size_t(ChunkSize) * channelCount, 0.f);
+
+			mThread = std::thread([this](){ run(); });
+			if (mRootProcess)
+				nodeManager.registerRootProcess(*this);
+		}
+
+
+		AudioFileRecorderNode::~AudioFileRecorderNode()
+		{
+			if (mRootProcess)
+				getNodeManager().unregisterRootProcess(*this);
+			mRunning = false;
+			mThread.join();
+		}
+
+
+		void AudioFileRecorderNode::setAudioFile(const SafePtr<AudioFileDescriptor>& audioFileDescriptor)
+		{
+			assert(audioFileDescriptor != nullptr);
+			assert(audioFileDescriptor->getChannelCount() == getChannelCount());
+			assert(!mRecording); // cannot set file descriptor while recording
+			std::lock_guard<std::mutex> lock(mFileMutex);
+			mAudioFileDescriptor = audioFileDescriptor;
+		}
+
+
+		void AudioFileRecorderNode::startAt(DiscreteTimeValue sampleTime)
+		{
+			mNewStop = Never;
+			mNewStart = sampleTime;
+			mIsDirty.set();
+		}
+
+
+		void AudioFileRecorderNode::stopAt(DiscreteTimeValue sampleTime)
+		{
+			mNewStop = sampleTime;
+			mIsDirty.set();
+		}
+
+
+		void AudioFileRecorderNode::setRecording(bool recording)
+		{
+			if (recording)
+				startAt(0);
+			else
+				stopAt(0);
+		}
+
+
+		void AudioFileRecorderNode::process()
+		{
+			if (mIsDirty.check())
+			{
+				mStart = mNewStart.load();
+				mStop = mNewStop.load();
+			}
+
+			// The part of this buffer within the recording interval
+			const auto bufferSize = getBufferSize();
+			const auto bufferStart = getNodeManager().getSampleTime();
+			auto toBufferIndex = [&](DiscreteTimeValue sampleTime) {
+				return sampleTime <= bufferStart ? 0 : int(std::min<DiscreteTimeValue>(sampleTime - bufferStart, bufferSize));
+			};
+			const auto begin = toBufferIndex(mStart);
+			const auto end = toBufferIndex(mStop);
+			mRecording = mStart <= bufferStart + bufferSize && mStop > bufferStart + bufferSize;
+
+			// The inputs are pulled every buffer, so the upstream graph keeps running while nothing is recorded
+			const auto channelCount = getChannelCount();
+			for (auto channel = 0; channel < channelCount; ++channel)
+				mInputBuffers[channel] = mInputs[channel]->pull();
+
+			auto writePosition = mWritePosition.load(std::memory_order_relaxed);
+			if (begin >= end)
+			{
+				publishGap(writePosition);
+				return;
+			}
+
+			const auto frameCount = DiscreteTimeValue(end - begin);
+			if (frameCount > mCapacity - (writePosition - mReadPosition.load(std::memory_order_acquire)))
+			{
+				// The disk does not keep up, the dropped frames will be written as silence
+				mPendingGap += frameCount;
+				mOverrunCount++;
+				mDroppedFrameCount += frameCount;
+				return;
+			}
+			publishGap(writePosition);
+
+			// Interleave the inputs into the ring buffer
+			const auto mask = mCapacity - 1;
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				auto input = mInputBuffers[channel];
+				for (auto i = begin; i < end; ++i)
+				{
+					auto index = (writePosition + i - begin) & mask;
+					mRing[index * channelCount + channel] = input != nullptr ? (*input)[i] : 0.f;
+				}
+			}
+			mWritePosition.store(writePosition + frameCount, std::memory_order_release);
+		}
+
+
+		void AudioFileRecorderNode::publishGap(DiscreteTimeValue writePosition)
+		{
+			if (mPendingGap == 0)
+				return;
+
+			// When the queue is full the gap is queued later, at a later position in the file
+			auto count = mGapWriteCount.load(std::memory_order_relaxed);
+			if (count - mGapReadCount.load(std::memory_order_acquire) >= GapQueueSize)
+				return;
+
+			mGaps[count % GapQueueSize] = { writePosition, mPendingGap };
+			mGapWriteCount.store(count + 1, std::memory_order_release);
+			mPendingGap = 0;
+		}
+
+
+		void AudioFileRecorderNode::run()
+		{
+			while (mRunning.load())
+			{
+				// Wait for a large chunk while recording, write everything that is left after recording has stopped
+				if (!write(!mRecording.load()))
+					std::this_thread::sleep_for(std::chrono::milliseconds(PollInterval));
+			}
+			write(true);
+		}
+
+
+		bool AudioFileRecorderNode::write(bool flush)
+		{
+			std::lock_guard<std::mutex> lock(mFileMutex);
+			if (mAudioFileDescriptor == nullptr)
+				return false;
+
+			// Gaps are queued at positions that had been written already, so loading the gaps first keeps them within the written frames
+			const auto channelCount = getChannelCount();
+			const auto gapWriteCount = mGapWriteCount.load(std::memory_order_acquire);
+			const auto written = mWritePosition.load(std::memory_order_acquire);
+			auto read = mReadPosition.load(std::memory_order_relaxed);
+			auto gapCount = mGapReadCount.load(std::memory_order_relaxed);
+			const auto hasGap = [&]() { return gapCount != gapWriteCount; };
+
+			if (!flush && !hasGap() && written - read < std::min(ChunkSize, mCapacity / 4))
+				return false;
+			if (read == written && !hasGap())
+				return false;
+
+			while (read < written || hasGap())
+			{
+				// Silence in place of dropped frames
+				if (hasGap() && mGaps[gapCount % GapQueueSize].mPosition <= read)
+				{
+					auto remaining = mGaps[gapCount % GapQueueSize].mLength;
+					while (remaining > 0)
+					{
+						auto frames = std::min<DiscreteTimeValue>(remaining, ChunkSize);
+						mAudioFileDescriptor->write(mSilence.data(), frames * channelCount);
+						mWrittenFrameCount += frames;
+						remaining -= frames;
+					}
+					mGapReadCount.store(++gapCount, std::memory_order_release);
+					continue;
+				}
+
+				// Frames up to the next gap, split where the ring buffer wraps around
+				auto end = std::min<DiscreteTimeValue>(written, read + ChunkSize);
+				if (hasGap())
+					end = std::min(end, mGaps[gapCount % GapQueueSize].mPosition);
+				auto index = read & (mCapacity - 1);
+				auto frames = std::min<DiscreteTimeValue>(end - read, mCapacity - index);
+				mAudioFileDescriptor->write(&mRing[index * channelCount], frames * channelCount);
+				read += frames;
+				mWrittenFrameCount += frames;
+				mReadPosition.store(read, std::memory_order_release);
+			}
+
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,167 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/resource/audiofileio.h>
+#include <audio/utility/dirtyflag.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Records any number of channels into one interleaved audio file.
+		 * The audio thread interleaves the inputs into a lock free ring buffer of several seconds, a single writer thread owned by the node
+		 * writes it to disk in large chunks, so the disk can stall for the length of the ring buffer without losing audio.
+		 * When the ring buffer does overflow the block is counted as an overrun and replaced by silence in the file, so the timeline of the recording stays intact.
+		 * Recording starts and stops at exact sample times of the @NodeManager.
+		 */
+		class NAPAPI AudioFileRecorderNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			static constexpr DiscreteTimeValue Never = std::numeric_limits<DiscreteTimeValue>::max();
+			static constexpr unsigned int ChunkSize = 16384; ///< Maximum number of frames the writer thread writes at once
+			static constexpr int PollInterval = 10;           ///< Time in ms between checks of the writer thread for new frames
+
+			/**
+			 * Differs to the default signature of @Node constructors and therefore cannot be wrapped in a NodeObject.
+			 * @param nodeManager @NodeManager that de Node will be processed by.
+			 * @param channelCount Number of channels
+			 * @param bufferSize Size of the ring buffer in frames, rounded up to a power of two.
+			 * @param rootProcess Indicates wether the node will be processed automatically by the @NodeManager.
+			 */
+			AudioFileRecorderNode(NodeManager& nodeManager, int channelCount, unsigned int bufferSize, bool rootProcess = true);
+
+			/**
+			 * Writes the frames that are left to the file and stops the writer thread.
+			 */
+			~AudioFileRecorderNode() override;
+
+			/**
+			 * @param channel Index of the channel
+			 * @return Input pin of the channel
+			 */
+			InputPin& getInput(int channel) { return *mInputs[channel]; }
+
+			/**
+			 * @return Number of channels
+			 */
+			int getChannelCount() const { return mInputs.size(); }
+
+			/**
+			 * Sets the file to record to, with the same number of channels as the node. Should not be called while recording.
+			 * @param audioFileDescriptor The file, opened for writing.
+			 */
+			void setAudioFile(const SafePtr<AudioFileDescriptor>& audioFileDescriptor);
+
+			/**
+			 * Starts recording at a sample time and cancels a scheduled stop.
+			 * @param sampleTime Sample time of the node manager of the first recorded sample. 0 starts with the next buffer.
+			 */
+			void startAt(DiscreteTimeValue sampleTime);
+
+			/**
+			 * Stops recording at a sample time.
+			 * @param sampleTime Sample time of the node manager of the first sample that is not recorded. 0 stops with the next buffer.
+			 */
+			void stopAt(DiscreteTimeValue sampleTime);
+
+			/**
+			 * Starts or stops recording with the next buffer.
+			 */
+			void setRecording(bool recording);
+
+			/**
+			 * @return Whether the last processed buffer ended while recording.
+			 */
+			bool isRecording() const { return mRecording.load(); }
+
+			/**
+			 * @return The number of buffers that did not fit in the ring buffer because the disk did not keep up.
+			 */
+			int getOverrunCount() const { return mOverrunCount.load(); }
+
+			/**
+			 * @return The number of frames that have been replaced by silence because of overruns.
+			 */
+			DiscreteTimeValue getDroppedFrameCount() const { return mDroppedFrameCount.load(); }
+
+			/**
+			 * @return The number of frames written to the file so far, including the silence of overruns.
+			 */
+			DiscreteTimeValue getWrittenFrameCount() const { return mWrittenFrameCount.load(); }
+
+		private:
+			// Silence that replaces dropped frames, inserted before the frame at mPosition of the ring buffer
+			struct Gap
+			{
+				DiscreteTimeValue mPosition = 0;
+				DiscreteTimeValue mLength = 0;
+			};
+
+			static constexpr int GapQueueSize = 64;
+
+			void process() override;
+
+			// Audio thread, queues the pending gap at the write position
+			void publishGap(DiscreteTimeValue writePosition);
+
+			// Writer thread
+			void run();
+			bool write(bool flush);
+
+			std::vector<std::unique_ptr<InputPin>> mInputs;
+			std::vector<SampleBuffer*> mInputBuffers;
+			bool mRootProcess = false;
+
+			// Ring buffer of interleaved frames, positions count frames since construction
+			std::vector<SampleValue> mRing;
+			unsigned int mCapacity = 0;
+			std::atomic<DiscreteTimeValue> mWritePosition = { 0 };
+			std::atomic<DiscreteTimeValue> mReadPosition = { 0 };
+
+			// Single producer single consumer queue of gaps
+			std::array<Gap, GapQueueSize> mGaps;
+			std::atomic<DiscreteTimeValue> mGapWriteCount = { 0 };
+			std::atomic<DiscreteTimeValue> mGapReadCount = { 0 };
+			DiscreteTimeValue mPendingGap = 0; // Dropped frames that have not been queued yet
+
+			// Recording interval, requested by the control thread and applied by the audio thread
+			std::atomic<DiscreteTimeValue> mNewStart = { Never };
+			std::atomic<DiscreteTimeValue> mNewStop = { Never };
+			DirtyFlag mIsDirty;
+			DiscreteTimeValue mStart = Never;
+			DiscreteTimeValue mStop = Never;
+
+			std::atomic<bool> mRecording = { false };
+			std::atomic<int> mOverrunCount = { 0 };
+			std::atomic<DiscreteTimeValue> mDroppedFrameCount = { 0 };
+			std::atomic<DiscreteTimeValue> mWrittenFrameCount = { 0 };
+
+			std::mutex mFileMutex; // Guards the file against changes while the writer thread writes
+			SafePtr<AudioFileDescriptor> mAudioFileDescriptor = nullptr;
+			std::vector<SampleValue> mSilence;
+			std::atomic<bool> mRunning = { true };
+			std::thread mThread;
+		};
+
+	}
+
+}
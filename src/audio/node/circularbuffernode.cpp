@@ -9,6 +9,8 @@
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::CircularBufferNode)
     RTTI_PROPERTY("audioInput", &nap::audio::CircularBufferNode::audioInput, nap::rtti::EPropertyMetaData::Embedded)
+    RTTI_FUNCTION("setFrozen", &nap::audio::CircularBufferNode::setFrozen)
+    RTTI_FUNCTION("isFrozen", &nap::audio::CircularBufferNode::isFrozen)
 RTTI_END_CLASS
 
 namespace nap
@@ -20,8 +22,11 @@ namespace nap
         
         CircularBufferNode::CircularBufferNode(NodeManager& nodeManager, unsigned int bufferSize, bool rootProcess) : Node(nodeManager), mRootProcess(rootProcess)
         {
-//            TODO check if bufferSize is power of two
-            mBuffer.resize(bufferSize);
+            unsigned int size = 1;
+            while (size < bufferSize)
+                size *= 2;
+            mBuffer.resize(size, 0.f);
+            mView = CircularBufferView(mBuffer.data(), size, mWritePosition);
             
             if (rootProcess)
                 getNodeManager().registerRootProcess(*this);
@@ -33,38 +38,26 @@ namespace nap
             if (mRootProcess)
                 getNodeManager().unregisterRootProcess(*this);
         }
-        
-        
+
+
         void CircularBufferNode::process()
         {
-			std::lock_guard<std::mutex> lock(mMutex);
-
-            auto inputBuffer = audioInput.pull();
-            if (inputBuffer == nullptr)
+            // Clearing writes a whole buffer of silence, so readers notice it like any other overwrite
+            if (mClear.exchange(false, std::memory_order_acquire))
             {
-                for (auto i = 0; i < getBufferSize(); ++i)
-                {
-                    mBuffer[wrap(mWritePosition, mBuffer.size())] = 0;
-                    mWritePosition++;
-                }
+                mWritePosition.beginWrite(mBuffer.size());
+                std::fill(mBuffer.begin(), mBuffer.end(), 0.f);
+                mWritePosition.endWrite();
             }
-            else {
-                for (float i : *inputBuffer)
-                {
-                    mBuffer[wrap(mWritePosition, mBuffer.size())] = i;
-                    mWritePosition++;
-                }
-            }
-        }
-
 
-		void CircularBufferNode::clear()
-		{
-			std::lock_guard<std::mutex> lock(mMutex);
+            auto inputBuffer = audioInput.pull();
+            if (mFrozen.load())
+                return;
 
-			for (auto i = 0; i < mBuffer.size(); ++i)
-				mBuffer[i] = 0.f;
-		}
+            auto writePosition = mWritePosition.beginWrite(getBufferSize());
+            writeCircularBuffer(mBuffer.data(), mBuffer.size(), writePosition, inputBuffer != nullptr ? inputBuffer->data() : nullptr, getBufferSize());
+            mWritePosition.endWrite();
+        }
 
 
     }
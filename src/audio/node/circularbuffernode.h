@@ -4,8 +4,11 @@
 
 #pragma once
 
+// Std includes
+#include <atomic>
+
 #include <audio/core/audionode.h>
-#include <audio/utility/audiofunctions.h>
+#include <audio/utility/circularbufferview.h>
 #include <audio/utility/safeptr.h>
 
 namespace nap
@@ -20,6 +23,9 @@ namespace nap
          * The write position wraps around when the end of the buffer has been reach. (hence the "circular")
          * Samples can be read from the circular buffer relatively to the write position.
          * Default will be processed as root process by the @NodeManager.
+         *
+         * The buffer is lock free with the audio thread as its single writer. Other threads can copy chunks of samples with read(), or through the @CircularBufferView returned by getView().
+         * The write position counts all samples written since construction, so it doubles as a sequence number to detect overruns.
          */
         class NAPAPI CircularBufferNode : public Node
         {
@@ -28,7 +34,7 @@ namespace nap
             /**
              * Differs to the default signature of @Node constructors and therefore cannot be wrapped in a NodeObject.
              * @param nodeManager @NodeManager that de Node will be processed by.
-             * @param bufferSize Size of the circular buffer. Has to be a power of two.
+             * @param bufferSize Size of the circular buffer, rounded up to a power of two.
              * @param rootProcess Indicates wether the @CircularBufferNode will be processed automatically by the @NodeManager.
              */
             CircularBufferNode(NodeManager& nodeManager, unsigned int bufferSize, bool rootProcess = true);
@@ -45,29 +51,75 @@ namespace nap
              * @param absolutePosition Absolute discrete sample position in the buffer, regardless of the current write position.
              * @return Value of the sample at the specified position.
              */
-            inline const SampleValue& getSample(const DiscreteTimeValue& absolutePosition) const { return mBuffer[wrap(absolutePosition, mBuffer.size())]; }
+            inline const SampleValue& getSample(const DiscreteTimeValue& absolutePosition) const { return mView.getSample(absolutePosition); }
 
             /**
              * Translates a position relative to the current write position to an absolute position.
              * @param relativePosition Position relative to the current write position.
              * @return Absolute position in the circular buffer.
              */
-            DiscreteTimeValue getAbsolutePosition(unsigned int relativePosition) const { return wrap(mWritePosition - relativePosition, mBuffer.size()); }
+            DiscreteTimeValue getAbsolutePosition(unsigned int relativePosition) const { return mView.getAbsolutePosition(relativePosition); }
+
+            /**
+             * @return The number of samples written to the buffer since construction. The next sample will be written at this position.
+             */
+            DiscreteTimeValue getWritePosition() const { return mView.getWritePosition(); }
+
+            /**
+             * @return The size of the buffer in samples.
+             */
+            unsigned int getSize() const { return mView.getSize(); }
+
+            /**
+             * Copies a contiguous range of samples, safe to call from any thread, see CircularBufferView::read().
+             * @param destination Receives count samples
+             * @param count Number of samples to read, at most the size of the buffer.
+             * @param fromPosition Write position of the first sample to read.
+             * @return The write position after copying the samples.
+             */
+            DiscreteTimeValue read(SampleValue* destination, unsigned int count, DiscreteTimeValue fromPosition) const { return mView.read(destination, count, fromPosition); }
+
+            /**
+             * Copies a contiguous range of samples into a buffer, see read(SampleValue*, unsigned int, DiscreteTimeValue).
+             * @param destination Receives destination.size() samples
+             * @param fromPosition Write position of the first sample to read.
+             * @return The write position after copying the samples.
+             */
+            DiscreteTimeValue read(SampleBuffer& destination, DiscreteTimeValue fromPosition) const { return read(destination.data(), destination.size(), fromPosition); }
 
 			/**
-			 * Clears the contents of the buffer. Either perform this on the audio thread or while the node is not processing.
+			 * Clears the contents of the buffer. Can be called from any thread, the buffer is cleared by the audio thread before it writes the next samples.
+			 * The clear counts as writing a whole buffer of silence: the write position advances by the size of the buffer, so reads that overlap the clear are detected as overruns.
 			 */
-			void clear();
+			void clear() { mClear.store(true, std::memory_order_release); }
+
+            /**
+             * Freezes the contents of the buffer: while frozen the input is still pulled, but not written and the write position does not advance.
+             * Readers that read relative to the write position, like the @GranularNode, keep reading the same material.
+             * @param frozen True to freeze the buffer, false to resume writing.
+             */
+            void setFrozen(bool frozen) { mFrozen.store(frozen); }
+
+            /**
+             * @return Whether the buffer is frozen.
+             */
+            bool isFrozen() const { return mFrozen.load(); }
+
+            /**
+             * @return Read access to the buffer that can be shared with other nodes, like the @CircularBufferPlayerNode.
+             */
+            const CircularBufferView& getView() const { return mView; }
             
         private:
             void process() override;
 
             SampleBuffer mBuffer;
-            DiscreteTimeValue mWritePosition = 0;
+            CircularBufferPosition mWritePosition;
+            CircularBufferView mView;
+            std::atomic<bool> mClear = { false }; // Set when the buffer has to be cleared before the next write
+            std::atomic<bool> mFrozen = { false };
             
             bool mRootProcess = false;
-
-			std::mutex mMutex; // Mutex lock to guard against probably false positive thread sanitizer warnings about process() and clear().
         };
         
     }
@@ -6,8 +6,9 @@
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::CircularBufferPlayerNode)
     RTTI_PROPERTY("audioOutput", &nap::audio::CircularBufferPlayerNode::audioOutput, nap::rtti::EPropertyMetaData::Embedded)
-    RTTI_FUNCTION("play", &nap::audio::CircularBufferPlayerNode::play)
+    RTTI_FUNCTION("play", static_cast<void (nap::audio::CircularBufferPlayerNode::*)(nap::audio::CircularBufferNode&, int, nap::audio::ControllerValue)>(&nap::audio::CircularBufferPlayerNode::play))
     RTTI_FUNCTION("stop", &nap::audio::CircularBufferPlayerNode::stop)
+    RTTI_FUNCTION("setQuality", &nap::audio::CircularBufferPlayerNode::setQuality)
 RTTI_END_CLASS
 
 namespace nap
@@ -18,6 +19,12 @@ namespace nap
         
         
         void CircularBufferPlayerNode::play(CircularBufferNode& buffer, int relativePosition, ControllerValue speed)
+        {
+            play(buffer.getView(), relativePosition, speed);
+        }
+
+
+        void CircularBufferPlayerNode::play(const CircularBufferView& buffer, int relativePosition, ControllerValue speed)
         {
             mNewRelativePosition = relativePosition;
             mNewSpeed = speed;
@@ -33,6 +40,16 @@ namespace nap
         }
         
         
+        void CircularBufferPlayerNode::setQuality(PolyphaseResampler::Quality quality)
+        {
+            mQuality = quality;
+            PolyphaseResampler resampler(quality);
+            getNodeManager().enqueueTask([&, resampler](){
+                mResampler = resampler;
+            });
+        }
+        
+        
         void CircularBufferPlayerNode::process()
         {
             auto& outputBuffer = getOutputBuffer(audioOutput);
@@ -42,10 +59,11 @@ namespace nap
                 mBuffer = mNewBuffer.load();
                 if (mBuffer)
                 {
-                    // We add one buffer size to the relative starting position of the playback.
-                    // This is to make sure we don't start playing back data after the write position of the buffer in case mNewRelativePosition is 0
-                    mPosition = mBuffer->getAbsolutePosition(mNewRelativePosition.load() + getBufferSize());
                     mSpeed = mNewSpeed.load();
+                    // We add one buffer size to the relative starting position of the playback.
+                    // This is to make sure we don't start playing back data after the write position of the buffer in case mNewRelativePosition is 0.
+                    // The resampler also reads a few samples ahead of the playback position.
+                    mPosition = mBuffer->getAbsolutePosition(mNewRelativePosition.load() + getBufferSize() + mResampler.getPadding(mSpeed) + 1);
                 }
             }
             
@@ -56,22 +74,10 @@ namespace nap
                 return;
             }
             
-            DiscreteTimeValue flooredPosition;
-            SampleValue lastValue, newValue, fractionalPart;
-            
-            // For each sample
-            for (auto i = 0; i < outputBuffer.size(); i++)
-            {
-                flooredPosition = DiscreteTimeValue(mPosition);
-                lastValue = mBuffer->getSample(flooredPosition);
-                newValue = mBuffer->getSample(flooredPosition + 1);
-                
-                fractionalPart = mPosition - flooredPosition;
-                
-                outputBuffer[i] = lastValue + (fractionalPart * (newValue - lastValue));
-                
-                mPosition += mSpeed;
-            }
+            auto& buffer = *mBuffer;
+            auto reader = [&buffer](float* destination, int64_t first, int count) { buffer.read(destination, count, DiscreteTimeValue(first)); };
+            mResampler.process(reader, mPosition, mSpeed, outputBuffer.data(), outputBuffer.size(), mScratch.data());
+            mPosition += double(mSpeed) * outputBuffer.size();
         }
         
         
@@ -13,6 +13,7 @@
 #include <audio/node/circularbuffernode.h>
 #include <audio/utility/safeptr.h>
 #include <audio/utility/dirtyflag.h>
+#include <audio/utility/polyphaseresampler.h>
 
 namespace nap
 {
@@ -21,14 +22,15 @@ namespace nap
     {
         
         /**
-         * Node to play back audio from a circular buffer
+         * Node to play back audio from a circular buffer.
+         * Playback at other speeds than 1 is resampled by a @PolyphaseResampler, medium quality by default.
          */
         class NAPAPI CircularBufferPlayerNode : public Node
         {
             RTTI_ENABLE(Node)
             
         public:
-            CircularBufferPlayerNode(NodeManager& manager) : Node(manager) { }
+            CircularBufferPlayerNode(NodeManager& manager) : Node(manager) { mScratch.resize(PolyphaseResampler::ScratchSize); }
         
             /**
              * The output to connect to other nodes
@@ -42,12 +44,31 @@ namespace nap
              * @param speed: the playbackspeed, 1.0 means 1 sample per sample, 2 means double speed, etc.
              */
             void play(CircularBufferNode& buffer, int relativePosition = 0, ControllerValue speed = 1.);
+
+            /**
+             * Tells the node to start playback from a view on a circular buffer, for example a channel of a @MultichannelCircularBufferNode.
+             * @param buffer: the view to play audio from. Has to stay alive while playing.
+             * @param relativePosition: the starting position in the source buffer in samples, relative to the current write position of the circular buffer.
+             * @param speed: the playbackspeed, 1.0 means 1 sample per sample, 2 means double speed, etc.
+             */
+            void play(const CircularBufferView& buffer, int relativePosition = 0, ControllerValue speed = 1.);
             
             /**
              * Stops playback
              */
             void stop();
             
+            /**
+             * Sets the quality of the resampling. Higher qualities start playing a few samples further behind the requested position.
+             * @param quality: the resampling quality
+             */
+            void setQuality(PolyphaseResampler::Quality quality);
+
+            /**
+             * @return: the resampling quality
+             */
+            PolyphaseResampler::Quality getQuality() const { return mQuality.load(); }
+
             /**
              * @return: the playback speed as a fraction of the original speed of the audio material in the buffer.
              */
@@ -64,9 +85,12 @@ namespace nap
   
             double mPosition = 0; // Current position of playback in samples within the source buffer.
             ControllerValue mSpeed = 1.f; // Playback speed as a fraction of the original speed.
-            CircularBufferNode* mBuffer = nullptr; // Pointer to the circular buffer that is used as source playback material.
+            const CircularBufferView* mBuffer = nullptr; // Pointer to the circular buffer that is used as source playback material.
+            PolyphaseResampler mResampler;
+            std::vector<float> mScratch;
+            std::atomic<PolyphaseResampler::Quality> mQuality = { PolyphaseResampler::Quality::Medium };
             
-            std::atomic<CircularBufferNode*> mNewBuffer = { nullptr };
+            std::atomic<const CircularBufferView*> mNewBuffer = { nullptr };
             std::atomic<int> mNewRelativePosition = { 0 };
             std::atomic<ControllerValue> mNewSpeed = { 1.f };
             DirtyFlag mIsDirty;
@@ -0,0 +1,116 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "compressedbufferplayernode.h"
+
+// Std includes
+#include <cstring>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::CompressedBufferPlayerNode)
+	RTTI_PROPERTY("audioOutput", &nap::audio::CompressedBufferPlayerNode::audioOutput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_FUNCTION("play", &nap::audio::CompressedBufferPlayerNode::play)
+	RTTI_FUNCTION("stop", &nap::audio::CompressedBufferPlayerNode::stop)
+	RTTI_FUNCTION("setChannel", &nap::audio::CompressedBufferPlayerNode::setChannel)
+	RTTI_FUNCTION("setPosition", &nap::audio::CompressedBufferPlayerNode::setPosition)
+	RTTI_FUNCTION("setSpeed", &nap::audio::CompressedBufferPlayerNode::setSpeed)
+	RTTI_FUNCTION("setQuality", &nap::audio::CompressedBufferPlayerNode::setQuality)
+	RTTI_FUNCTION("isPlaying", &nap::audio::CompressedBufferPlayerNode::isPlaying)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		void CompressedBufferPlayerNode::play(int channel, DiscreteTimeValue position, ControllerValue speed)
+		{
+			getNodeManager().enqueueTask([&, channel, position, speed](){
+				mChannel = channel;
+				mPosition = double(position);
+				mSpeed = speed;
+				mPlaying = true;
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::stop()
+		{
+			getNodeManager().enqueueTask([&](){
+				mPlaying = false;
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::setBuffer(SafePtr<CompressedSampleBuffer> buffer)
+		{
+			getNodeManager().enqueueTask([&, buffer](){
+				mBuffer = buffer;
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::setChannel(int channel)
+		{
+			getNodeManager().enqueueTask([&, channel](){
+				mChannel = channel;
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::setPosition(DiscreteTimeValue position)
+		{
+			getNodeManager().enqueueTask([&, position](){
+				mPosition = double(position);
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::setSpeed(ControllerValue speed)
+		{
+			getNodeManager().enqueueTask([&, speed](){
+				mSpeed = speed;
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::setQuality(PolyphaseResampler::Quality quality)
+		{
+			mQuality = quality;
+			PolyphaseResampler resampler(quality);
+			getNodeManager().enqueueTask([&, resampler](){
+				mResampler = resampler;
+			});
+		}
+
+
+		void CompressedBufferPlayerNode::process()
+		{
+			auto& outputBuffer = getOutputBuffer(audioOutput);
+			auto buffer = mBuffer.get();
+			if (!mPlaying.load() || buffer == nullptr || mChannel >= buffer->getChannelCount())
+			{
+				std::memset(outputBuffer.data(), 0, sizeof(SampleValue) * outputBuffer.size());
+				return;
+			}
+
+			// The samples are decoded straight into the scratch buffer of the resampler
+			auto channel = mChannel;
+			auto reader = [buffer, channel](float* destination, int64_t first, int count) { buffer->read(channel, first, count, destination); };
+			auto speed = double(mSpeed) * buffer->getSampleRate() / getNodeManager().getSampleRate();
+			mResampler.process(reader, mPosition, speed, outputBuffer.data(), outputBuffer.size(), mScratch.data());
+			mPosition += speed * outputBuffer.size();
+
+			// Stop once the resampler has read past either end of the buffer
+			auto padding = mResampler.getPadding(speed);
+			if (mPosition >= double(buffer->getSize()) + padding || mPosition < -padding - 1.)
+				mPlaying = false;
+		}
+
+	}
+
+}
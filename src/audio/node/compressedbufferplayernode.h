@@ -0,0 +1,107 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/compressedsamplebuffer.h>
+#include <audio/utility/polyphaseresampler.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Plays a channel of a @CompressedSampleBuffer, the counterpart of BufferPlayerNode for 16 and 24 bit samples.
+		 * The samples are decoded in blocks straight into the scratch buffer of a @PolyphaseResampler, which handles the speed and the sample rate of the buffer.
+		 * Playback stops at either end of the buffer.
+		 */
+		class NAPAPI CompressedBufferPlayerNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			CompressedBufferPlayerNode(NodeManager& nodeManager) : Node(nodeManager) { mScratch.resize(PolyphaseResampler::ScratchSize); }
+
+			/**
+			 * The output to connect to other nodes
+			 */
+			OutputPin audioOutput = { this };
+
+			/**
+			 * Starts playback
+			 * @param channel Channel of the buffer to play
+			 * @param position Frame of the buffer to start at
+			 * @param speed Playback speed, 1 plays the buffer at its own sample rate. Negative speeds play backwards.
+			 */
+			void play(int channel = 0, DiscreteTimeValue position = 0, ControllerValue speed = 1.f);
+
+			/**
+			 * Stops playback
+			 */
+			void stop();
+
+			/**
+			 * @param buffer The buffer to play from. Playback continues with the new buffer at the same position.
+			 */
+			void setBuffer(SafePtr<CompressedSampleBuffer> buffer);
+
+			/**
+			 * @param channel Channel of the buffer to play
+			 */
+			void setChannel(int channel);
+
+			/**
+			 * @param position Frame of the buffer to continue playback at
+			 */
+			void setPosition(DiscreteTimeValue position);
+
+			/**
+			 * @param speed Playback speed, 1 plays the buffer at its own sample rate.
+			 */
+			void setSpeed(ControllerValue speed);
+
+			/**
+			 * @param quality Quality of the resampling
+			 */
+			void setQuality(PolyphaseResampler::Quality quality);
+
+			/**
+			 * @return Quality of the resampling
+			 */
+			PolyphaseResampler::Quality getQuality() const { return mQuality.load(); }
+
+			/**
+			 * @return Whether the node is playing
+			 */
+			bool isPlaying() const { return mPlaying.load(); }
+
+		private:
+			// Inherited from Node
+			void process() override;
+
+			SafePtr<CompressedSampleBuffer> mBuffer = nullptr;
+
+			// Audio thread
+			int mChannel = 0;
+			double mPosition = 0.;          // Fractional frame position in the buffer
+			ControllerValue mSpeed = 1.f;
+			PolyphaseResampler mResampler;
+			std::vector<float> mScratch;
+
+			std::atomic<PolyphaseResampler::Quality> mQuality = { PolyphaseResampler::Quality::Medium };
+			std::atomic<bool> mPlaying = { false };
+		};
+
+	}
+
+}
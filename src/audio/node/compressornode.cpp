@@ -4,6 +4,10 @@
 
 #include "compressornode.h"
 
+// Audio includes
+#include <audio/utility/fastmath.h>
+
+#include <algorithm>
 #include <cmath>
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::CompressorNode)
@@ -37,14 +41,16 @@ namespace nap {
             float fSlow3 = expf((0.0f - (fConst2 / fSlow0)));
             float fSlow4 = expf((0.0f - (fConst2 / float(fVslider2))));
             float fSlow5 = float(fVslider3);
+            // log10f() and powf() are replaced by the polynomial approximations from fastmath.h:
+            // 20 * log10(x) = 20 * log10(2) * log2(x) and 10^(0.05 * x) = 2^(0.05 * log2(10) * x)
             for (int i = 0; (i < count); i = (i + 1)) {
                 float fTemp0 = float(input0[i]);
                 float fTemp1 = fabsf(fTemp0);
                 float fTemp2 = ((fRec1[1] > fTemp1)?fSlow4:fSlow3);
                 fRec2[0] = ((fRec2[1] * fTemp2) + ((1.0f - fTemp2) * fTemp1));
                 fRec1[0] = fRec2[0];
-                fRec0[0] = ((fSlow1 * fRec0[1]) + (fSlow2 * fmax(((20.0f * log10f(fRec1[0])) - fSlow5), 0.0f)));
-                output0[i] = float((powf(10.0f, (0.0500000007f * fRec0[0])) * fTemp0));
+                fRec0[0] = ((fSlow1 * fRec0[1]) + (fSlow2 * fmax(((6.02059991f * fastLog2(fRec1[0])) - fSlow5), 0.0f)));
+                output0[i] = float((fastExp2(0.166096404f * fRec0[0]) * fTemp0));
                 fRec2[1] = fRec2[0];
                 fRec1[1] = fRec1[0];
                 fRec0[1] = fRec0[0];
@@ -54,11 +60,17 @@ namespace nap {
 
         void CompressorNode::process()
         {
-            auto& inputBuffer = *audioInput.pull();
+            auto inputBuffer = audioInput.pull();
             auto& outputBuffer = getOutputBuffer(audioOutput);
 
+            if (inputBuffer == nullptr)
+            {
+                std::fill(outputBuffer.begin(), outputBuffer.end(), 0.f);
+                return;
+            }
+
             // Converts std::vector to float arrays
-            float* inputArray = &inputBuffer[0];
+            float* inputArray = inputBuffer->data();
             float* outputArray = &outputBuffer[0];
 
             faustCompressor.compute(getBufferSize(), inputArray, outputArray);
@@ -5,13 +5,17 @@
 #include "delaynode.h"
 
 #include <audio/utility/audiofunctions.h>
+#include <audio/utility/simddispatch.h>
 #include <audio/core/audionodemanager.h>
 #include <cmath>
+#include <cstring>
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::DelayNode)
     RTTI_PROPERTY("input", &nap::audio::DelayNode::input, nap::rtti::EPropertyMetaData::Embedded)
     RTTI_PROPERTY("output", &nap::audio::DelayNode::output, nap::rtti::EPropertyMetaData::Embedded)
     RTTI_FUNCTION("setTime", &nap::audio::DelayNode::setTime)
+    RTTI_FUNCTION("setMaxTime", &nap::audio::DelayNode::setMaxTime)
+    RTTI_FUNCTION("getMaxTime", &nap::audio::DelayNode::getMaxTime)
     RTTI_FUNCTION("setDryWet", &nap::audio::DelayNode::setDryWet)
     RTTI_FUNCTION("setFeedback", &nap::audio::DelayNode::setFeedback)
     RTTI_FUNCTION("getTime", &nap::audio::DelayNode::getTime)
@@ -25,15 +29,25 @@ namespace nap
     namespace audio
     {
         
-        DelayNode::DelayNode(NodeManager& manager, int delayLineSize) : Node(manager), mDelay(delayLineSize)
+        DelayNode::DelayNode(NodeManager& manager, TimeValue maxTime) : Node(manager), mDelayMemory(DelayMemory::get(manager))
         {
             mTime.setStepCount(manager.getSamplesPerMillisecond() * 10);
             mDryWet.setStepCount(manager.getSamplesPerMillisecond() * 10);
+            setMaxTime(maxTime);
+            bufferSizeChanged(getBufferSize());
+        }
+
+
+        void DelayNode::setMaxTime(TimeValue maxTime)
+        {
+            mMaxTime = std::max(maxTime, 0.f);
+            mDelay.allocate(*mDelayMemory, std::ceil(mMaxTime * getNodeManager().getSamplesPerMillisecond()));
         }
         
         
         void DelayNode::setTime(TimeValue value, TimeValue rampTime)
         {
+            value = std::min(value, mMaxTime);
             mTime.setStepCount(rampTime * getNodeManager().getSamplesPerMillisecond());
             mTime.setValue(value * getNodeManager().getSamplesPerMillisecond());
         }
@@ -52,13 +66,20 @@ namespace nap
             auto& outputBuffer = getOutputBuffer(output);
             auto feedback = mFeedback.load();
             SampleValue delayedSample = 0;
+
+            // A static delay of at least one buffer only reads samples that were written before this buffer
+            if (!mTime.isRamping() && mTime.getValue() + 1 >= outputBuffer.size())
+            {
+                processBlock(inputBuffer, outputBuffer, feedback);
+                return;
+            }
             
             if (inputBuffer)
             {
                 for (auto i = 0; i < outputBuffer.size(); ++i)
                 {
                     if (mTime.isRamping())
-                        delayedSample = mDelay.readInterpolating(mTime.getNextValue());
+                        delayedSample = mDelay.readLinear(mTime.getNextValue());
                     else
                         delayedSample = mDelay.read(mTime.getNextValue());
                     
@@ -71,7 +92,7 @@ namespace nap
                 for (auto i = 0; i < outputBuffer.size(); ++i)
                 {
                     if (mTime.isRamping())
-                        delayedSample = mDelay.readInterpolating(mTime.getNextValue());
+                        delayedSample = mDelay.readLinear(mTime.getNextValue());
                     else
                         delayedSample = mDelay.read(mTime.getNextValue());
                     
@@ -81,6 +102,48 @@ namespace nap
             }
         }
 
+
+        void DelayNode::processBlock(SampleBuffer* inputBuffer, SampleBuffer& outputBuffer, ControllerValue feedback)
+        {
+            auto& kernels = getSimdKernels();
+            const int count = outputBuffer.size();
+            mDelay.readBlock(mTime.getValue(), mDelayedBuffer.data(), count);
+
+            // Mix the feedback into the input and write it to the delay line
+            if (inputBuffer != nullptr)
+                std::memcpy(mWriteBuffer.data(), inputBuffer->data(), count * sizeof(SampleValue));
+            else
+                std::fill(mWriteBuffer.begin(), mWriteBuffer.end(), 0.f);
+            kernels.mix(mWriteBuffer.data(), mDelayedBuffer.data(), feedback, count);
+            mDelay.writeBlock(mWriteBuffer.data(), count);
+
+            if (mDryWet.isRamping())
+            {
+                for (auto i = 0; i < count; ++i)
+                    outputBuffer[i] = lerp(inputBuffer != nullptr ? (*inputBuffer)[i] : 0.f, mDelayedBuffer[i], mDryWet.getNextValue());
+            }
+            else {
+                auto dryWet = mDryWet.getValue();
+                std::fill(outputBuffer.begin(), outputBuffer.end(), 0.f);
+                if (inputBuffer != nullptr)
+                    kernels.mix(outputBuffer.data(), inputBuffer->data(), 1.f - dryWet, count);
+                kernels.mix(outputBuffer.data(), mDelayedBuffer.data(), dryWet, count);
+            }
+        }
+
+
+        void DelayNode::bufferSizeChanged(int size)
+        {
+            mDelayedBuffer.resize(size);
+            mWriteBuffer.resize(size);
+        }
+
+
+        void DelayNode::sampleRateChanged(float sampleRate)
+        {
+            setMaxTime(mMaxTime);
+        }
+
     }
     
 }
@@ -6,10 +6,11 @@
 
 // Std includes
 #include <atomic>
+#include <memory>
 
 // Audio includes
 #include <audio/core/audionode.h>
-#include <audio/utility/delay.h>
+#include <audio/utility/delayline.h>
 #include <audio/utility/linearsmoothedvalue.h>
 
 namespace nap
@@ -20,27 +21,45 @@ namespace nap
     
         /**
          * Delay line with feedback and dry/wet control.
+         * The delay line is sized for a maximum delay time and allocated from the @DelayMemory arena of the node manager.
          */
         class NAPAPI DelayNode : public Node
         {
         public:
+            /**
+             * Default maximum delay time in ms, about the 512k sample delay line that every DelayNode had before the maximum could be set.
+             */
+            static constexpr TimeValue DefaultMaxTime = 10000.f;
+
             /**
              * Constructor
              * @param manager NodeManager the node is processed on.
-             * @param delayLineSize The size in samples of the delay line. Has to be a power of 2.
+             * @param maxTime The maximum delay time in ms.
              */
-            DelayNode(NodeManager& manager, int delayLineSize = 65536 * 8);
+            DelayNode(NodeManager& manager, TimeValue maxTime = DefaultMaxTime);
             
             InputPin input = { this }; /**< The audio input receiving the signal to be delayed. */
             OutputPin output = { this }; /**< The audio output with the processed signal. */
             
             /**
              * Sets the delay time in milliseconds. Ramp time specifies the time it takes to reach the new value.
-             * @param value Delay time in ms
+             * @param value Delay time in ms, clamped to the maximum delay time.
              * @param rampTime Time taken in ms to interpolate to the new delay time.
              */
             void setTime(TimeValue value, TimeValue rampTime = 0);
             
+            /**
+             * Reallocates and flushes the delay line for a new maximum delay time.
+             * Should not be called while the node is being processed, for example from the initNode() of an object before it is connected.
+             * @param maxTime The maximum delay time in ms.
+             */
+            void setMaxTime(TimeValue maxTime);
+
+            /**
+             * @return The maximum delay time in ms.
+             */
+            TimeValue getMaxTime() const { return mMaxTime; }
+
             /**
              * Sets the dry wet value.
              * @param value The dry/wet ratio. 0 means fully dry, 1. means fully wet.
@@ -71,11 +90,20 @@ namespace nap
             
         private:
             void process() override;
-            
-            Delay mDelay;
+            void sampleRateChanged(float sampleRate) override;
+            void bufferSizeChanged(int size) override;
+
+            // Processes a buffer with a static delay time of at least the buffer size as whole spans
+            void processBlock(SampleBuffer* inputBuffer, SampleBuffer& outputBuffer, ControllerValue feedback);
+
+            std::shared_ptr<DelayMemory> mDelayMemory = nullptr;
+            TimeValue mMaxTime = 0.f;
+            DelayLine<SampleValue> mDelay;
             LinearSmoothedValue<float> mTime = { 0, 44 }; // in samples
             LinearSmoothedValue<ControllerValue> mDryWet = { 0.5f, 44 };
             std::atomic<ControllerValue> mFeedback = { 0.f };
+            SampleBuffer mDelayedBuffer; // Delayed samples of the current buffer in the block fast path
+            SampleBuffer mWriteBuffer; // Samples written to the delay line in the block fast path
         };
         
     }
@@ -4,8 +4,13 @@
 
 #include "envelopenode.h"
 
+// Std includes
+#include <algorithm>
+#include <cmath>
+
 // Audio includes
 #include <audio/core/audionodemanager.h>
+#include <audio/utility/vectorextension.h>
 
 // RTTI include
 #include <rtti/rtti.h>
@@ -34,39 +39,99 @@ namespace nap
     namespace audio
     {
 
-        EnvelopeNode::EnvelopeNode(NodeManager& manager, const Envelope& envelope, SafePtr<Translator<ControllerValue>> translator) : Node(manager), mEnvelope(envelope), mTranslator(translator)
+        static constexpr int FreshEnvelopeBit = 4; // Set in the middle index of the triple buffer when it holds unread data
+        static constexpr int EnvelopeIndexMask = 3;
+        static constexpr int ReservedSegmentCount = 16; // Minimum capacity of the envelope buffers
+        static constexpr ControllerValue SmallestExponentialValue = 0.0001f; // Replaces zero start and end points of exponential ramps
+
+
+        /**
+         * Writes start + increment * (first + k) for k in [0, count).
+         */
+        static void renderLinearRamp(SampleValue* output, int count, float start, float increment, int first)
+        {
+            const float8 lanes(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+            const float8 startVector(start);
+            const float8 incrementVector(increment);
+            auto i = 0;
+            for (; i + 8 <= count; i += 8)
+                (startVector + (lanes + float8(float(first + i))) * incrementVector).store(output + i);
+            for (; i < count; ++i)
+                output[i] = start + increment * (first + i);
+        }
+
+
+        /**
+         * Writes base * factor^k for k in [0, count).
+         */
+        static void renderExponentialRamp(SampleValue* output, int count, float base, float factor)
+        {
+            auto i = 0;
+            if (count >= 8)
+            {
+                float powers[8];
+                powers[0] = 1.f;
+                for (auto k = 1; k < 8; ++k)
+                    powers[k] = powers[k - 1] * factor;
+                const float8 stepVector(powers[7] * factor);
+                float8 values = float8(powers) * float8(base);
+                for (; i + 8 <= count; i += 8)
+                {
+                    values.store(output + i);
+                    values = values * stepVector;
+                }
+                base = output[i - 1] * factor;
+            }
+            for (; i < count; ++i)
+            {
+                output[i] = base;
+                base *= factor;
+            }
+        }
+
+
+        EnvelopeNode::EnvelopeNode(NodeManager& manager, const Envelope& envelope, SafePtr<Translator<ControllerValue>> translator) : Node(manager), mTranslator(translator)
         {
-            mValue.destinationReachedSignal.connect(rampFinishedSlot);
+            auto capacity = std::max<int>(envelope.size(), ReservedSegmentCount);
+            for (auto& buffer : mEnvelopes)
+            {
+                buffer.reserve(capacity);
+                buffer = envelope;
+            }
+            mControlEnvelope.reserve(capacity);
+            mControlEnvelope = envelope;
         }
 
 
         void EnvelopeNode::trigger(TimeValue totalDuration)
         {
-            trigger(0, mEnvelope.size() - 1, 0, totalDuration);
+            trigger(0, mControlEnvelope.size() - 1, 0, totalDuration);
         }
 
 
         void EnvelopeNode::trigger(int startSegment, int endSegment, ControllerValue startValue, TimeValue totalDuration)
         {
+            endSegment = std::min<int>(endSegment, mControlEnvelope.size() - 1);
+            if (startSegment < 0 || startSegment > endSegment)
+                return;
+
             auto absoluteDuration = 0.f;
             auto relativeDuration = 0.f;
             for (auto i = startSegment; i <= endSegment; ++i)
             {
-                auto& segment = mEnvelope[i];
+                auto& segment = mControlEnvelope[i];
                 if (!segment.mDurationRelative)
                     absoluteDuration += segment.mDuration;
                 else
                     relativeDuration += segment.mDuration;
             }
 
-            mTotalRelativeDuration = (totalDuration - absoluteDuration) / relativeDuration;
-            if (mTotalRelativeDuration < 0)
-                mTotalRelativeDuration = 0;
+            auto totalRelativeDuration = relativeDuration > 0.f ? (totalDuration - absoluteDuration) / relativeDuration : 0.f;
+            mTotalRelativeDuration.store(std::max(totalRelativeDuration, 0.f));
 
             mNewEndSegment.store(endSegment);
             mNewCurrentSegment.store(startSegment);
-
-			mValue.setValue(startValue);
+            mNewStartValue.store(startValue);
             mIsDirty.set();
         }
 
@@ -80,36 +145,104 @@ namespace nap
         }
 
 
+        void EnvelopeNode::setEnvelope(const Envelope& envelope)
+        {
+            mControlEnvelope = envelope;
+            publishEnvelope();
+        }
+
+
+        void EnvelopeNode::setSegment(int index, const Segment& segment)
+        {
+            if (index < 0 || index >= mControlEnvelope.size())
+                return;
+            mControlEnvelope[index] = segment;
+            publishEnvelope();
+        }
+
+
+        void EnvelopeNode::publishEnvelope()
+        {
+            // Copy assignment reuses the capacity of the back buffer
+            mEnvelopes[mBackIndex] = mControlEnvelope;
+            mBackIndex = mMiddleIndex.exchange(mBackIndex | FreshEnvelopeBit) & EnvelopeIndexMask;
+        }
+
+
+        void EnvelopeNode::startRamp(ControllerValue destination, int stepCount, RampMode mode)
+        {
+            mStart = mValue;
+            mDestination = destination;
+            mStepCount = std::max(stepCount, 0);
+            mStep = 0;
+            mMode = mode;
+            mRamping = true;
+            if (mStepCount == 0)
+                return;
+
+            if (mode == RampMode::Exponential)
+            {
+                auto start = mValue == 0.f ? std::copysign(SmallestExponentialValue, destination) : mValue;
+                auto end = destination == 0.f ? std::copysign(SmallestExponentialValue, start) : destination;
+                if ((start > 0.f) == (end > 0.f))
+                {
+                    mStart = start;
+                    mFactor = std::pow(end / start, 1.f / mStepCount);
+                    return;
+                }
+                // Exponential ramps can not cross zero
+                mMode = RampMode::Linear;
+            }
+            mIncrement = (destination - mStart) / mStepCount;
+        }
+
+
+        void EnvelopeNode::renderRamp(SampleValue* output, int count)
+        {
+            if (mMode == RampMode::Exponential)
+                renderExponentialRamp(output, count, mStart * std::pow(mFactor, float(mStep + 1)), mFactor);
+            else
+                renderLinearRamp(output, count, mStart, mIncrement, mStep + 1);
+            mStep += count;
+            mValue = output[count - 1];
+        }
+
+
         void EnvelopeNode::playSegment(int index)
         {
-            auto envelope = mEnvelope;
+            auto& envelope = mEnvelopes[mFrontIndex];
+            if (index >= envelope.size())
+                return;
 
-            assert(index < envelope.size());
             mCurrentSegment = index;
             auto& segment = envelope[index];
             mTranslate = segment.mTranslate;
 
-            if (segment.mDurationRelative)
-                mValue.ramp(segment.mDestination, segment.mDuration * mTotalRelativeDuration * getNodeManager().getSamplesPerMillisecond(), segment.mMode);
-            else
-                mValue.ramp(segment.mDestination, segment.mDuration * getNodeManager().getSamplesPerMillisecond(), segment.mMode);
+            auto duration = segment.mDurationRelative ? segment.mDuration * mTotalRelativeDuration.load() : segment.mDuration;
+            startRamp(segment.mDestination, duration * getNodeManager().getSamplesPerMillisecond(), segment.mMode);
         }
 
 
         void EnvelopeNode::updateEnvelope()
         {
+            // Pick up envelope data published by the control thread
+            if (mMiddleIndex.load() & FreshEnvelopeBit)
+                mFrontIndex = mMiddleIndex.exchange(mFrontIndex) & EnvelopeIndexMask;
+
             if (mIsDirty.check())
             {
                 mCurrentSegment = mNewCurrentSegment.load();
-                mEndSegment = mNewEndSegment.load();
+                mEndSegment = std::min<int>(mNewEndSegment.load(), mEnvelopes[mFrontIndex].size() - 1);
                 
                 auto fadeOutTime = mFadeOutTime.load();
                 if (fadeOutTime != 0.f)
                 {
                     mFadeOutTime.store(0.f);
-                    mValue.ramp(0.f, fadeOutTime * getNodeManager().getSamplesPerMillisecond(), RampMode::Linear);
+                    startRamp(0.f, fadeOutTime * getNodeManager().getSamplesPerMillisecond(), RampMode::Linear);
                 }
                 else {
+                    mValue = mNewStartValue.load();
+                    mRamping = false;
                     if (mCurrentSegment <= mEndSegment)
                         playSegment(mCurrentSegment);
                 }
@@ -121,31 +254,53 @@ namespace nap
         {
             updateEnvelope();
             auto& outputBuffer = getOutputBuffer(output);
+            auto data = outputBuffer.data();
+            int size = outputBuffer.size();
 
-            if (mTranslate && mTranslator != nullptr)
+            auto i = 0;
+            while (true)
             {
-                for (auto i = 0; i < outputBuffer.size(); ++i)
+                auto translate = mTranslate && mTranslator != nullptr;
+
+                if (mRamping && mStep >= mStepCount)
                 {
-                    outputBuffer[i] = mTranslator->translate(mValue.getNextValue());
+                    // Land exactly on the destination before moving on to the next segment
+                    mValue = mDestination;
+                    mRamping = false;
+                    if (mStepCount > 0 && i > 0)
+                        data[i - 1] = translate ? mTranslator->translate(mValue) : mValue;
+                    segmentFinished();
+                    continue;
                 }
-            }
-            else {
-                for (auto i = 0; i < outputBuffer.size(); ++i)
+
+                if (i >= size)
+                    break;
+
+                if (!mRamping)
                 {
-                    outputBuffer[i] = mValue.getNextValue();
+                    std::fill(data + i, data + size, translate ? mTranslator->translate(mValue) : mValue);
+                    break;
                 }
+
+                auto count = std::min(mStepCount - mStep, size - i);
+                renderRamp(data + i, count);
+                if (translate)
+                    for (auto j = i; j < i + count; ++j)
+                        data[j] = mTranslator->translate(data[j]);
+                i += count;
             }
+
             mCurrentValue.store(outputBuffer.back());
         }
 
 
-        void EnvelopeNode::rampFinished(ControllerValue value)
+        void EnvelopeNode::segmentFinished()
         {
             segmentFinishedSignal(*this);
             if (mCurrentSegment < mEndSegment)
                 playSegment(mCurrentSegment + 1);
             else {
-                if (value == 0.f)
+                if (mValue == 0.f)
                 {
                     mCurrentValue.store(0.f);
                     envelopeFinishedSignal(*this);
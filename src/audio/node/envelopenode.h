@@ -5,6 +5,7 @@
 #pragma once
 
 // Std includes
+#include <array>
 #include <atomic>
 
 // Audio includes
@@ -27,6 +28,8 @@ namespace nap
         /**
          * Envelope generator that can trigger envelopes to generate a control signal.
          * Envelopes are specified as an array of segments with a duration and a destination value.
+         * Segments are rendered in blocks, the signals are only emitted at segment boundaries.
+         * The envelope data is edited on a control thread copy and handed to the audio thread through a lock free triple buffer.
          */
         class NAPAPI EnvelopeNode : public Node
         {
@@ -101,11 +104,24 @@ namespace nap
             nap::Signal<EnvelopeNode&> segmentFinishedSignal;
             
             /**
-             * Use this to edit the envelope data. Handle with care and don't use this while the EnvelopeGenerator is playing!
-             * @return Reference to the envelope data being used by the node.
+             * Replaces the envelope data. Lock free, the new data is picked up by the audio thread at the start of the next buffer.
+             * Allocates only if the envelope is longer than any envelope assigned before.
+             * @param envelope The new envelope data
              */
-            Envelope& getEnvelope() { return mEnvelope; }
-            
+            void setEnvelope(const Envelope& envelope);
+
+            /**
+             * Replaces the data of one segment. Lock free, the new data is picked up by the audio thread at the start of the next buffer.
+             * @param index Index of the segment, if it is out of bounds no action will be taken.
+             * @param segment The new segment data
+             */
+            void setSegment(int index, const Segment& segment);
+
+            /**
+             * @return The control thread copy of the envelope data.
+             */
+            const Envelope& getEnvelope() const { return mControlEnvelope; }
+
             /**
              * @return The current the index of the segment that is currently playing in the envelope.
              */
@@ -116,25 +132,49 @@ namespace nap
 
             void playSegment(int index);
             void updateEnvelope();
+            void segmentFinished();
+
+            // Starts a ramp from the current value to destination in stepCount samples
+            void startRamp(ControllerValue destination, int stepCount, RampMode mode);
 
-            nap::Slot<ControllerValue> rampFinishedSlot = { this, &EnvelopeNode::rampFinished };
-            void rampFinished(ControllerValue);
+            // Renders count samples of the current ramp into output
+            void renderRamp(SampleValue* output, int count);
+
+            // Hands the control thread envelope to the audio thread
+            void publishEnvelope();
 
             int mCurrentSegment = { 0 };
             int mEndSegment = { 0 };
-            Envelope mEnvelope; // 1000ms attack and 1000ms decay
 
-            RampedValue<ControllerValue> mValue = { 0.f };
+            // Triple buffer of envelope data. Bit 2 of mMiddleIndex flags that it holds data the audio thread has not picked up yet.
+            std::array<Envelope, 3> mEnvelopes;
+            std::atomic<int> mMiddleIndex = { 1 };
+            int mBackIndex = 2; // Written by the control thread
+            int mFrontIndex = 0; // Read by the audio thread
+            Envelope mControlEnvelope; // Control thread copy of the envelope data
+
+            // Ramp state of the audio thread
+            ControllerValue mValue = 0.f;
+            ControllerValue mStart = 0.f;
+            ControllerValue mDestination = 0.f;
+            ControllerValue mIncrement = 0.f; // Step size of linear ramps
+            ControllerValue mFactor = 1.f; // Step multiplier of exponential ramps
+            RampMode mMode = RampMode::Linear;
+            int mStepCount = 0;
+            int mStep = 0;
+            bool mRamping = false;
+
             std::atomic<ControllerValue> mCurrentValue = { 0.f };
             bool mTranslate = false;
 
             std::atomic<int> mNewCurrentSegment = { 0 };
             std::atomic<int> mNewEndSegment = { 0 };
+            std::atomic<ControllerValue> mNewStartValue = { 0.f };
             std::atomic<TimeValue> mFadeOutTime = { 0.f };
             SafePtr<Translator<ControllerValue>> mTranslator = nullptr; // Helper object to apply a translation to the output value.
             DirtyFlag mIsDirty;
 
-            TimeValue mTotalRelativeDuration = 0;
+            std::atomic<TimeValue> mTotalRelativeDuration = { 0.f };
         };
 
     }
@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <audio/core/audionodemanager.h>
+#include <audio/utility/simddispatch.h>
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::FilterBankNode)
     RTTI_PROPERTY("input", &nap::audio::FilterBankNode::audioInput, nap::rtti::EPropertyMetaData::Embedded)
@@ -102,16 +103,19 @@ namespace nap
 				mDeletionQueue.enqueue(updateFunction);
 			}
 
-			for (auto i = 0; i < outputBuffer.size(); ++i)
-			{
-				const float8 inputValue(inputBuffer[i]);
-				const float8 outputValue = mFilter.process(inputValue);
-				float result = 0;
-				for (auto filterIndex = 0; filterIndex < filterCount; ++filterIndex)
-					result += outputValue[filterIndex];
-				result += mLowShelf.process(inputBuffer[i]) * mLowShelfGain;
-				outputBuffer[i] = result;
-			}
+			// The low shelf goes first, input and output can be the same buffer
+			auto size = outputBuffer.size();
+			if (mLowShelfBuffer.size() < size)
+				mLowShelfBuffer.resize(size);
+			for (auto i = 0; i < size; ++i)
+				mLowShelfBuffer[i] = mLowShelf.process(inputBuffer[i]);
+
+			float8 mix(0.f);
+			for (auto filterIndex = 0; filterIndex < filterCount; ++filterIndex)
+				mix[filterIndex] = 1.f;
+			mFilter.processSum(inputBuffer.data(), outputBuffer.data(), size, mix);
+
+			getSimdKernels().mix(outputBuffer.data(), mLowShelfBuffer.data(), mLowShelfGain.load(), size);
 		}
         
         
@@ -25,7 +25,7 @@ namespace nap
     {
 
 		/**
-		 * Processes a maximum of 8 parallel bandpass filters on the input signal using AVX2 optimization.
+		 * Processes a maximum of 8 parallel bandpass filters on the input signal using the SIMD kernels selected for the host CPU.
 		 */
 		class NAPAPI FilterBank
 		{
@@ -73,6 +73,7 @@ namespace nap
 			BiquadFilter<float8> mFilter;
             OnePoleLowPass<SampleValue> mLowShelf;
 			std::atomic<ControllerValue> mLowShelfGain = 0.f;
+			SampleBuffer mLowShelfBuffer;
 
 			using UpdateFunction = std::function<void()>;
 			std::atomic<UpdateFunction*> mUpdateFunction = { nullptr };
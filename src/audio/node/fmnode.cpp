@@ -0,0 +1,268 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "fmnode.h"
+
+// Std includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/audiofunctions.h>
+
+RTTI_BEGIN_STRUCT(nap::audio::FMOperator)
+	RTTI_PROPERTY("Ratio", &nap::audio::FMOperator::mRatio, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Detune", &nap::audio::FMOperator::mDetune, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Level", &nap::audio::FMOperator::mLevel, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Output", &nap::audio::FMOperator::mOutput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Feedback", &nap::audio::FMOperator::mFeedback, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Attack", &nap::audio::FMOperator::mAttack, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Decay", &nap::audio::FMOperator::mDecay, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Sustain", &nap::audio::FMOperator::mSustain, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Release", &nap::audio::FMOperator::mRelease, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_STRUCT
+
+RTTI_BEGIN_STRUCT(nap::audio::FMModulation)
+	RTTI_PROPERTY("Modulator", &nap::audio::FMModulation::mModulator, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("Target", &nap::audio::FMModulation::mTarget, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("Depth", &nap::audio::FMModulation::mDepth, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_STRUCT
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::FMNode)
+	RTTI_FUNCTION("setOperatorCount", &nap::audio::FMNode::setOperatorCount)
+	RTTI_FUNCTION("setOperator", &nap::audio::FMNode::setOperator)
+	RTTI_FUNCTION("setModulation", &nap::audio::FMNode::setModulation)
+	RTTI_FUNCTION("clearModulations", &nap::audio::FMNode::clearModulations)
+	RTTI_FUNCTION("setFrequency", &nap::audio::FMNode::setFrequency)
+	RTTI_FUNCTION("noteOn", &nap::audio::FMNode::noteOn)
+	RTTI_FUNCTION("noteOff", &nap::audio::FMNode::noteOff)
+	RTTI_FUNCTION("isActive", &nap::audio::FMNode::isActive)
+	RTTI_PROPERTY("output", &nap::audio::FMNode::output, nap::rtti::EPropertyMetaData::Embedded)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		FMNode::FMNode(NodeManager& manager) : Node(manager)
+		{
+			clearModulations();
+			sampleRateChanged(getNodeManager().getSampleRate());
+		}
+
+
+		void FMNode::setWave(SafePtr<WaveTable> wave)
+		{
+			mWave = wave;
+		}
+
+
+		void FMNode::setOperatorCount(int count)
+		{
+			mOperatorCount = std::min(std::max(count, 1), MaxOperatorCount);
+		}
+
+
+		void FMNode::setOperator(int index, const FMOperator& settings)
+		{
+			assert(index >= 0 && index < MaxOperatorCount);
+			auto& parameters = mParameters[index];
+			parameters.mRatio = settings.mRatio;
+			parameters.mDetune = settings.mDetune;
+			parameters.mLevel = settings.mLevel;
+			parameters.mOutput = settings.mOutput;
+			parameters.mFeedback = settings.mFeedback;
+			parameters.mAttack = settings.mAttack;
+			parameters.mDecay = settings.mDecay;
+			parameters.mSustain = settings.mSustain;
+			parameters.mRelease = settings.mRelease;
+		}
+
+
+		void FMNode::setModulation(int modulator, int target, ControllerValue depth)
+		{
+			assert(modulator >= 0 && modulator < MaxOperatorCount && target >= 0 && target < MaxOperatorCount);
+			assert(modulator != target);
+			mModulations[modulator * MaxOperatorCount + target] = depth;
+		}
+
+
+		void FMNode::clearModulations()
+		{
+			for (auto& modulation : mModulations)
+				modulation = 0.f;
+		}
+
+
+		void FMNode::noteOn(ControllerValue frequency, ControllerValue velocity)
+		{
+			mFrequency = frequency;
+			mVelocity = velocity;
+			mNoteOnCount++;
+		}
+
+
+		void FMNode::noteOff()
+		{
+			mNoteOffCount++;
+		}
+
+
+		void FMNode::process()
+		{
+			auto& outputBuffer = getOutputBuffer(output);
+			if (mWave == nullptr || !mWave->isPowerOfTwo())
+			{
+				std::fill(outputBuffer.begin(), outputBuffer.end(), 0.f);
+				return;
+			}
+
+			const auto operatorCount = mOperatorCount.load();
+			const auto frequency = mFrequency.load();
+			const auto waveSize = float(mWave->getSize());
+			const auto tableMask = int(mWave->getSize() - 1);
+
+			// Note events from the control thread
+			auto noteOnCount = mNoteOnCount.load();
+			if (noteOnCount != mHandledNoteOnCount.load())
+			{
+				mActive = true;
+				mHandledNoteOnCount = noteOnCount;
+				mHandledNoteOffCount = mNoteOffCount.load();
+				for (auto& state : mStates)
+					state = State();
+				for (auto op = 0; op < operatorCount; ++op)
+					mStates[op].mStage = Stage::Attack;
+			}
+			auto noteOffCount = mNoteOffCount.load();
+			if (noteOffCount != mHandledNoteOffCount)
+			{
+				mHandledNoteOffCount = noteOffCount;
+				for (auto& state : mStates)
+					if (state.mStage != Stage::Idle)
+						state.mStage = Stage::Release;
+			}
+
+			// Per block copies of the parameters. Depths are converted from radians to cycles.
+			const float* bands[MaxOperatorCount];
+			float increments[MaxOperatorCount];
+			float levels[MaxOperatorCount];
+			float outputs[MaxOperatorCount];
+			float feedbacks[MaxOperatorCount];
+			float attackSteps[MaxOperatorCount];
+			float decayCoefficients[MaxOperatorCount];
+			float sustains[MaxOperatorCount];
+			float releaseCoefficients[MaxOperatorCount];
+			float modulations[MaxOperatorCount][MaxOperatorCount];
+			const auto radiansToCycles = 1.f / math::PIX2;
+			const auto velocity = mVelocity.load();
+			for (auto op = 0; op < operatorCount; ++op)
+			{
+				auto& parameters = mParameters[op];
+				auto operatorFrequency = frequency * parameters.mRatio.load() + parameters.mDetune.load();
+				bands[op] = mWave->getBand(std::abs(operatorFrequency)).data();
+				increments[op] = operatorFrequency * mInverseSampleRate;
+				levels[op] = parameters.mLevel.load();
+				outputs[op] = parameters.mOutput.load() * velocity;
+				feedbacks[op] = parameters.mFeedback.load() * radiansToCycles * 0.5f;
+				attackSteps[op] = 1.f / std::max(parameters.mAttack.load() * mSamplesPerMillisecond, 1.f);
+				decayCoefficients[op] = getDecayCoefficient(parameters.mDecay.load());
+				sustains[op] = parameters.mSustain.load();
+				releaseCoefficients[op] = getDecayCoefficient(parameters.mRelease.load());
+				for (auto target = 0; target < operatorCount; ++target)
+					modulations[op][target] = target == op ? 0.f : mModulations[op * MaxOperatorCount + target].load() * radiansToCycles;
+			}
+
+			for (auto i = 0; i < outputBuffer.size(); ++i)
+			{
+				SampleValue sum = 0.f;
+				for (auto op = operatorCount - 1; op >= 0; --op)
+				{
+					auto& state = mStates[op];
+
+					switch (state.mStage)
+					{
+						case Stage::Idle:
+							state.mOutput = 0.f;
+							continue;
+						case Stage::Attack:
+							state.mEnvelope += attackSteps[op];
+							if (state.mEnvelope >= 1.f)
+							{
+								state.mEnvelope = 1.f;
+								state.mStage = Stage::Decay;
+							}
+							break;
+						case Stage::Decay:
+							state.mEnvelope = sustains[op] + (state.mEnvelope - sustains[op]) * decayCoefficients[op];
+							break;
+						case Stage::Release:
+							state.mEnvelope *= releaseCoefficients[op];
+							if (state.mEnvelope < 1e-5f)
+							{
+								state.mEnvelope = 0.f;
+								state.mStage = Stage::Idle;
+							}
+							break;
+					}
+
+					// Phase modulation in cycles. Outputs of lower operators still hold the previous sample.
+					auto modulation = feedbacks[op] * (state.mOutput + state.mPreviousOutput);
+					for (auto modulator = 0; modulator < operatorCount; ++modulator)
+						modulation += modulations[modulator][op] * mStates[modulator].mOutput;
+
+					auto position = (state.mPhase + modulation) * waveSize;
+					int index = int(position);
+					if (position < index)
+						index--;
+					auto fraction = position - index;
+					auto value1 = bands[op][index & tableMask];
+					auto value2 = bands[op][(index + 1) & tableMask];
+
+					state.mPreviousOutput = state.mOutput;
+					state.mOutput = (value1 + (value2 - value1) * fraction) * state.mEnvelope * levels[op];
+					sum += state.mOutput * outputs[op];
+
+					state.mPhase += increments[op];
+					state.mPhase -= std::floor(state.mPhase);
+				}
+				outputBuffer[i] = sum;
+			}
+
+			auto active = false;
+			for (auto op = 0; op < operatorCount; ++op)
+				if (mStates[op].mStage != Stage::Idle)
+					active = true;
+			mActive = active;
+		}
+
+
+		bool FMNode::isActive() const
+		{
+			// A note on that has not been handled by the audio thread yet counts as active
+			return mActive.load() || mNoteOnCount.load() != mHandledNoteOnCount.load();
+		}
+
+
+		float FMNode::getDecayCoefficient(TimeValue time) const
+		{
+			// ln(0.001) = -6.9, a decay of 60dB
+			auto samples = std::max(time * mSamplesPerMillisecond, 1.f);
+			return std::exp(-6.9077553f / samples);
+		}
+
+
+		void FMNode::sampleRateChanged(float sampleRate)
+		{
+			mInverseSampleRate = sampleRate > 0.f ? 1.f / sampleRate : 0.f;
+			mSamplesPerMillisecond = sampleRate / 1000.f;
+		}
+
+	}
+
+}
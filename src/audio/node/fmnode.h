@@ -0,0 +1,176 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <array>
+#include <atomic>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/node/oscillatornode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Settings of one operator of an @FMNode.
+		 */
+		struct NAPAPI FMOperator
+		{
+			ControllerValue mRatio = 1.f;       ///< Frequency relative to the note frequency
+			ControllerValue mDetune = 0.f;      ///< Frequency offset in Hz
+			ControllerValue mLevel = 1.f;       ///< Amplitude of the operator, scales both its modulation of other operators and its output
+			ControllerValue mOutput = 0.f;      ///< Level at which the operator is mixed into the output. Operators with output 0 are pure modulators.
+			ControllerValue mFeedback = 0.f;    ///< Self modulation depth in radians
+			TimeValue mAttack = 5.f;            ///< Linear attack time in ms
+			TimeValue mDecay = 500.f;           ///< Time in ms to decay 60dB towards the sustain level
+			ControllerValue mSustain = 0.5f;    ///< Sustain level between 0 and 1
+			TimeValue mRelease = 500.f;         ///< Time in ms to decay 60dB after the note off
+		};
+
+
+		/**
+		 * One entry of the algorithm matrix of an @FMNode: the output of the modulator modulates the phase of the target.
+		 */
+		struct NAPAPI FMModulation
+		{
+			int mModulator = 1;                 ///< Index of the modulating operator
+			int mTarget = 0;                    ///< Index of the modulated operator
+			ControllerValue mDepth = 1.f;       ///< Modulation depth in radians for a modulator at full level
+		};
+
+
+		/**
+		 * Phase modulation (DX style FM) synthesizer voice with up to 6 operators.
+		 * The operators are connected through an algorithm matrix and every operator has its own envelope and feedback.
+		 * All operators are rendered in a single per sample loop that reads from one shared @WaveTable, which has to have a power of two size.
+		 * Operators are evaluated from the highest to the lowest index: modulation from higher operators uses the current sample, from lower operators the previous sample.
+		 * All setters are lock free and can be called from the control thread.
+		 */
+		class NAPAPI FMNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			static constexpr int MaxOperatorCount = 6;
+
+		public:
+			FMNode(NodeManager& manager);
+
+			/**
+			 * Set the waveform of the operators, normally a sine. Has to be called before usage.
+			 * @param wave Safe pointer to WaveTable object.
+			 */
+			void setWave(SafePtr<WaveTable> wave);
+
+			/**
+			 * @param count Number of operators being rendered, between 1 and MaxOperatorCount.
+			 */
+			void setOperatorCount(int count);
+
+			/**
+			 * @param index Index of the operator
+			 * @param settings New settings of the operator
+			 */
+			void setOperator(int index, const FMOperator& settings);
+
+			/**
+			 * Sets an entry of the algorithm matrix.
+			 * @param modulator Index of the modulating operator
+			 * @param target Index of the modulated operator, has to differ from modulator. Use the operator's feedback for self modulation.
+			 * @param depth Modulation depth in radians for a modulator at full level, 0 disconnects the operators.
+			 */
+			void setModulation(int modulator, int target, ControllerValue depth);
+
+			/**
+			 * Clears the algorithm matrix.
+			 */
+			void clearModulations();
+
+			/**
+			 * Changes the note frequency without retriggering the envelopes.
+			 * @param frequency Frequency in Hz
+			 */
+			void setFrequency(ControllerValue frequency) { mFrequency = frequency; }
+
+			/**
+			 * Starts a note: resets the phases and triggers the envelopes of all operators.
+			 * @param frequency Frequency in Hz
+			 * @param velocity Output amplitude of the note
+			 */
+			void noteOn(ControllerValue frequency, ControllerValue velocity = 1.f);
+
+			/**
+			 * Releases the envelopes of all operators.
+			 */
+			void noteOff();
+
+			/**
+			 * @return True while any of the operator envelopes is playing.
+			 */
+			bool isActive() const;
+
+			OutputPin output = { this }; ///< Audio output pin.
+
+		private:
+			enum class Stage { Idle, Attack, Decay, Release };
+
+			// Control thread copy of the operator settings
+			struct Parameters
+			{
+				std::atomic<ControllerValue> mRatio = { 1.f };
+				std::atomic<ControllerValue> mDetune = { 0.f };
+				std::atomic<ControllerValue> mLevel = { 1.f };
+				std::atomic<ControllerValue> mOutput = { 0.f };
+				std::atomic<ControllerValue> mFeedback = { 0.f };
+				std::atomic<TimeValue> mAttack = { 5.f };
+				std::atomic<TimeValue> mDecay = { 500.f };
+				std::atomic<ControllerValue> mSustain = { 0.5f };
+				std::atomic<TimeValue> mRelease = { 500.f };
+			};
+
+			// Audio thread state of an operator
+			struct State
+			{
+				Stage mStage = Stage::Idle;
+				float mPhase = 0.f;
+				float mEnvelope = 0.f;
+				float mOutput = 0.f;
+				float mPreviousOutput = 0.f;
+			};
+
+			void process() override;
+			void sampleRateChanged(float sampleRate) override;
+
+			// Returns the per sample multiplier that decays 60dB in the given time
+			float getDecayCoefficient(TimeValue time) const;
+
+			SafePtr<WaveTable> mWave = nullptr;
+
+			std::atomic<int> mOperatorCount = { 4 };
+			std::array<Parameters, MaxOperatorCount> mParameters;
+			std::array<std::atomic<ControllerValue>, MaxOperatorCount * MaxOperatorCount> mModulations; // Depth in radians, indexed by modulator * MaxOperatorCount + target
+
+			std::atomic<ControllerValue> mFrequency = { 440.f };
+			std::atomic<ControllerValue> mVelocity = { 1.f };
+			std::atomic<int> mNoteOnCount = { 0 };
+			std::atomic<int> mNoteOffCount = { 0 };
+			std::atomic<bool> mActive = { false };
+
+			std::array<State, MaxOperatorCount> mStates;
+			std::atomic<int> mHandledNoteOnCount = { 0 };
+			int mHandledNoteOffCount = 0;
+			float mInverseSampleRate = 0.f;
+			float mSamplesPerMillisecond = 0.f;
+		};
+
+	}
+
+}
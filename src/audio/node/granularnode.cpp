@@ -0,0 +1,376 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "granularnode.h"
+
+// Std includes
+#include <cmath>
+
+// Nap includes
+#include <mathutils.h>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_ENUM(nap::audio::GranularNode::Window)
+	RTTI_ENUM_VALUE(nap::audio::GranularNode::Window::Hann, "Hann"),
+	RTTI_ENUM_VALUE(nap::audio::GranularNode::Window::Gaussian, "Gaussian"),
+	RTTI_ENUM_VALUE(nap::audio::GranularNode::Window::Tukey, "Tukey"),
+	RTTI_ENUM_VALUE(nap::audio::GranularNode::Window::Triangle, "Triangle")
+RTTI_END_ENUM
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::GranularNode)
+	RTTI_PROPERTY("leftOutput", &nap::audio::GranularNode::leftOutput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_PROPERTY("rightOutput", &nap::audio::GranularNode::rightOutput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_FUNCTION("setDensity", &nap::audio::GranularNode::setDensity)
+	RTTI_FUNCTION("setDuration", &nap::audio::GranularNode::setDuration)
+	RTTI_FUNCTION("setPosition", &nap::audio::GranularNode::setPosition)
+	RTTI_FUNCTION("setPositionJitter", &nap::audio::GranularNode::setPositionJitter)
+	RTTI_FUNCTION("setPitch", &nap::audio::GranularNode::setPitch)
+	RTTI_FUNCTION("setPitchJitter", &nap::audio::GranularNode::setPitchJitter)
+	RTTI_FUNCTION("setPan", &nap::audio::GranularNode::setPan)
+	RTTI_FUNCTION("setPanSpread", &nap::audio::GranularNode::setPanSpread)
+	RTTI_FUNCTION("setWindow", &nap::audio::GranularNode::setWindow)
+	RTTI_FUNCTION("setGain", &nap::audio::GranularNode::setGain)
+	RTTI_FUNCTION("getActiveGrainCount", &nap::audio::GranularNode::getActiveGrainCount)
+	RTTI_FUNCTION("getMaxGrainCount", &nap::audio::GranularNode::getMaxGrainCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		static constexpr int LaneCount = sizeof(float8) / sizeof(float);
+
+
+		static std::vector<float> createWindowTable(GranularNode::Window window)
+		{
+			const auto size = GranularNode::WindowTableSize;
+			std::vector<float> result(size + 2, 0.f);
+			for (auto i = 0; i < size; ++i)
+			{
+				float x = float(i) / size;
+				switch (window)
+				{
+					case GranularNode::Window::Hann:
+						result[i] = 0.5f - 0.5f * std::cos(math::PIX2 * x);
+						break;
+					case GranularNode::Window::Gaussian:
+					{
+						float deviation = (x - 0.5f) / 0.15f;
+						result[i] = std::exp(-0.5f * deviation * deviation);
+						break;
+					}
+					case GranularNode::Window::Tukey:
+					{
+						// Cosine tapers over the first and last quarter
+						float edge = std::min(x, 1.f - x);
+						result[i] = edge < 0.25f ? 0.5f - 0.5f * std::cos(math::PI * edge / 0.25f) : 1.f;
+						break;
+					}
+					case GranularNode::Window::Triangle:
+						result[i] = 1.f - std::abs(2.f * x - 1.f);
+						break;
+				}
+			}
+			return result;
+		}
+
+
+		const std::vector<float>& GranularNode::getWindowTable(Window window)
+		{
+			static const std::vector<float> tables[] = {
+				createWindowTable(Window::Hann),
+				createWindowTable(Window::Gaussian),
+				createWindowTable(Window::Tukey),
+				createWindowTable(Window::Triangle)
+			};
+			return tables[static_cast<int>(window)];
+		}
+
+
+		GranularNode::GranularNode(NodeManager& nodeManager, int maxGrains) : Node(nodeManager)
+		{
+			auto groupCount = std::max((maxGrains + LaneCount - 1) / LaneCount, 1);
+			mOffset.resize(groupCount, float8(0.f));
+			mSpeed.resize(groupCount, float8(0.f));
+			mWindowPhase.resize(groupCount, float8(1.f));
+			mWindowStep.resize(groupCount, float8(0.f));
+			mLeftGain.resize(groupCount, float8(0.f));
+			mRightGain.resize(groupCount, float8(0.f));
+			mStart.resize(groupCount * LaneCount, 0);
+			mWindowTable.resize(groupCount * LaneCount, getWindowTable(Window::Hann).data());
+		}
+
+
+		void GranularNode::setSource(CircularBufferNode* buffer)
+		{
+			setSource(buffer != nullptr ? &buffer->getView() : nullptr);
+		}
+
+
+		void GranularNode::setSource(const CircularBufferView* buffer)
+		{
+			getNodeManager().enqueueTask([&, buffer](){
+				mCircularBuffer = buffer;
+				mBuffer = nullptr;
+				mMappedBuffer = nullptr;
+				stopGrains();
+			});
+		}
+
+
+		void GranularNode::setSource(SafePtr<MultiSampleBuffer> buffer, int channel)
+		{
+			getNodeManager().enqueueTask([&, buffer, channel](){
+				mCircularBuffer = nullptr;
+				mBuffer = buffer;
+				mMappedBuffer = nullptr;
+				mChannel = channel;
+				stopGrains();
+			});
+		}
+
+
+		void GranularNode::setSource(SafePtr<MappedSampleBuffer> buffer, int channel)
+		{
+			getNodeManager().enqueueTask([&, buffer, channel](){
+				mCircularBuffer = nullptr;
+				mBuffer = nullptr;
+				mMappedBuffer = buffer;
+				mChannel = channel;
+				stopGrains();
+			});
+		}
+
+
+		void GranularNode::process()
+		{
+			auto& leftBuffer = getOutputBuffer(leftOutput);
+			auto& rightBuffer = getOutputBuffer(rightOutput);
+			std::fill(leftBuffer.begin(), leftBuffer.end(), 0.f);
+			std::fill(rightBuffer.begin(), rightBuffer.end(), 0.f);
+			const int count = leftBuffer.size();
+
+			if (mCircularBuffer == nullptr && (mBuffer == nullptr || mChannel >= mBuffer->getChannelCount()) && (mMappedBuffer == nullptr || mChannel >= mMappedBuffer->getChannelCount()))
+				return;
+
+			// Start grains at their exact sample and render the grains that play in between
+			auto renderSegment = [&](int begin, int end) {
+				if (mCircularBuffer != nullptr)
+				{
+					auto& buffer = *mCircularBuffer;
+					render([&buffer](DiscreteTimeValue position) { return buffer.getSample(position); }, begin, end);
+				}
+				else if (mMappedBuffer != nullptr)
+				{
+					auto& buffer = *mMappedBuffer;
+					const DiscreteTimeValue size = buffer.getSize();
+					const int channel = mChannel;
+					render([&buffer, size, channel](DiscreteTimeValue position) { return position < size ? buffer.getSample(channel, position) : 0.f; }, begin, end);
+				}
+				else {
+					auto& buffer = (*mBuffer)[mChannel];
+					const DiscreteTimeValue size = buffer.size();
+					render([&buffer, size](DiscreteTimeValue position) { return position < size ? buffer[position] : 0.f; }, begin, end);
+				}
+			};
+
+			if (mCircularBuffer != nullptr)
+				mWritePosition = mCircularBuffer->getWritePosition();
+
+			int begin = 0;
+			auto density = mDensity.load();
+			if (density > 0.f)
+			{
+				auto interval = std::max(getNodeManager().getSampleRate() / density, 1.f);
+				while (mNextGrain < count)
+				{
+					int index = mNextGrain;
+					renderSegment(begin, index);
+					startGrain(index);
+					begin = index;
+					mNextGrain += interval;
+				}
+				mNextGrain -= count;
+			}
+			else
+				mNextGrain = 0.;
+			renderSegment(begin, count);
+
+			compact();
+			mActiveGrainCount = mGrainCount;
+		}
+
+
+		template <typename Reader>
+		void GranularNode::render(const Reader& reader, int begin, int end)
+		{
+			if (begin >= end || mGrainCount == 0)
+				return;
+
+			auto left = getOutputBuffer(leftOutput).data();
+			auto right = getOutputBuffer(rightOutput).data();
+			const float8 one(1.f);
+			const float8 tableSize(static_cast<float>(WindowTableSize));
+			const int groupCount = (mGrainCount + LaneCount - 1) / LaneCount;
+
+			for (auto group = 0; group < groupCount; ++group)
+			{
+				float8 offset = mOffset[group];
+				float8 phase = mWindowPhase[group];
+				const float8 speed = mSpeed[group];
+				const float8 step = mWindowStep[group];
+				const float8 leftGain = mLeftGain[group];
+				const float8 rightGain = mRightGain[group];
+				auto start = &mStart[group * LaneCount];
+				auto table = &mWindowTable[group * LaneCount];
+
+				for (auto i = begin; i < end; ++i)
+				{
+					// Gather the source samples and the window values of all lanes
+					const float8 windowPosition = minVec(phase, one) * tableSize;
+					float8 current, next, frac, window, windowNext, windowFrac;
+					for (auto lane = 0; lane < LaneCount; ++lane)
+					{
+						auto position = (unsigned int) offset[lane];
+						frac[lane] = offset[lane] - position;
+						current[lane] = reader(start[lane] + position);
+						next[lane] = reader(start[lane] + position + 1);
+
+						auto windowIndex = (unsigned int) windowPosition[lane];
+						windowFrac[lane] = windowPosition[lane] - windowIndex;
+						window[lane] = table[lane][windowIndex];
+						windowNext[lane] = table[lane][windowIndex + 1];
+					}
+
+					window = window + (windowNext - window) * windowFrac;
+					const float8 value = (current + (next - current) * frac) * window;
+					left[i] += sumVec(value * leftGain);
+					right[i] += sumVec(value * rightGain);
+
+					offset = offset + speed;
+					phase = phase + step;
+				}
+
+				mOffset[group] = offset;
+				mWindowPhase[group] = phase;
+			}
+		}
+
+
+		void GranularNode::startGrain(int index)
+		{
+			if (mGrainCount == mStart.size())
+			{
+				compact();
+				if (mGrainCount == mStart.size())
+					return;
+			}
+
+			const auto samplesPerMillisecond = getNodeManager().getSamplesPerMillisecond();
+			const auto duration = mDuration.load() * samplesPerMillisecond;
+			const auto speed = mPitch.load() * std::pow(2.f, mPitchJitter.load() * random() / 12.f);
+			auto position = (mPosition.load() + mPositionJitter.load() * random()) * samplesPerMillisecond;
+
+			DiscreteTimeValue start;
+			float offset;
+			if (mCircularBuffer != nullptr)
+			{
+				// The position is a delay behind the write position.
+				// Keep the grain from overtaking the write position and from reading samples that are overwritten while it plays.
+				const float bufferSize = getBufferSize();
+				const float minDelay = bufferSize + 2.f + std::max(speed - 1.f, 0.f) * duration;
+				const float maxDelay = mCircularBuffer->getSize() - bufferSize - std::max(1.f - speed, 0.f) * duration;
+				position = std::max(std::min(position, maxDelay), minDelay);
+				auto delay = (DiscreteTimeValue) std::ceil(position);
+				start = mWritePosition + index - delay;
+				offset = delay - position;
+			}
+			else {
+				position = std::max(position, 0.f);
+				start = (DiscreteTimeValue) position;
+				offset = position - start;
+			}
+
+			// Equal power pan
+			auto pan = std::min(std::max(mPan.load() + mPanSpread.load() * random(), -1.f), 1.f);
+			auto angle = (pan + 1.f) * 0.25f * math::PI;
+			auto gain = mGain.load();
+
+			auto group = mGrainCount / LaneCount;
+			auto lane = mGrainCount % LaneCount;
+			mOffset[group][lane] = offset;
+			mSpeed[group][lane] = speed;
+			mWindowPhase[group][lane] = 0.f;
+			mWindowStep[group][lane] = 1.f / std::max(duration, 1.f);
+			mLeftGain[group][lane] = std::cos(angle) * gain;
+			mRightGain[group][lane] = std::sin(angle) * gain;
+			mStart[mGrainCount] = start;
+			mWindowTable[mGrainCount] = getWindowTable(mWindow.load()).data();
+			mGrainCount++;
+		}
+
+
+		void GranularNode::compact()
+		{
+			auto grain = 0;
+			while (grain < mGrainCount)
+			{
+				auto group = grain / LaneCount;
+				auto lane = grain % LaneCount;
+				if (mWindowPhase[group][lane] >= 1.f)
+				{
+					// Move the last grain into the slot and leave a finished grain behind
+					auto last = mGrainCount - 1;
+					auto lastGroup = last / LaneCount;
+					auto lastLane = last % LaneCount;
+					mOffset[group][lane] = mOffset[lastGroup][lastLane];
+					mSpeed[group][lane] = mSpeed[lastGroup][lastLane];
+					mWindowPhase[group][lane] = mWindowPhase[lastGroup][lastLane];
+					mWindowStep[group][lane] = mWindowStep[lastGroup][lastLane];
+					mLeftGain[group][lane] = mLeftGain[lastGroup][lastLane];
+					mRightGain[group][lane] = mRightGain[lastGroup][lastLane];
+					mStart[grain] = mStart[last];
+					mWindowTable[grain] = mWindowTable[last];
+
+					mWindowPhase[lastGroup][lastLane] = 1.f;
+					mLeftGain[lastGroup][lastLane] = 0.f;
+					mRightGain[lastGroup][lastLane] = 0.f;
+					mGrainCount--;
+				}
+				else {
+					// Keep the offset small, so its precision does not degrade
+					auto whole = (DiscreteTimeValue) mOffset[group][lane];
+					mStart[grain] += whole;
+					mOffset[group][lane] -= whole;
+					grain++;
+				}
+			}
+		}
+
+
+		void GranularNode::stopGrains()
+		{
+			for (auto group = 0; group < mWindowPhase.size(); ++group)
+			{
+				mWindowPhase[group] = float8(1.f);
+				mLeftGain[group] = float8(0.f);
+				mRightGain[group] = float8(0.f);
+			}
+			mGrainCount = 0;
+		}
+
+
+		float GranularNode::random()
+		{
+			mSeed = mSeed * 1664525u + 1013904223u;
+			return int32_t(mSeed) * (1.f / 2147483648.f);
+		}
+
+	}
+
+}
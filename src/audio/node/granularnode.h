@@ -0,0 +1,205 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/node/circularbuffernode.h>
+#include <audio/utility/mappedsamplebuffer.h>
+#include <audio/utility/safeptr.h>
+#include <audio/utility/vectorextension.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Granular synthesis engine that plays a pool of grains from a live circular buffer, a @MultiSampleBuffer or a @MappedSampleBuffer.
+		 * Grains are scheduled on the audio thread with sample accuracy at a given density.
+		 * Every grain has its own start position, pitch, window and pan, randomized within the jitter and spread ranges when it starts.
+		 * The active grains are stored as a structure of arrays and processed 8 at a time in the lanes of a float8.
+		 * Setters can be called from any thread and apply to grains that start afterwards.
+		 */
+		class NAPAPI GranularNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * Shape of the amplitude envelope of a grain.
+			 */
+			enum class Window { Hann, Gaussian, Tukey, Triangle };
+
+			static constexpr int WindowTableSize = 1024; ///< Number of points in the window tables
+
+			/**
+			 * Constructor
+			 * @param nodeManager The node manager this node is processed on.
+			 * @param maxGrains Maximum number of grains that can play at the same time, rounded up to a multiple of 8.
+			 */
+			GranularNode(NodeManager& nodeManager, int maxGrains = 256);
+
+			OutputPin leftOutput = { this };      ///< The grains panned to the left.
+			OutputPin rightOutput = { this };     ///< The grains panned to the right.
+
+			/**
+			 * Plays grains from a live circular buffer. The position is the time behind the write position of the buffer.
+			 * Stops all grains that are playing.
+			 * @param buffer The circular buffer, or nullptr to stop playing.
+			 */
+			void setSource(CircularBufferNode* buffer);
+
+			/**
+			 * Plays grains from a view on a live circular buffer, for example a channel of a @MultichannelCircularBufferNode.
+			 * The position is the time behind the write position of the buffer. Stops all grains that are playing.
+			 * @param buffer The view, or nullptr to stop playing. Has to stay alive while playing.
+			 */
+			void setSource(const CircularBufferView* buffer);
+
+			/**
+			 * Plays grains from a channel of a buffer. The position is the time from the start of the buffer.
+			 * Stops all grains that are playing.
+			 * @param buffer The buffer, for example from an @AudioBufferResource.
+			 * @param channel The channel of the buffer to play.
+			 */
+			void setSource(SafePtr<MultiSampleBuffer> buffer, int channel);
+
+			/**
+			 * Plays grains from a channel of a memory mapped buffer. The position is the time from the start of the buffer.
+			 * Stops all grains that are playing.
+			 * @param buffer The buffer, for example from a @MappedAudioFile.
+			 * @param channel The channel of the buffer to play.
+			 */
+			void setSource(SafePtr<MappedSampleBuffer> buffer, int channel);
+
+			/**
+			 * @param density Number of grains started per second, 0 stops starting grains.
+			 */
+			void setDensity(ControllerValue density) { mDensity = std::max(density, 0.f); }
+
+			/**
+			 * @param duration Duration of the grains in ms.
+			 */
+			void setDuration(TimeValue duration) { mDuration = std::max(duration, 1.f); }
+
+			/**
+			 * @param position Position in ms grains start reading from. See setSource() for what it is relative to.
+			 */
+			void setPosition(TimeValue position) { mPosition = std::max(position, 0.f); }
+
+			/**
+			 * @param jitter Maximum random deviation of the start position in ms.
+			 */
+			void setPositionJitter(TimeValue jitter) { mPositionJitter = std::max(jitter, 0.f); }
+
+			/**
+			 * @param pitch Playback speed of the grains, 1 is the original pitch.
+			 */
+			void setPitch(ControllerValue pitch) { mPitch = std::max(pitch, 0.01f); }
+
+			/**
+			 * @param jitter Maximum random deviation of the pitch in semitones.
+			 */
+			void setPitchJitter(ControllerValue jitter) { mPitchJitter = std::max(jitter, 0.f); }
+
+			/**
+			 * @param pan Pan position between -1 (left) and 1 (right).
+			 */
+			void setPan(ControllerValue pan) { mPan = pan; }
+
+			/**
+			 * @param spread Maximum random deviation of the pan position.
+			 */
+			void setPanSpread(ControllerValue spread) { mPanSpread = std::max(spread, 0.f); }
+
+			/**
+			 * @param window Window of the grains.
+			 */
+			void setWindow(Window window) { mWindow = window; }
+
+			/**
+			 * @param gain Gain of every grain.
+			 */
+			void setGain(ControllerValue gain) { mGain = gain; }
+
+			/**
+			 * @return The number of grains that were playing at the end of the last processed buffer.
+			 */
+			int getActiveGrainCount() const { return mActiveGrainCount.load(); }
+
+			/**
+			 * @return The maximum number of grains that can play at the same time.
+			 */
+			int getMaxGrainCount() const { return mStart.size(); }
+
+			/**
+			 * @param window The window
+			 * @return Lookup table of the window with WindowTableSize + 2 points, the last two points are 0.
+			 */
+			static const std::vector<float>& getWindowTable(Window window);
+
+		private:
+			void process() override;
+
+			// Renders all grains into the output buffers from sample begin up to end
+			template <typename Reader>
+			void render(const Reader& reader, int begin, int end);
+
+			// Starts a grain at sample index within the current buffer
+			void startGrain(int index);
+
+			// Removes the grains that have finished and moves the grain positions into their start positions
+			void compact();
+
+			// Silences all grains
+			void stopGrains();
+
+			// Random value between -1 and 1
+			float random();
+
+			// Source, only accessed on the audio thread
+			const CircularBufferView* mCircularBuffer = nullptr;
+			SafePtr<MultiSampleBuffer> mBuffer = nullptr;
+			SafePtr<MappedSampleBuffer> mMappedBuffer = nullptr;
+			int mChannel = 0;
+			DiscreteTimeValue mWritePosition = 0; // Write position of the circular buffer at the start of the current buffer
+
+			// Parameters
+			std::atomic<ControllerValue> mDensity = { 20.f };
+			std::atomic<TimeValue> mDuration = { 100.f };
+			std::atomic<TimeValue> mPosition = { 100.f };
+			std::atomic<TimeValue> mPositionJitter = { 0.f };
+			std::atomic<ControllerValue> mPitch = { 1.f };
+			std::atomic<ControllerValue> mPitchJitter = { 0.f };
+			std::atomic<ControllerValue> mPan = { 0.f };
+			std::atomic<ControllerValue> mPanSpread = { 0.f };
+			std::atomic<Window> mWindow = { Window::Hann };
+			std::atomic<ControllerValue> mGain = { 1.f };
+
+			// Grain pool as a structure of arrays, the grains in use are at the front
+			std::vector<float8> mOffset;        // Read position relative to the start position
+			std::vector<float8> mSpeed;         // Read position increment per sample
+			std::vector<float8> mWindowPhase;   // Position in the window between 0 and 1, 1 when the grain has finished
+			std::vector<float8> mWindowStep;    // Window phase increment per sample
+			std::vector<float8> mLeftGain;
+			std::vector<float8> mRightGain;
+			std::vector<DiscreteTimeValue> mStart;      // Start position in the source per grain
+			std::vector<const float*> mWindowTable;     // Window table per grain
+			int mGrainCount = 0;
+			std::atomic<int> mActiveGrainCount = { 0 };
+
+			double mNextGrain = 0.; // Sample index within the current buffer at which the next grain starts
+			uint32_t mSeed = 12345;
+		};
+
+	}
+
+}
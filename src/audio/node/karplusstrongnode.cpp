@@ -35,6 +35,7 @@ namespace nap
         void KarplusStrongNode::sampleRateChanged(float sampleRate)
         {
             mLowCut.setCutoffFrequency(20.f, sampleRate);
+            reset(mMaxDelayTime);
         }
 
     }
@@ -22,23 +22,32 @@ namespace nap
 		class KarplusStrongNode : public Node
 		{
 		public:
-			KarplusStrongNode(NodeManager& nodeManager) : Node(nodeManager)
+			/**
+			 * Constructor
+			 * @param nodeManager The node manager this node is processed on.
+			 * @param maxDelayTime Maximum supported delay time in ms, the default supports pitches down to 1Hz.
+			 */
+			KarplusStrongNode(NodeManager& nodeManager, TimeValue maxDelayTime = 1000.f) : Node(nodeManager), mDelayMemory(DelayMemory::get(nodeManager))
 			{
-				reset(1000.f);
+				reset(maxDelayTime);
                 mLowCut.setCutoffFrequency(20.f, nodeManager.getSampleRate());
 			}
 
 			/**
 			 * Reset the filter and zeros the buffers.
-			 * @param maxDelayTime Maximum supported delay tme in ms. This will be converted to a power of 2 in samples.
+			 * @param maxDelayTime Maximum supported delay time in ms.
 			 */
-			void reset(TimeValue maxDelayTime) { mKarplusStrong.reset(maxDelayTime * getNodeManager().getSamplesPerMillisecond()); }
+			void reset(TimeValue maxDelayTime)
+			{
+				mMaxDelayTime = maxDelayTime;
+				mKarplusStrong.reset(*mDelayMemory, maxDelayTime * getNodeManager().getSamplesPerMillisecond());
+			}
 
 			/**
 			 * Set the delay time in ms.
-			 * @param time Delay time in ms.
+			 * @param time Delay time in ms, clamped to the maximum delay time.
 			 */
-			void setDelayTime(TimeValue time) { mKarplusStrong.setDelayTime(time * getNodeManager().getSamplesPerMillisecond(), getNodeManager().getSamplesPerMillisecond() * 5.f); }
+			void setDelayTime(TimeValue time) { mKarplusStrong.setDelayTime(std::min(time, mMaxDelayTime) * getNodeManager().getSamplesPerMillisecond(), getNodeManager().getSamplesPerMillisecond() * 5.f); }
 
 			/**
 			 * Sets the feedback amount.
@@ -66,6 +75,8 @@ namespace nap
             void sampleRateChanged(float sampleRate) override;
 
 			bool mNegativePolarity = false;
+			std::shared_ptr<DelayMemory> mDelayMemory = nullptr;
+			TimeValue mMaxDelayTime = 0.f;
 			KarplusStrong<SampleValue> mKarplusStrong;
             OnePoleHighPass<SampleValue> mLowCut;
 		};
@@ -0,0 +1,159 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "limiternode.h"
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/audiofunctions.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::LimiterNode)
+	RTTI_FUNCTION("setCeiling", &nap::audio::LimiterNode::setCeiling)
+	RTTI_FUNCTION("setRelease", &nap::audio::LimiterNode::setRelease)
+	RTTI_FUNCTION("setLinked", &nap::audio::LimiterNode::setLinked)
+	RTTI_FUNCTION("getLatency", &nap::audio::LimiterNode::getLatency)
+	RTTI_FUNCTION("getLatencyTime", &nap::audio::LimiterNode::getLatencyTime)
+	RTTI_FUNCTION("getGainReduction", &nap::audio::LimiterNode::getGainReduction)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Peaks below this level never need limiting, it keeps the division by the peak finite
+		static constexpr SampleValue MinimumPeak = 1e-10f;
+
+
+		LimiterNode::LimiterNode(NodeManager& manager, int channelCount, TimeValue lookahead) : Node(manager), mLookahead(std::max(lookahead, 0.f)), mGainReduction(std::max(channelCount, 1))
+		{
+			channelCount = std::max(channelCount, 1);
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				mInputs.emplace_back(std::make_unique<InputPin>(this));
+				mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+				mGainReduction[channel] = 0.f;
+			}
+			mInputBuffers.resize(channelCount, nullptr);
+			mOutputBuffers.resize(channelCount, nullptr);
+			mDelayLines.resize(channelCount);
+			mDetectors.resize(channelCount);
+			allocate();
+		}
+
+
+		void LimiterNode::allocate()
+		{
+			int latency = std::round(mLookahead * getNodeManager().getSamplesPerMillisecond());
+			mLatency = latency;
+
+			// The signal is delayed by latency samples, so a peak entering the delay line stays within the window of latency + 1 samples
+			// of the sliding maximum until it leaves the delay line. The moving average over the same window then only sees gains that are low enough for that peak.
+			auto windowSize = latency + 1;
+			for (auto& delayLine : mDelayLines)
+				delayLine.assign(windowSize, 0.f);
+			mDelayPosition = 0;
+
+			for (auto& detector : mDetectors)
+			{
+				detector.mPeak.reset(windowSize);
+				detector.mAverageWindow.assign(windowSize, 1.f);
+				detector.mAverageSum = windowSize;
+				detector.mAveragePosition = 0;
+				detector.mHeldGain = 1.f;
+				detector.mGain = 1.f;
+			}
+		}
+
+
+		ControllerValue LimiterNode::computeGain(Detector& detector, SampleValue peak, ControllerValue ceiling, ControllerValue releaseCoefficient)
+		{
+			auto windowPeak = detector.mPeak.process(peak);
+			auto target = std::min(ceiling / std::max(windowPeak, MinimumPeak), 1.f);
+
+			// Attack immediately, recover exponentially
+			detector.mHeldGain = std::min(target, 1.f - (1.f - detector.mHeldGain) * releaseCoefficient);
+
+			auto& window = detector.mAverageWindow;
+			detector.mAverageSum += detector.mHeldGain - window[detector.mAveragePosition];
+			window[detector.mAveragePosition] = detector.mHeldGain;
+			if (++detector.mAveragePosition == window.size())
+				detector.mAveragePosition = 0;
+
+			detector.mGain = std::min(ControllerValue(detector.mAverageSum / window.size()), 1.f);
+			detector.mMinimumGain = std::min(detector.mMinimumGain, detector.mGain);
+			return detector.mGain;
+		}
+
+
+		void LimiterNode::process()
+		{
+			const int channelCount = mInputs.size();
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				mInputBuffers[channel] = mInputs[channel]->pull();
+				mOutputBuffers[channel] = &getOutputBuffer(*mOutputs[channel]);
+			}
+
+			const auto ceiling = dbToA(mCeiling.load());
+			const auto linked = mLinked.load();
+			// -6.9 is ln(0.001), a recovery of 60dB
+			const auto releaseSamples = std::max(mRelease.load() * getNodeManager().getSamplesPerMillisecond(), 1.f);
+			const auto releaseCoefficient = std::exp(-6.9077553f / releaseSamples);
+			const int delaySize = mDelayLines[0].size();
+
+			for (auto& detector : mDetectors)
+				detector.mMinimumGain = 1.f;
+
+			for (auto i = 0; i < getBufferSize(); ++i)
+			{
+				ControllerValue linkedGain = 1.f;
+				if (linked)
+				{
+					SampleValue peak = 0.f;
+					for (auto channel = 0; channel < channelCount; ++channel)
+						if (mInputBuffers[channel] != nullptr)
+							peak = std::max(peak, std::fabs((*mInputBuffers[channel])[i]));
+					linkedGain = computeGain(mDetectors[0], peak, ceiling, releaseCoefficient);
+				}
+
+				for (auto channel = 0; channel < channelCount; ++channel)
+				{
+					auto input = mInputBuffers[channel] != nullptr ? (*mInputBuffers[channel])[i] : 0.f;
+					auto gain = linked ? linkedGain : computeGain(mDetectors[channel], std::fabs(input), ceiling, releaseCoefficient);
+
+					// The delay line holds the input and the latency samples before it, the oldest leaves the limiter
+					auto& delayLine = mDelayLines[channel];
+					delayLine[mDelayPosition] = input;
+					auto delayed = delayLine[mDelayPosition + 1 == delaySize ? 0 : mDelayPosition + 1];
+
+					// The clamp only catches rounding errors of the moving average
+					(*mOutputBuffers[channel])[i] = std::min(std::max(delayed * gain, -ceiling), ceiling);
+				}
+
+				if (++mDelayPosition == delaySize)
+					mDelayPosition = 0;
+			}
+
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				auto minimumGain = mDetectors[linked ? 0 : channel].mMinimumGain;
+				mGainReduction[channel].store(20.f * std::log10(std::max(minimumGain, MinimumPeak)));
+			}
+		}
+
+
+		void LimiterNode::sampleRateChanged(float sampleRate)
+		{
+			allocate();
+		}
+
+	}
+
+}
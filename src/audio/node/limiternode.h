@@ -0,0 +1,132 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/slidingmaximum.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Lookahead brickwall limiter.
+		 * The input is delayed by the lookahead time. The peak level over the lookahead window is tracked with a @SlidingMaximum,
+		 * the resulting gain is held for the window, released exponentially and smoothed with a moving average over the window.
+		 * This way the gain has fully dropped before a peak leaves the delay line, and the output never exceeds the ceiling.
+		 * When the channels are linked all channels get the same gain, driven by the loudest channel.
+		 * The gain reduction can be read lock free from any thread for metering.
+		 */
+		class NAPAPI LimiterNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * Constructor
+			 * @param manager The node manager this node is processed on.
+			 * @param channelCount Number of input and output channels.
+			 * @param lookahead Lookahead time in ms, which is also the latency of the limiter.
+			 */
+			LimiterNode(NodeManager& manager, int channelCount = 2, TimeValue lookahead = 5.f);
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The input pin of the channel
+			 */
+			InputPin& getInput(int channel) { return *mInputs[channel]; }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The output pin of the channel
+			 */
+			OutputPin& getOutput(int channel) { return *mOutputs[channel]; }
+
+			/**
+			 * @return Number of channels
+			 */
+			int getChannelCount() const { return mInputs.size(); }
+
+			/**
+			 * @param ceiling The maximum output level in dB.
+			 */
+			void setCeiling(ControllerValue ceiling) { mCeiling = ceiling; }
+
+			/**
+			 * @param release Time in ms for the gain to recover 60dB after the peak has passed.
+			 */
+			void setRelease(TimeValue release) { mRelease = release; }
+
+			/**
+			 * @param linked True to apply the same gain to all channels.
+			 */
+			void setLinked(bool linked) { mLinked = linked; }
+
+			/**
+			 * @return The latency of the limiter in samples.
+			 */
+			int getLatency() const { return mLatency.load(); }
+
+			/**
+			 * @return The latency of the limiter in ms.
+			 */
+			TimeValue getLatencyTime() const { return mLookahead; }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The largest gain reduction of the channel during the last processed buffer, in dB. 0 or negative.
+			 */
+			ControllerValue getGainReduction(int channel) const { return mGainReduction[channel].load(); }
+
+		private:
+			// Gain computer of one channel, or of all channels when linked
+			struct Detector
+			{
+				SlidingMaximum mPeak;
+				std::vector<ControllerValue> mAverageWindow;
+				double mAverageSum = 0.0;
+				int mAveragePosition = 0;
+				ControllerValue mHeldGain = 1.f;
+				ControllerValue mGain = 1.f;
+				ControllerValue mMinimumGain = 1.f; // Lowest gain during the current buffer
+			};
+
+			void process() override;
+			void sampleRateChanged(float sampleRate) override;
+
+			// Allocates the delay lines and detectors for the lookahead time at the current sample rate
+			void allocate();
+
+			// Feeds a peak level to a detector and returns the gain for the sample leaving the delay line
+			ControllerValue computeGain(Detector& detector, SampleValue peak, ControllerValue ceiling, ControllerValue releaseCoefficient);
+
+			std::vector<std::unique_ptr<InputPin>> mInputs;
+			std::vector<std::unique_ptr<OutputPin>> mOutputs;
+			std::vector<SampleBuffer*> mInputBuffers;
+			std::vector<SampleBuffer*> mOutputBuffers;
+
+			TimeValue mLookahead = 5.f;
+			std::atomic<int> mLatency = { 0 };
+			std::atomic<ControllerValue> mCeiling = { -0.3f };
+			std::atomic<TimeValue> mRelease = { 100.f };
+			std::atomic<bool> mLinked = { true };
+			std::vector<std::atomic<ControllerValue>> mGainReduction;
+
+			std::vector<std::vector<SampleValue>> mDelayLines;
+			int mDelayPosition = 0;
+			std::vector<Detector> mDetectors; // One per channel, only the first one is used when linked
+		};
+
+	}
+
+}
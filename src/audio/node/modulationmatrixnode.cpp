@@ -0,0 +1,156 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "modulationmatrixnode.h"
+
+// Std includes
+#include <algorithm>
+#include <cassert>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/simddispatch.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::ModulationMatrixNode)
+	RTTI_FUNCTION("setBase", &nap::audio::ModulationMatrixNode::setBase)
+	RTTI_FUNCTION("setDepth", &nap::audio::ModulationMatrixNode::setDepth)
+	RTTI_FUNCTION("setVelocity", &nap::audio::ModulationMatrixNode::setVelocity)
+	RTTI_FUNCTION("getValue", &nap::audio::ModulationMatrixNode::getValue)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		ModulationMatrixNode::ModulationMatrixNode(NodeManager& manager, int sourceCount, const std::vector<Target>& targets, const std::vector<Route>& routes) :
+			Node(manager), mTargets(targets), mRoutes(routes), mBases(targets.size()), mDepths(routes.size()), mValues(targets.size())
+		{
+			for (auto i = 0; i < sourceCount; ++i)
+				mSources.emplace_back(std::make_unique<InputPin>(this));
+			for (auto i = 0; i < mTargets.size(); ++i)
+			{
+				mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+				mBases[i] = mTargets[i].mBase;
+				mValues[i] = std::min(std::max(mTargets[i].mBase, mTargets[i].mMinimum), mTargets[i].mMaximum);
+			}
+
+			mTargetRoutes.resize(mTargets.size());
+			for (auto i = 0; i < mRoutes.size(); ++i)
+			{
+				auto& route = mRoutes[i];
+				assert(route.mSource == VelocitySource || (route.mSource >= 0 && route.mSource < sourceCount));
+				assert(route.mTarget >= 0 && route.mTarget < mTargets.size());
+				mDepths[i] = route.mDepth;
+				mTargetRoutes[route.mTarget].emplace_back(i);
+			}
+
+			mSourceBuffers.resize(sourceCount, nullptr);
+			mSourceValues.resize(sourceCount, 0.f);
+
+			getNodeManager().registerRootProcess(*this);
+		}
+
+
+		ModulationMatrixNode::~ModulationMatrixNode()
+		{
+			getNodeManager().unregisterRootProcess(*this);
+		}
+
+
+		void ModulationMatrixNode::setBase(int target, ControllerValue value)
+		{
+			assert(target >= 0 && target < mBases.size());
+			mBases[target] = value;
+		}
+
+
+		void ModulationMatrixNode::setDepth(int route, ControllerValue depth)
+		{
+			assert(route >= 0 && route < mDepths.size());
+			mDepths[route] = depth;
+		}
+
+
+		void ModulationMatrixNode::process()
+		{
+			// While the gate is silent the voice is idle, the outputs are filled with the last values once
+			auto gateBuffer = gate.pull();
+			if (gateBuffer != nullptr && std::all_of(gateBuffer->begin(), gateBuffer->end(), [](SampleValue sample) { return sample == 0.f; }))
+			{
+				if (!mIdle)
+				{
+					for (auto target = 0; target < mOutputs.size(); ++target)
+					{
+						auto& outputBuffer = getOutputBuffer(*mOutputs[target]);
+						std::fill(outputBuffer.begin(), outputBuffer.end(), mValues[target].load());
+					}
+					mIdle = true;
+				}
+				return;
+			}
+			mIdle = false;
+
+			for (auto source = 0; source < mSources.size(); ++source)
+			{
+				auto buffer = mSources[source]->pull();
+				mSourceBuffers[source] = buffer;
+				mSourceValues[source] = buffer != nullptr ? buffer->back() : 0.f;
+			}
+
+			const auto velocity = mVelocity.load();
+			const auto& kernels = getSimdKernels();
+
+			for (auto targetIndex = 0; targetIndex < mTargets.size(); ++targetIndex)
+			{
+				auto& target = mTargets[targetIndex];
+				auto& outputBuffer = getOutputBuffer(*mOutputs[targetIndex]);
+				auto value = mBases[targetIndex].load();
+
+				if (target.mAudioRate)
+				{
+					// Sum the constant parts first, then mix in the source signals
+					for (auto routeIndex : mTargetRoutes[targetIndex])
+					{
+						auto& route = mRoutes[routeIndex];
+						if (route.mSource == VelocitySource)
+							value += mDepths[routeIndex].load() * velocity;
+					}
+					std::fill(outputBuffer.begin(), outputBuffer.end(), value);
+					for (auto routeIndex : mTargetRoutes[targetIndex])
+					{
+						auto& route = mRoutes[routeIndex];
+						if (route.mSource != VelocitySource && mSourceBuffers[route.mSource] != nullptr)
+							kernels.mix(outputBuffer.data(), mSourceBuffers[route.mSource]->data(), mDepths[routeIndex].load(), outputBuffer.size());
+					}
+					clamp(outputBuffer.data(), outputBuffer.size(), target.mMinimum, target.mMaximum);
+					mValues[targetIndex].store(outputBuffer.back());
+				}
+				else {
+					for (auto routeIndex : mTargetRoutes[targetIndex])
+					{
+						auto& route = mRoutes[routeIndex];
+						auto sourceValue = route.mSource == VelocitySource ? velocity : mSourceValues[route.mSource];
+						value += mDepths[routeIndex].load() * sourceValue;
+					}
+					value = std::min(std::max(value, target.mMinimum), target.mMaximum);
+					std::fill(outputBuffer.begin(), outputBuffer.end(), value);
+					mValues[targetIndex].store(value);
+					if (target.mSetter)
+						target.mSetter(value);
+				}
+			}
+		}
+
+
+		void ModulationMatrixNode::clamp(SampleValue* data, int count, ControllerValue minimum, ControllerValue maximum)
+		{
+			for (auto i = 0; i < count; ++i)
+				data[i] = std::min(std::max(data[i], minimum), maximum);
+		}
+
+	}
+
+}
@@ -0,0 +1,159 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Modulation matrix that routes modulation sources to parameter targets on the audio thread.
+		 * Sources are signals connected to the source input pins, or the note velocity.
+		 * The value of a target is its base value plus the sum of all sources routed to it, each scaled by the depth of its route.
+		 * Every target has an output pin carrying its value. Audio rate targets render the value per sample, control rate targets once per buffer.
+		 * Control rate targets can have a setter that is called once per buffer with the new value, for example to set the cutoff frequency of a filter.
+		 * The node is registered as a root process so it is processed every buffer, also when none of its outputs is connected.
+		 * Connect the gate, normally to the envelope of the voice, to skip the computation while the voice is idle:
+		 * while the gate signal is silent the targets keep their last values and the outputs hold them.
+		 */
+		class NAPAPI ModulationMatrixNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * Source index of a route that is modulated by the note velocity.
+			 */
+			static constexpr int VelocitySource = -1;
+
+			/**
+			 * A parameter modulated by the matrix.
+			 */
+			struct Target
+			{
+				std::function<void(ControllerValue)> mSetter = nullptr;                         ///< Called once per buffer on the audio thread with the value of a control rate target, can be empty.
+				bool mAudioRate = false;                                                        ///< True to render the value per sample, false to compute it once per buffer.
+				ControllerValue mBase = 0.f;                                                    ///< Value of the target before modulation.
+				ControllerValue mMinimum = std::numeric_limits<ControllerValue>::lowest();      ///< The value is clamped to this minimum.
+				ControllerValue mMaximum = std::numeric_limits<ControllerValue>::max();         ///< The value is clamped to this maximum.
+			};
+
+			/**
+			 * A connection from a source to a target.
+			 */
+			struct Route
+			{
+				int mSource = 0;                ///< Index of the source input, or VelocitySource.
+				int mTarget = 0;                ///< Index of the target.
+				ControllerValue mDepth = 0.f;   ///< Multiplier of the source value.
+			};
+
+		public:
+			/**
+			 * Constructor
+			 * @param manager The node manager this node is processed on.
+			 * @param sourceCount Number of source input pins.
+			 * @param targets The targets of the matrix.
+			 * @param routes The routes of the matrix. Source and target indices have to be valid.
+			 */
+			ModulationMatrixNode(NodeManager& manager, int sourceCount, const std::vector<Target>& targets, const std::vector<Route>& routes);
+
+			~ModulationMatrixNode() override;
+
+			/**
+			 * Optional gate, the matrix is only computed while the signal on this input is not silent.
+			 */
+			InputPin gate = { this };
+
+			/**
+			 * @param index Index of the source
+			 * @return Input pin of the source, the matrix uses its first channel.
+			 */
+			InputPin& getSource(int index) { return *mSources[index]; }
+
+			/**
+			 * @param target Index of the target
+			 * @return Output pin carrying the value of the target.
+			 */
+			OutputPin& getOutput(int target) { return *mOutputs[target]; }
+
+			/**
+			 * @return Number of source input pins
+			 */
+			int getSourceCount() const { return mSources.size(); }
+
+			/**
+			 * @return Number of targets
+			 */
+			int getTargetCount() const { return mTargets.size(); }
+
+			/**
+			 * @return Number of routes
+			 */
+			int getRouteCount() const { return mRoutes.size(); }
+
+			/**
+			 * Sets the value of a target before modulation.
+			 * @param target Index of the target
+			 * @param value New base value
+			 */
+			void setBase(int target, ControllerValue value);
+
+			/**
+			 * Sets the depth of a route.
+			 * @param route Index of the route
+			 * @param depth New multiplier of the source value
+			 */
+			void setDepth(int route, ControllerValue depth);
+
+			/**
+			 * Sets the note velocity, the value of VelocitySource.
+			 * @param velocity Velocity, normally between 0 and 1.
+			 */
+			void setVelocity(ControllerValue velocity) { mVelocity = velocity; }
+
+			/**
+			 * @param target Index of the target
+			 * @return The value of the target at the end of the last processed buffer.
+			 */
+			ControllerValue getValue(int target) const { return mValues[target].load(); }
+
+		private:
+			void process() override;
+
+			// Clamps the output of an audio rate target to its range
+			static void clamp(SampleValue* data, int count, ControllerValue minimum, ControllerValue maximum);
+
+			std::vector<std::unique_ptr<InputPin>> mSources;
+			std::vector<std::unique_ptr<OutputPin>> mOutputs;
+			std::vector<Target> mTargets;
+			std::vector<Route> mRoutes;
+			std::vector<std::vector<int>> mTargetRoutes; // Indices of the routes of every target
+
+			std::vector<std::atomic<ControllerValue>> mBases;
+			std::vector<std::atomic<ControllerValue>> mDepths;
+			std::vector<std::atomic<ControllerValue>> mValues;
+			std::atomic<ControllerValue> mVelocity = { 1.f };
+
+			bool mIdle = false; // True while the gate is silent and the outputs hold the last values
+			std::vector<SampleBuffer*> mSourceBuffers; // Source buffers pulled in the current buffer, nullptr for unconnected sources
+			std::vector<ControllerValue> mSourceValues; // Last sample of every source buffer
+		};
+
+	}
+
+}
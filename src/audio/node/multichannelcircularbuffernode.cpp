@@ -0,0 +1,77 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "multichannelcircularbuffernode.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MultichannelCircularBufferNode)
+	RTTI_FUNCTION("getChannelCount", &nap::audio::MultichannelCircularBufferNode::getChannelCount)
+	RTTI_FUNCTION("clear", &nap::audio::MultichannelCircularBufferNode::clear)
+	RTTI_FUNCTION("setFrozen", &nap::audio::MultichannelCircularBufferNode::setFrozen)
+	RTTI_FUNCTION("isFrozen", &nap::audio::MultichannelCircularBufferNode::isFrozen)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		MultichannelCircularBufferNode::MultichannelCircularBufferNode(NodeManager& nodeManager, int channelCount, unsigned int bufferSize, bool rootProcess) :
+			Node(nodeManager), mRootProcess(rootProcess)
+		{
+			mSize = 1;
+			while (mSize < bufferSize && mSize < MaxSize)
+				mSize *= 2;
+
+			channelCount = std::max(channelCount, 1);
+			mBuffer.resize(size_t(mSize) * channelCount, 0.f);
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				mInputs.emplace_back(std::make_unique<InputPin>(this));
+				mViews.emplace_back(mBuffer.data() + size_t(mSize) * channel, mSize, mWritePosition);
+			}
+
+			if (rootProcess)
+				getNodeManager().registerRootProcess(*this);
+		}
+
+
+		MultichannelCircularBufferNode::~MultichannelCircularBufferNode()
+		{
+			if (mRootProcess)
+				getNodeManager().unregisterRootProcess(*this);
+		}
+
+
+		void MultichannelCircularBufferNode::process()
+		{
+			// Clearing writes a whole buffer of silence, so readers notice it like any other overwrite
+			if (mClear.exchange(false, std::memory_order_acquire))
+			{
+				mWritePosition.beginWrite(mSize);
+				std::fill(mBuffer.begin(), mBuffer.end(), 0.f);
+				mWritePosition.endWrite();
+			}
+
+			const bool frozen = mFrozen.load();
+			DiscreteTimeValue writePosition = 0;
+			if (!frozen)
+				writePosition = mWritePosition.beginWrite(getBufferSize());
+			for (auto channel = 0; channel < mInputs.size(); ++channel)
+			{
+				auto inputBuffer = mInputs[channel]->pull();
+				if (!frozen)
+					writeCircularBuffer(mBuffer.data() + size_t(mSize) * channel, mSize, writePosition, inputBuffer != nullptr ? inputBuffer->data() : nullptr, getBufferSize());
+			}
+
+			if (!frozen)
+				mWritePosition.endWrite();
+		}
+
+	}
+
+}
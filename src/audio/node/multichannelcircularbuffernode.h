@@ -0,0 +1,106 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/circularbufferview.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Circular buffer for any number of channels with a single write position, filled by the input pins of the channels.
+		 * The channels are stored planar in one block of memory and are written by one root process, instead of one @CircularBufferNode per channel.
+		 * Every channel can be read through a @CircularBufferView, for example by a @CircularBufferPlayerNode or a @GranularNode.
+		 * The buffer is lock free with the audio thread as its single writer.
+		 */
+		class NAPAPI MultichannelCircularBufferNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			static constexpr unsigned int MaxSize = 1u << 31; ///< Largest size of the circular buffer of every channel
+
+			/**
+			 * Differs to the default signature of @Node constructors and therefore cannot be wrapped in a NodeObject.
+			 * @param nodeManager @NodeManager that de Node will be processed by.
+			 * @param channelCount Number of channels
+			 * @param bufferSize Size of the circular buffer of every channel, rounded up to a power of two and at most MaxSize.
+			 * @param rootProcess Indicates wether the node will be processed automatically by the @NodeManager.
+			 */
+			MultichannelCircularBufferNode(NodeManager& nodeManager, int channelCount, unsigned int bufferSize, bool rootProcess = true);
+
+			~MultichannelCircularBufferNode() override;
+
+			/**
+			 * @param channel Index of the channel
+			 * @return Input pin that feeds the channel.
+			 */
+			InputPin& getInput(int channel) { return *mInputs[channel]; }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return Read access to the channel.
+			 */
+			const CircularBufferView& getView(int channel) const { return mViews[channel]; }
+
+			/**
+			 * @return Number of channels
+			 */
+			int getChannelCount() const { return mInputs.size(); }
+
+			/**
+			 * @return The number of samples written to every channel since construction. The next samples will be written at this position.
+			 */
+			DiscreteTimeValue getWritePosition() const { return mWritePosition.getWritePosition(); }
+
+			/**
+			 * @return The size of the buffer of every channel in samples.
+			 */
+			unsigned int getSize() const { return mSize; }
+
+			/**
+			 * Clears the contents of all channels. Can be called from any thread, the buffer is cleared by the audio thread before it writes the next samples.
+			 * The clear counts as writing a whole buffer of silence: the write position advances by the size of the buffer, so reads that overlap the clear are detected as overruns.
+			 */
+			void clear() { mClear.store(true, std::memory_order_release); }
+
+			/**
+			 * Freezes the contents of all channels: while frozen the inputs are still pulled, but not written and the write position does not advance.
+			 * @param frozen True to freeze the buffer, false to resume writing.
+			 */
+			void setFrozen(bool frozen) { mFrozen.store(frozen); }
+
+			/**
+			 * @return Whether the buffer is frozen.
+			 */
+			bool isFrozen() const { return mFrozen.load(); }
+
+		private:
+			void process() override;
+
+			std::vector<std::unique_ptr<InputPin>> mInputs;
+			SampleBuffer mBuffer; // All channels one after another
+			unsigned int mSize = 0;
+			std::vector<CircularBufferView> mViews;
+			CircularBufferPosition mWritePosition;
+			std::atomic<bool> mClear = { false }; // Set when the buffer has to be cleared before the next write
+			std::atomic<bool> mFrozen = { false };
+
+			bool mRootProcess = false;
+		};
+
+	}
+
+}
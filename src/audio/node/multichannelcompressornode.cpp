@@ -0,0 +1,165 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "multichannelcompressornode.h"
+
+// Std includes
+#include <cmath>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/fastmath.h>
+
+RTTI_BEGIN_ENUM(nap::audio::MultiChannelCompressorNode::ELink)
+	RTTI_ENUM_VALUE(nap::audio::MultiChannelCompressorNode::ELink::None, "None"),
+	RTTI_ENUM_VALUE(nap::audio::MultiChannelCompressorNode::ELink::Maximum, "Maximum"),
+	RTTI_ENUM_VALUE(nap::audio::MultiChannelCompressorNode::ELink::Average, "Average")
+RTTI_END_ENUM
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MultiChannelCompressorNode)
+	RTTI_PROPERTY("sidechainInput", &nap::audio::MultiChannelCompressorNode::sidechainInput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_FUNCTION("setRatio", &nap::audio::MultiChannelCompressorNode::setRatio)
+	RTTI_FUNCTION("setThreshold", &nap::audio::MultiChannelCompressorNode::setThreshold)
+	RTTI_FUNCTION("setAttack", &nap::audio::MultiChannelCompressorNode::setAttack)
+	RTTI_FUNCTION("setRelease", &nap::audio::MultiChannelCompressorNode::setRelease)
+	RTTI_FUNCTION("setLink", &nap::audio::MultiChannelCompressorNode::setLink)
+	RTTI_FUNCTION("setGainInterval", &nap::audio::MultiChannelCompressorNode::setGainInterval)
+	RTTI_FUNCTION("getGainReduction", &nap::audio::MultiChannelCompressorNode::getGainReduction)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Lowest level fed to the log2 approximation, which needs normalized input
+		static constexpr float MinimumLevel = 1e-10f;
+
+		// 20 * log10(x) = 20 * log10(2) * log2(x) and 10^(0.05 * x) = 2^(0.05 * log2(10) * x)
+		static constexpr float Log2ToDecibel = 6.02059991f;
+		static constexpr float DecibelToLog2 = 0.166096404f;
+
+
+		MultiChannelCompressorNode::MultiChannelCompressorNode(NodeManager& manager, int channelCount) : Node(manager)
+		{
+			channelCount = std::max(channelCount, 1);
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				mInputs.emplace_back(std::make_unique<InputPin>(this));
+				mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+			}
+			mInputBuffers.resize(channelCount, nullptr);
+			mOutputBuffers.resize(channelCount, nullptr);
+
+			auto groupCount = (channelCount + 7) / 8;
+			mEnvelope.resize(groupCount, float8(0.f));
+			mReduction.resize(groupCount, float8(0.f));
+			mGain.resize(groupCount, float8(1.f));
+			mGainStep.resize(groupCount, float8(0.f));
+			mFrame.resize(groupCount * 8, 0.f);
+		}
+
+
+		void MultiChannelCompressorNode::process()
+		{
+			const int channelCount = mInputs.size();
+			const int groupCount = mEnvelope.size();
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				mInputBuffers[channel] = mInputs[channel]->pull();
+				mOutputBuffers[channel] = &getOutputBuffer(*mOutputs[channel]);
+			}
+			auto sidechainBuffer = sidechainInput.pull();
+			auto link = mLink.load();
+
+			// Coefficients of FaustCompressor, with the times in ms
+			auto samplesPerMillisecond = getNodeManager().getSamplesPerMillisecond();
+			auto attackSamples = std::max(mAttack.load() * samplesPerMillisecond, 1.f);
+			auto releaseSamples = std::max(mRelease.load() * samplesPerMillisecond, 1.f);
+			auto attackCoefficient = std::exp(-1.f / attackSamples);
+			auto releaseCoefficient = std::exp(-1.f / releaseSamples);
+			auto gainInterval = mGainInterval.load();
+			auto smoothing = std::exp(-2.f * gainInterval / attackSamples);
+			auto slope = 1.f / std::max(mRatio.load(), 1.f) - 1.f;
+
+			const float8 attack(attackCoefficient);
+			const float8 release(releaseCoefficient);
+			const float8 attackInput(1.f - attackCoefficient);
+			const float8 releaseInput(1.f - releaseCoefficient);
+			const float8 threshold(mThreshold.load());
+			const float8 smoothingVector(smoothing);
+			const float8 overshootScale(slope * (1.f - smoothing));
+			const float8 inverseInterval(1.f / gainInterval);
+			const float8 minimumLevel(MinimumLevel);
+			const float8 zero(0.f);
+			// The follower picks the attack coefficient for a rising level and the release coefficient for a falling level.
+			// With the attack faster than the release the attack result is the larger of the two on a rising level and the smaller on a falling level.
+			const auto attackIsFaster = attackCoefficient <= releaseCoefficient;
+
+			for (auto i = 0; i < getBufferSize(); ++i)
+			{
+				for (auto channel = 0; channel < channelCount; ++channel)
+					mFrame[channel] = mInputBuffers[channel] != nullptr ? (*mInputBuffers[channel])[i] : 0.f;
+
+				// A linked level is shared by all lanes, a negative value means every lane detects its own level
+				auto linkedLevel = -1.f;
+				if (sidechainBuffer != nullptr)
+					linkedLevel = std::fabs((*sidechainBuffer)[i]);
+				else if (link == ELink::Maximum)
+				{
+					linkedLevel = 0.f;
+					for (auto channel = 0; channel < channelCount; ++channel)
+						linkedLevel = std::max(linkedLevel, std::fabs(mFrame[channel]));
+				}
+				else if (link == ELink::Average)
+				{
+					linkedLevel = 0.f;
+					for (auto channel = 0; channel < channelCount; ++channel)
+						linkedLevel += std::fabs(mFrame[channel]);
+					linkedLevel /= channelCount;
+				}
+
+				auto computeGain = --mGainCounter <= 0;
+				if (computeGain)
+					mGainCounter = gainInterval;
+
+				for (auto group = 0; group < groupCount; ++group)
+				{
+					auto frame = mFrame.data() + group * 8;
+					const float8 input(frame);
+					const float8 level = linkedLevel >= 0.f ? float8(linkedLevel) : maxVec(input, zero - input);
+
+					auto& envelope = mEnvelope[group];
+					const float8 attacked = envelope * attack + level * attackInput;
+					const float8 released = envelope * release + level * releaseInput;
+					envelope = attackIsFaster ? maxVec(attacked, released) : minVec(attacked, released);
+
+					if (computeGain)
+					{
+						auto& reduction = mReduction[group];
+						const float8 overshoot = maxVec(fastLog2(maxVec(envelope, minimumLevel)) * Log2ToDecibel - threshold, zero);
+						reduction = reduction * smoothingVector + overshoot * overshootScale;
+						mGainStep[group] = (fastExp2(reduction * DecibelToLog2) - mGain[group]) * inverseInterval;
+					}
+					mGain[group] = mGain[group] + mGainStep[group];
+					(input * mGain[group]).store(frame);
+				}
+
+				for (auto channel = 0; channel < channelCount; ++channel)
+					(*mOutputBuffers[channel])[i] = mFrame[channel];
+			}
+
+			// Meter the largest gain reduction over the used lanes
+			auto gainReduction = 0.f;
+			for (auto group = 0; group < groupCount; ++group)
+				mReduction[group].store(mFrame.data() + group * 8);
+			for (auto channel = 0; channel < channelCount; ++channel)
+				gainReduction = std::min(gainReduction, mFrame[channel]);
+			mGainReduction.store(gainReduction);
+		}
+
+	}
+
+}
@@ -0,0 +1,135 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/vectorextension.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Multichannel compressor with the characteristic of @FaustCompressor.
+		 * Channels are processed in groups of 8 in the lanes of a float8 vector, using the polynomial log2 and exp2 approximations from fastmath.h.
+		 * The level detection can be linked across all channels, so that every channel gets the same gain reduction, or driven by an external sidechain signal.
+		 * The gain computation can run at control rate: once every gain interval samples, with the gain linearly interpolated in between.
+		 */
+		class NAPAPI MultiChannelCompressorNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * How the level detection of the channels is linked.
+			 */
+			enum class ELink
+			{
+				None,       ///< Every channel detects its own level.
+				Maximum,    ///< All channels follow the loudest channel.
+				Average     ///< All channels follow the average rectified level of the channels.
+			};
+
+			/**
+			 * Constructor
+			 * @param manager The node manager this node is processed on.
+			 * @param channelCount Number of input and output channels.
+			 */
+			MultiChannelCompressorNode(NodeManager& manager, int channelCount = 2);
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The input pin of the channel
+			 */
+			InputPin& getInput(int channel) { return *mInputs[channel]; }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The output pin of the channel
+			 */
+			OutputPin& getOutput(int channel) { return *mOutputs[channel]; }
+
+			/**
+			 * @return Number of channels
+			 */
+			int getChannelCount() const { return mInputs.size(); }
+
+			/**
+			 * @param ratio Ratio between 1 and 20.
+			 */
+			void setRatio(ControllerValue ratio) { mRatio = ratio; }
+
+			/**
+			 * @param threshold Threshold in dB between -90 and 0dB.
+			 */
+			void setThreshold(ControllerValue threshold) { mThreshold = threshold; }
+
+			/**
+			 * @param attack Attack time in ms.
+			 */
+			void setAttack(TimeValue attack) { mAttack = attack; }
+
+			/**
+			 * @param release Release time in ms.
+			 */
+			void setRelease(TimeValue release) { mRelease = release; }
+
+			/**
+			 * @param link How the level detection of the channels is linked. Ignored when the sidechain input is connected.
+			 */
+			void setLink(ELink link) { mLink = link; }
+
+			/**
+			 * @param samples Number of samples between two gain computations, the gain is interpolated in between. 1 computes the gain every sample.
+			 */
+			void setGainInterval(int samples) { mGainInterval = std::max(samples, 1); }
+
+			/**
+			 * @return The largest gain reduction in dB over all channels at the end of the last processed buffer, 0 or negative.
+			 */
+			ControllerValue getGainReduction() const { return mGainReduction.load(); }
+
+			/**
+			 * When connected the level of the first channel of the sidechain drives the gain reduction of all channels.
+			 */
+			InputPin sidechainInput = { this };
+
+		private:
+			void process() override;
+
+			std::vector<std::unique_ptr<InputPin>> mInputs;
+			std::vector<std::unique_ptr<OutputPin>> mOutputs;
+			std::vector<SampleBuffer*> mInputBuffers;
+			std::vector<SampleBuffer*> mOutputBuffers;
+
+			std::atomic<ControllerValue> mRatio = { 4.f };
+			std::atomic<ControllerValue> mThreshold = { -6.f };
+			std::atomic<TimeValue> mAttack = { 0.8f };
+			std::atomic<TimeValue> mRelease = { 500.f };
+			std::atomic<ELink> mLink = { ELink::None };
+			std::atomic<int> mGainInterval = { 1 };
+			std::atomic<ControllerValue> mGainReduction = { 0.f };
+
+			// Audio thread state, one vector per group of 8 channels
+			std::vector<float8> mEnvelope; // Rectified level after the attack and release follower
+			std::vector<float8> mReduction; // Smoothed gain reduction in dB
+			std::vector<float8> mGain; // Current linear gain
+			std::vector<float8> mGainStep; // Gain increment per sample towards the last computed gain
+			std::vector<float> mFrame; // One sample of every channel, padded to a multiple of 8
+			int mGainCounter = 0;
+		};
+
+	}
+
+}
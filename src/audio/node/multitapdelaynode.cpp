@@ -0,0 +1,112 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "multitapdelaynode.h"
+
+// Std includes
+#include <cmath>
+
+// Nap includes
+#include <mathutils.h>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/simddispatch.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MultiTapDelayNode)
+	RTTI_PROPERTY("input", &nap::audio::MultiTapDelayNode::input, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_PROPERTY("leftOutput", &nap::audio::MultiTapDelayNode::leftOutput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_PROPERTY("rightOutput", &nap::audio::MultiTapDelayNode::rightOutput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_FUNCTION("setTap", &nap::audio::MultiTapDelayNode::setTap)
+	RTTI_FUNCTION("setTapTime", &nap::audio::MultiTapDelayNode::setTapTime)
+	RTTI_FUNCTION("setTapGain", &nap::audio::MultiTapDelayNode::setTapGain)
+	RTTI_FUNCTION("setTapPan", &nap::audio::MultiTapDelayNode::setTapPan)
+	RTTI_FUNCTION("getTapCount", &nap::audio::MultiTapDelayNode::getTapCount)
+	RTTI_FUNCTION("getMaxTime", &nap::audio::MultiTapDelayNode::getMaxTime)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		MultiTapDelayNode::MultiTapDelayNode(NodeManager& manager, int tapCount, TimeValue maxTime) :
+			Node(manager), mDelayMemory(DelayMemory::get(manager)), mMaxTime(std::max(maxTime, 0.f)), mTaps(std::max(tapCount, 1))
+		{
+			allocate();
+			mTapBuffer.resize(getBufferSize());
+		}
+
+
+		void MultiTapDelayNode::setTap(int index, TimeValue time, ControllerValue gain, ControllerValue pan)
+		{
+			setTapTime(index, time);
+			setTapGain(index, gain);
+			setTapPan(index, pan);
+		}
+
+
+		void MultiTapDelayNode::allocate()
+		{
+			int maxTime = std::ceil(mMaxTime * getNodeManager().getSamplesPerMillisecond());
+			mDelay.allocate(*mDelayMemory, maxTime + getBufferSize());
+		}
+
+
+		void MultiTapDelayNode::process()
+		{
+			auto inputBuffer = input.pull();
+			auto& leftBuffer = getOutputBuffer(leftOutput);
+			auto& rightBuffer = getOutputBuffer(rightOutput);
+			auto& kernels = getSimdKernels();
+			const int count = leftBuffer.size();
+			const auto samplesPerMillisecond = getNodeManager().getSamplesPerMillisecond();
+
+			// Write the input first, so taps shorter than the buffer read the current buffer
+			if (inputBuffer != nullptr)
+				mDelay.writeBlock(inputBuffer->data(), count);
+			else {
+				std::fill(mTapBuffer.begin(), mTapBuffer.end(), 0.f);
+				mDelay.writeBlock(mTapBuffer.data(), count);
+			}
+
+			std::fill(leftBuffer.begin(), leftBuffer.end(), 0.f);
+			std::fill(rightBuffer.begin(), rightBuffer.end(), 0.f);
+
+			for (auto& tap : mTaps)
+			{
+				auto gain = tap.mGain.load();
+				if (gain == 0.f)
+					continue;
+
+				// Equal power panning
+				auto angle = (std::min(std::max(tap.mPan.load(), -1.f), 1.f) + 1.f) * math::PI * 0.25f;
+				auto leftGain = gain * std::cos(angle);
+				auto rightGain = gain * std::sin(angle);
+
+				// The first sample of the buffer is count - 1 samples older than the last sample written
+				int time = std::round(tap.mTime.load() * samplesPerMillisecond);
+				mDelay.readBlock(time + count - 1, mTapBuffer.data(), count);
+				kernels.mix(leftBuffer.data(), mTapBuffer.data(), leftGain, count);
+				kernels.mix(rightBuffer.data(), mTapBuffer.data(), rightGain, count);
+			}
+		}
+
+
+		void MultiTapDelayNode::sampleRateChanged(float sampleRate)
+		{
+			allocate();
+		}
+
+
+		void MultiTapDelayNode::bufferSizeChanged(int size)
+		{
+			mTapBuffer.resize(size);
+			allocate();
+		}
+
+	}
+
+}
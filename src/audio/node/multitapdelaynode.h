@@ -0,0 +1,107 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/delayline.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Delay line with any number of taps that are read from the same line, for example for early reflections.
+		 * Each tap has its own delay time, gain and equal power pan position between the left and the right output.
+		 * Every buffer the input is written to the line as one block, after which every tap is read as one span and mixed into both outputs.
+		 * Tap times are rounded to whole samples and tap gains change at buffer boundaries.
+		 */
+		class NAPAPI MultiTapDelayNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * Constructor
+			 * @param manager The node manager this node is processed on.
+			 * @param tapCount Number of taps.
+			 * @param maxTime Maximum delay time of the taps in ms.
+			 */
+			MultiTapDelayNode(NodeManager& manager, int tapCount = 8, TimeValue maxTime = 100.f);
+
+			InputPin input = { this };          ///< The mono input signal.
+			OutputPin leftOutput = { this };    ///< The sum of the taps panned to the left.
+			OutputPin rightOutput = { this };   ///< The sum of the taps panned to the right.
+
+			/**
+			 * Sets all parameters of a tap.
+			 * @param index Index of the tap
+			 * @param time Delay time in ms, clamped to the maximum delay time.
+			 * @param gain Gain multiplier of the tap, 0 disables the tap.
+			 * @param pan Pan position between -1 (left) and 1 (right).
+			 */
+			void setTap(int index, TimeValue time, ControllerValue gain, ControllerValue pan);
+
+			/**
+			 * @param index Index of the tap
+			 * @param time Delay time in ms, clamped to the maximum delay time.
+			 */
+			void setTapTime(int index, TimeValue time) { mTaps[index].mTime = std::min(std::max(time, 0.f), mMaxTime); }
+
+			/**
+			 * @param index Index of the tap
+			 * @param gain Gain multiplier of the tap, 0 disables the tap.
+			 */
+			void setTapGain(int index, ControllerValue gain) { mTaps[index].mGain = gain; }
+
+			/**
+			 * @param index Index of the tap
+			 * @param pan Pan position between -1 (left) and 1 (right).
+			 */
+			void setTapPan(int index, ControllerValue pan) { mTaps[index].mPan = pan; }
+
+			/**
+			 * @return Number of taps
+			 */
+			int getTapCount() const { return mTaps.size(); }
+
+			/**
+			 * @return The maximum delay time of the taps in ms.
+			 */
+			TimeValue getMaxTime() const { return mMaxTime; }
+
+		private:
+			struct Tap
+			{
+				std::atomic<TimeValue> mTime = { 0.f }; // In ms
+				std::atomic<ControllerValue> mGain = { 0.f };
+				std::atomic<ControllerValue> mPan = { 0.f };
+			};
+
+			void process() override;
+			void sampleRateChanged(float sampleRate) override;
+			void bufferSizeChanged(int size) override;
+
+			// Allocates the delay line for the maximum time plus one buffer
+			void allocate();
+
+			std::shared_ptr<DelayMemory> mDelayMemory = nullptr;
+			TimeValue mMaxTime = 0.f;
+			std::vector<Tap> mTaps;
+			DelayLine<SampleValue> mDelay;
+			SampleBuffer mTapBuffer; // Samples of one tap for the current buffer
+		};
+
+	}
+
+}
@@ -6,6 +6,9 @@
 
 #include <math.h>
 
+// Std includes
+#include <algorithm>
+
 // Rtti includes
 #include <rtti/rtti.h>
 
@@ -13,11 +16,20 @@
 #include <audio/utility/audiofunctions.h>
 #include <audio/utility/safeptr.h>
 #include <audio/core/audionodemanager.h>
+#include <audio/utility/simddispatch.h>
+#include <audio/utility/fastmath.h>
+#include <audio/utility/fft.h>
+
+RTTI_BEGIN_ENUM(nap::audio::OscillatorNode::Interpolation)
+    RTTI_ENUM_VALUE(nap::audio::OscillatorNode::Interpolation::Linear, "Linear"),
+    RTTI_ENUM_VALUE(nap::audio::OscillatorNode::Interpolation::Cubic, "Cubic")
+RTTI_END_ENUM
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::OscillatorNode)
     RTTI_FUNCTION("setFrequency", &nap::audio::OscillatorNode::setFrequency)
     RTTI_FUNCTION("setAmplitude", &nap::audio::OscillatorNode::setAmplitude)
     RTTI_FUNCTION("setPhaseOffset", &nap::audio::OscillatorNode::setPhase)
+    RTTI_FUNCTION("setInterpolation", &nap::audio::OscillatorNode::setInterpolation)
     RTTI_PROPERTY("fmInput", &nap::audio::OscillatorNode::fmInput, nap::rtti::EPropertyMetaData::Embedded)
     RTTI_PROPERTY("audioOutput", &nap::audio::OscillatorNode::output, nap::rtti::EPropertyMetaData::Embedded)
 RTTI_END_CLASS
@@ -30,56 +42,99 @@ namespace nap
         
 // --- Wavetable --- //
 
-		WaveTable::WaveTable(long size, Waveform waveform, int numberOfBands)
+		WaveTable::WaveTable(long size, Waveform waveform, int numberOfBands, float nyquist) :
+			mData(generate(size, waveform, numberOfBands, nyquist))
         {
+        }
+
+
+		std::shared_ptr<WaveTable::Data> WaveTable::generate(long size, Waveform waveform, int numberOfBands, float nyquist)
+		{
+			auto data = std::make_shared<Data>();
 			if (waveform == Waveform::Sine)
 			{
-				mData.resize(1, size);
-				mBandBottoms.emplace_back(0);
-				auto& bandData = mData[0];
+				data->mBands.resize(1, size);
+				data->mBandBottoms.emplace_back(0);
+				auto& bandData = data->mBands[0];
 				auto step = math::PIX2 / size;
 				for (int i = 0; i < size; i++)
 					bandData[i] = sin(i * step);
+				return data;
 			}
-			else {
-				auto bandWidth = log2f(Nyquist) / numberOfBands;
-				mData.resize(numberOfBands, size);
-				mBandBottoms.resize(numberOfBands);
+
+			std::vector<float> bandFrequencies;
+			if (numberOfBands > 0)
+			{
+				auto bandWidth = log2f(nyquist) / numberOfBands;
 				for (auto band = 0; band < numberOfBands; ++band)
-				{
-					auto bandFrequency = pow(2.f, bandWidth * band);
-					mBandBottoms[band] = bandFrequency;
-					auto& bandData = mData[band];
+					bandFrequencies.emplace_back(pow(2.f, bandWidth * band));
+			}
+			else {
+				for (auto bandFrequency = 1.f; bandFrequency < nyquist; bandFrequency *= 2.f)
+					bandFrequencies.emplace_back(bandFrequency);
+			}
 
-					auto harmonic = 1;
-					bool negative = false;
-					while (bandFrequency * harmonic < Nyquist)
+			data->mBands.resize(bandFrequencies.size(), size);
+			data->mBandBottoms.assign(bandFrequencies.begin(), bandFrequencies.end());
+
+			const bool powerOfTwo = size > 0 && (size & (size - 1)) == 0;
+			std::vector<float> amplitudes(size / 2);
+			std::vector<std::complex<float>> spectrum(powerOfTwo ? size : 0);
+			for (auto band = 0; band < bandFrequencies.size(); ++band)
+			{
+				auto bandFrequency = bandFrequencies[band];
+				auto& bandData = data->mBands[band];
+
+				// Harmonic amplitudes. The table can not hold harmonics at or above half its size.
+				std::fill(amplitudes.begin(), amplitudes.end(), 0.f);
+				auto harmonic = 1;
+				bool negative = false;
+				while (bandFrequency * harmonic < nyquist && harmonic < amplitudes.size())
+				{
+					auto a = harmonic > 1.f ? 1.f / (waveform == Waveform::Triangle ? pow(harmonic, 2) : harmonic - 1.f) : 1.f;
+					if (negative)
+						a *= -1.f;
+					amplitudes[harmonic] = a;
+					harmonic++;
+					if (waveform == Waveform::Square)
+						harmonic++;
+					else if (waveform == Waveform::Triangle)
 					{
-						auto step = math::PIX2 / size;
-						auto a = harmonic > 1.f ? 1.f / (waveform == Waveform::Triangle ? pow(harmonic, 2) : harmonic - 1.f) : 1.f;
-						if (negative)
-							a *= -1.f;
-						for (auto i = 0; i < size; i++)
-							bandData[i] += a * sin(i * step * harmonic);
 						harmonic++;
-						if (waveform == Waveform::Square)
-							harmonic++;
-						else if (waveform == Waveform::Triangle)
-						{
-							harmonic++;
-							negative = !negative;
-						}
+						negative = !negative;
 					}
 				}
+
+				if (powerOfTwo)
+				{
+					// The imaginary part of the inverse transform of the amplitudes is the sum of the sine harmonics
+					std::fill(spectrum.begin(), spectrum.end(), 0.f);
+					for (auto i = 0; i < amplitudes.size(); ++i)
+						spectrum[i] = amplitudes[i];
+					fft(spectrum, true);
+					for (auto i = 0; i < size; i++)
+						bandData[i] = spectrum[i].imag();
+				}
+				else {
+					auto step = math::PIX2 / size;
+					for (auto h = 1; h < amplitudes.size(); ++h)
+						if (amplitudes[h] != 0.f)
+							for (auto i = 0; i < size; i++)
+								bandData[i] += amplitudes[h] * sin(i * step * h);
+				}
 			}
-        }
+			return data;
+		}
 
 
         void WaveTable::normalize()
         {
-			for (auto band = 0; band < mData.getChannelCount(); band++)
+			if (mData.use_count() > 1)
+				mData = std::make_shared<Data>(*mData);
+
+			for (auto band = 0; band < mData->mBands.getChannelCount(); band++)
 			{
-				auto& bandData = mData[band];
+				auto& bandData = mData->mBands[band];
 				SampleValue max, min;
 				max = min = bandData[0];
 
@@ -100,10 +155,7 @@ namespace nap
             int floor = index;
             SampleValue frac = index - floor;
 
-			auto band = 0;
-			while (frequency > mBandBottoms[band] && band < mBandBottoms.size() - 1)
-				band++;
-			auto& data = mData.channels[band];
+			auto& data = getBand(frequency);
             
             auto v1 = data[wrap(floor, data.size())];
             auto v2 = data[wrap(floor + 1, data.size())];
@@ -111,6 +163,22 @@ namespace nap
             return lerp(v1, v2, frac);
         }
 
+
+        int WaveTable::getBandIndex(float frequency) const
+        {
+			// The first band with a bottom frequency at or above the given frequency, the last band for frequencies above all bottoms
+			auto& bandBottoms = mData->mBandBottoms;
+			auto it = std::lower_bound(bandBottoms.begin(), bandBottoms.end() - 1, frequency);
+			return it - bandBottoms.begin();
+        }
+
+
+        bool WaveTable::isPowerOfTwo() const
+        {
+			auto size = getSize();
+			return size > 0 && (size & (size - 1)) == 0;
+        }
+
         
 // --- Oscillator --- //
 
@@ -118,6 +186,7 @@ namespace nap
         OscillatorNode::OscillatorNode(NodeManager& manager) : Node(manager)
         {
             mAmplitude.setStepCount(getNodeManager().getSamplesPerMillisecond());
+            bufferSizeChanged(getBufferSize());
         }
 
 
@@ -126,9 +195,39 @@ namespace nap
         {
             mStep = mWave->getSize() / getNodeManager().getSampleRate();
             mAmplitude.setStepCount(getNodeManager().getSamplesPerMillisecond());
+            bufferSizeChanged(getBufferSize());
         }
 
         
+        // Wraps a read position into [0, size)
+        static inline ControllerValue wrapPhase(ControllerValue position, ControllerValue size)
+        {
+            if (position >= size || position < 0)
+                position -= std::floor(position / size) * size;
+            return position;
+        }
+
+
+        // Fills phase with count wrapped read positions: start, start + increment, start + 2 * increment...
+        static void renderPhaseRamp(float* phase, int count, float start, float increment, float size)
+        {
+            const float8 lanes(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+            const float8 startVector(start);
+            const float8 incrementVector(increment);
+            const float8 sizeVector(size);
+            const float8 inverseSizeVector(1.f / size);
+            const float8 zero(0.f);
+            auto i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const float8 position = startVector + (lanes + float8(float(i))) * incrementVector;
+                maxVec(position - floorVec(position * inverseSizeVector) * sizeVector, zero).store(phase + i);
+            }
+            for (; i < count; ++i)
+                phase[i] = wrapPhase(start + i * increment, size);
+        }
+
+
         void OscillatorNode::process()
         {
             auto& outputBuffer = getOutputBuffer(output);
@@ -141,10 +240,84 @@ namespace nap
                 return;
             }
 
+            if (!mWave->isPowerOfTwo())
+            {
+                processPerSample(outputBuffer, fmInputBuffer);
+                return;
+            }
+
+            const auto bufferSize = getBufferSize();
+            const auto waveSize = ControllerValue(mWave->getSize());
+            const auto tableMask = int(mWave->getSize() - 1);
+            const auto step = mStep.load();
+            const auto phaseOffset = mPhaseOffset.load();
+            const auto& kernels = getSimdKernels();
+            const auto kernel = mInterpolation.load() == Interpolation::Cubic ? kernels.waveTableCubic : kernels.waveTable;
+
+            if (mAmplitude.isRamping())
+            {
+                for (auto i = 0; i < bufferSize; ++i)
+                    mAmplitudeBuffer[i] = mAmplitude.getNextValue();
+            }
+            else
+                std::fill(mAmplitudeBuffer.begin(), mAmplitudeBuffer.begin() + bufferSize, mAmplitude.getValue());
+
+            // The buffer is rendered in segments that each read from a single band.
+            // With a steady frequency the segment is the whole buffer, while the frequency ramps it is RampSegmentSize samples.
+            auto segmentStart = 0;
+            while (segmentStart < bufferSize)
+            {
+                auto segmentSize = bufferSize - segmentStart;
+                auto phase = mPhaseBuffer.data() + segmentStart;
+                ControllerValue bandFrequency = 0.f;
+
+                if (mFrequency.isRamping())
+                {
+                    segmentSize = std::min(segmentSize, RampSegmentSize);
+                    for (auto i = 0; i < segmentSize; ++i)
+                    {
+                        auto frequency = mFrequency.getNextValue();
+                        bandFrequency = std::max(bandFrequency, frequency);
+                        phase[i] = wrapPhase(mPhase + phaseOffset, waveSize);
+                        if (fmInputBuffer)
+                            mPhase = wrapPhase(mPhase + ((*fmInputBuffer)[segmentStart + i] + 1) * frequency * step, waveSize);
+                        else
+                            mPhase = wrapPhase(mPhase + frequency * step, waveSize);
+                    }
+                }
+                else {
+                    auto frequency = mFrequency.getValue();
+                    bandFrequency = frequency;
+                    if (fmInputBuffer)
+                    {
+                        for (auto i = 0; i < segmentSize; ++i)
+                        {
+                            phase[i] = wrapPhase(mPhase + phaseOffset, waveSize);
+                            mPhase = wrapPhase(mPhase + ((*fmInputBuffer)[segmentStart + i] + 1) * frequency * step, waveSize);
+                        }
+                    }
+                    else {
+                        // Without modulation the read positions form a straight line that is rendered with SIMD
+                        auto increment = frequency * step;
+                        renderPhaseRamp(phase, segmentSize, mPhase + phaseOffset, increment, waveSize);
+                        mPhase = wrapPhase(mPhase + segmentSize * increment, waveSize);
+                    }
+                }
+
+                // The band for the highest frequency in the segment keeps the whole segment free of aliasing
+                auto& band = selectBand(bandFrequency);
+                kernel(band.data(), tableMask, phase, mAmplitudeBuffer.data() + segmentStart, outputBuffer.data() + segmentStart, segmentSize);
+                segmentStart += segmentSize;
+            }
+        }
+
+
+        void OscillatorNode::processPerSample(SampleBuffer& outputBuffer, SampleBuffer* fmInputBuffer)
+        {
             auto waveSize = mWave->getSize();
             auto step = mStep.load();
             auto phaseOffset = mPhaseOffset.load();
-            
+
             for (auto i = 0; i < getBufferSize(); i++)
             {
 				auto frequency = mFrequency.getNextValue();
@@ -164,6 +337,18 @@ namespace nap
             }
         }
 
+
+        const SampleBuffer& OscillatorNode::selectBand(float frequency)
+        {
+            if (mBand == nullptr || mBandWave != mWave.get() || mBandFrequency != frequency)
+            {
+                mBandWave = mWave.get();
+                mBandFrequency = frequency;
+                mBand = &mWave->getBand(frequency);
+            }
+            return *mBand;
+        }
+
         
         void OscillatorNode::setAmplitude(ControllerValue amplitude, TimeValue rampTime)
         {
@@ -197,5 +382,12 @@ namespace nap
         {
             mStep = mWave->getSize() / sampleRate;
         }
+
+
+        void OscillatorNode::bufferSizeChanged(int size)
+        {
+            mPhaseBuffer.resize(size);
+            mAmplitudeBuffer.resize(size);
+        }
     }
 }
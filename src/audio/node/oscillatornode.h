@@ -6,6 +6,7 @@
 
 // Std includes
 #include <atomic>
+#include <memory>
 
 #include <audio/core/audionode.h>
 #include <audio/utility/linearsmoothedvalue.h>
@@ -21,6 +22,7 @@ namespace nap
          * A wavetable that can be used as waveform data for an oscillator.
          * Contains a buffer with one cycle of samples for a periodic waveform.
          * The WaveTable also supports "bandlimited" data,  which means that different waveforms are used for different frequency bands to avoid aliasing in high frequencies.
+         * The sample data is held by a shared @Data object, so wavetables with identical content can share their memory.
          */
         class NAPAPI WaveTable
         {
@@ -28,6 +30,15 @@ namespace nap
 			enum class Waveform { Sine, Saw, Square, Triangle };
 			static constexpr float Nyquist = 22500.f;
 
+			/**
+			 * The sample data of a wavetable: one buffer per band and the frequency up to which each band is used.
+			 */
+			struct Data
+			{
+				MultiSampleBuffer mBands;
+				std::vector<int> mBandBottoms;
+			};
+
         public:
             WaveTable()= default;
 
@@ -35,11 +46,36 @@ namespace nap
              * Constructor takes the size of the waveform buffer and the waveform type.
              * @param size Size of the waveform in samples
              * @param waveform
+             * @param numberOfBands Number of logarithmically spaced bands. 0 uses one band per octave.
+             * @param nyquist Highest frequency in the bandlimited waveforms, half the sample rate the wavetable is played at.
+             */
+            WaveTable(long size, Waveform waveform = Waveform::Sine, int numberOfBands = 1, float nyquist = Nyquist);
+
+            /**
+             * Constructor that shares data generated earlier, see @generate().
+             * @param data The sample data of the wavetable.
+             */
+            WaveTable(std::shared_ptr<Data> data) : mData(std::move(data)) { }
+
+            /**
+             * Generates the sample data of a wavetable.
+             * Every band is the sum of the harmonics below the nyquist frequency, computed with an inverse FFT when the size is a power of two.
+             * @param size Size of the waveform in samples
+             * @param waveform
+             * @param numberOfBands Number of logarithmically spaced bands. 0 uses one band per octave. Ignored for sine waves, which have a single band.
+             * @param nyquist Highest frequency in the bandlimited waveforms.
+             * @return The generated data.
+             */
+            static std::shared_ptr<Data> generate(long size, Waveform waveform, int numberOfBands, float nyquist = Nyquist);
+
+            /**
+             * @return The sample data, can be shared with other wavetables.
              */
-            WaveTable(long size, Waveform waveform = Waveform::Sine, int numberOfBands = 1);
+            const std::shared_ptr<Data>& getData() const { return mData; }
             
             /**
              * Normalize the waveform so the "loudest" sample has amplitude 1.f
+             * Data that is shared with other wavetables is copied first.
              */
             void normalize();
             
@@ -49,19 +85,45 @@ namespace nap
              * @param frequency In case of a bandlimited waveform, this parameter determines which version of the waveform to read from.
               */
             inline SampleValue interpolate(double index, float frequency) const;
+
+            /**
+             * @param frequency The frequency the waveform is played back at.
+             * @return The version of the waveform data that is used for the given frequency in case of a bandlimited waveform.
+             */
+            const SampleBuffer& getBand(float frequency) const { return getBandData(getBandIndex(frequency)); }
+
+            /**
+             * @param frequency The frequency the waveform is played back at.
+             * @return Index of the band that is used for the given frequency. The lookup is a binary search over the band bottoms.
+             */
+            int getBandIndex(float frequency) const;
+
+            /**
+             * @param index Index of the band, as returned by @getBandIndex()
+             * @return The waveform data of the band.
+             */
+            const SampleBuffer& getBandData(int index) const { return mData->mBands.channels[index]; }
+
+            /**
+             * @return the number of bands
+             */
+            int getBandCount() const { return mData->mBandBottoms.size(); }
             
             /**
              * @return the size of the waveform buffer
              */
-            long getSize() const { return mData.getSize(); }
+            long getSize() const { return mData->mBands.getSize(); }
+
+            /**
+             * @return true if the size is a power of two. Only then the oscillator can wrap read positions with a bit mask and render whole blocks at once.
+             */
+            bool isPowerOfTwo() const;
 
         protected:
-			using BandLimitedData = MultiSampleBuffer;
-            BandLimitedData mData;
-			std::vector<int> mBandBottoms;
+            std::shared_ptr<Data> mData = std::make_shared<Data>();
         };
 
-        
+
         /**
          * Oscillator that generates an audio signal from a periodic waveform and a frequency
          */
@@ -69,6 +131,13 @@ namespace nap
         {
             RTTI_ENABLE(Node)
             
+        public:
+            /**
+             * Interpolation used to read between the samples of the wavetable.
+             * Cubic is smoother at low frequencies and with small tables, at roughly twice the cost of Linear.
+             */
+            enum class Interpolation { Linear, Cubic };
+
         public:
             OscillatorNode(NodeManager& manager);
 
@@ -103,6 +172,17 @@ namespace nap
              * @param aWave Safe pointer to WaveTable object.
              */
             void setWave(SafePtr<WaveTable> aWave);
+
+            /**
+             * Sets the interpolation used to read from the wavetable. Only applies to wavetables with a power of two size.
+             * @param interpolation Linear or cubic interpolation
+             */
+            void setInterpolation(Interpolation interpolation) { mInterpolation = interpolation; }
+
+            /**
+             * @return The interpolation used to read from the wavetable.
+             */
+            Interpolation getInterpolation() const { return mInterpolation.load(); }
             
             InputPin fmInput = { this }; ///< Input pin to control frequency modulation.
             OutputPin output = { this }; ///< Audio output pin.
@@ -110,6 +190,16 @@ namespace nap
         private:
             void process() override;
             void sampleRateChanged(float sampleRate) override;
+            void bufferSizeChanged(int size) override;
+
+            // Renders the output per sample, used for wavetables that are not a power of two in size.
+            void processPerSample(SampleBuffer& outputBuffer, SampleBuffer* fmInputBuffer);
+
+            // Returns the band of the current wave for the given frequency, the lookup is only done when the frequency or the wave changed.
+            const SampleBuffer& selectBand(float frequency);
+
+            // While the frequency ramps the band is reselected every RampSegmentSize samples.
+            static constexpr int RampSegmentSize = 16;
 
             SafePtr<WaveTable> mWave = nullptr;
 
@@ -120,6 +210,15 @@ namespace nap
             std::atomic<ControllerValue> mPhaseOffset = { 0 };
             
             ControllerValue mPhase = 0;
+
+            SampleBuffer mPhaseBuffer; // Per sample read positions in the wavetable, input for the wavetable kernel
+            SampleBuffer mAmplitudeBuffer; // Per sample amplitudes, input for the wavetable kernel
+
+            std::atomic<Interpolation> mInterpolation = { Interpolation::Linear };
+
+            const WaveTable* mBandWave = nullptr; // The wave the cached band belongs to
+            float mBandFrequency = 0.f; // The frequency the cached band was selected for
+            const SampleBuffer* mBand = nullptr; // The cached band
         };
     }
 }
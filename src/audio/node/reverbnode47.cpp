@@ -39,7 +39,7 @@ namespace nap
         namespace verb47
         {
 
-            ReverbNode::ReverbNode(NodeManager& nodeManager) : Node(nodeManager)
+            ReverbNode::ReverbNode(NodeManager& nodeManager) : Node(nodeManager), mDelayMemory(DelayMemory::get(nodeManager))
             {
                 sampleRateChanged(nodeManager.getSampleRate());
             }
@@ -110,17 +110,17 @@ namespace nap
                 for (auto i = 0; i < mInputAllPasses.size(); ++i)
                 {
                     auto delay = maxSettings.mInputAllPassDelays[i] * mSamplesPerMillisecond;
-                    mInputAllPasses[i].reset(delay);
+                    mInputAllPasses[i].reset(*mDelayMemory, delay);
                 }
 
                 for (auto i = 0; i < mSizeAllPasses.size(); ++i)
-                    mSizeAllPasses[i].reset(200 * mSamplesPerMillisecond);
+                    mSizeAllPasses[i].reset(*mDelayMemory, 200 * mSamplesPerMillisecond);
 
-                mDelays[0].reset(2000.f * mSamplesPerMillisecond);
-                mDelays[1].reset(1000.f * mSamplesPerMillisecond);
+                mDelays[0].reset(*mDelayMemory, 2000.f * mSamplesPerMillisecond);
+                mDelays[1].reset(*mDelayMemory, 1000.f * mSamplesPerMillisecond);
 
                 for (auto i = 0; i < mDiffusors.size(); ++i)
-                    mDiffusors[i].reset(maxSettings.mDiffusorDelayMultipliers[i] * mSamplesPerMillisecond);
+                    mDiffusors[i].reset(*mDelayMemory, maxSettings.mDiffusorDelayMultipliers[i] * mSamplesPerMillisecond);
 
                 mFeedbackInput = 0.f;
 
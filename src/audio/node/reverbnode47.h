@@ -151,6 +151,7 @@ namespace nap
                 OnePoleLowPass<SampleValue> mInputHighCutOnePole;
                 OnePoleHighPass<SampleValue> mInputLowCutOnePole;
                 OnePoleLowPass<SampleValue> mDampingOnePole;
+                std::shared_ptr<DelayMemory> mDelayMemory = nullptr;
                 std::array<AllPass, 4> mInputAllPasses;
                 std::array<AllPass, 2> mSizeAllPasses;
                 std::array<SingleDelay, 2> mDelays;
@@ -0,0 +1,165 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "sampleloopernode.h"
+
+// Std includes
+#include <algorithm>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::SampleLooperNode)
+	RTTI_FUNCTION("stop", &nap::audio::SampleLooperNode::stop)
+	RTTI_FUNCTION("setSpeed", &nap::audio::SampleLooperNode::setSpeed)
+	RTTI_FUNCTION("setQuality", &nap::audio::SampleLooperNode::setQuality)
+	RTTI_FUNCTION("isPlaying", &nap::audio::SampleLooperNode::isPlaying)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		SampleLooperNode::SampleLooperNode(NodeManager& nodeManager, int channelCount) : Node(nodeManager)
+		{
+			for (auto channel = 0; channel < channelCount; ++channel)
+				mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+			mScratch.resize(PolyphaseResampler::ScratchSize);
+		}
+
+
+		void SampleLooperNode::play(SafePtr<MultiSampleBuffer> buffer, const SampleLoop& loop, ControllerValue speed)
+		{
+			mPlaying = buffer != nullptr;
+			speed = std::max(speed, 0.f);
+			getNodeManager().enqueueTask([&, buffer, loop, speed](){
+				mBuffer = buffer;
+				mCompressedBuffer = nullptr;
+				mLoop = loop;
+				mLength = buffer != nullptr ? loop.getLength(buffer->getSize()) : 0;
+				mPosition = 0.;
+				mSpeed = speed;
+				mPlaying = buffer != nullptr;
+			});
+		}
+
+
+		void SampleLooperNode::play(SafePtr<CompressedSampleBuffer> buffer, const SampleLoop& loop, ControllerValue speed)
+		{
+			mPlaying = buffer != nullptr;
+			speed = std::max(speed, 0.f);
+			getNodeManager().enqueueTask([&, buffer, loop, speed](){
+				mBuffer = nullptr;
+				mCompressedBuffer = buffer;
+				mLoop = loop;
+				mLength = buffer != nullptr ? loop.getLength(buffer->getSize()) : 0;
+				mPosition = 0.;
+				mSpeed = speed;
+				mPlaying = buffer != nullptr;
+			});
+		}
+
+
+		void SampleLooperNode::stop()
+		{
+			getNodeManager().enqueueTask([&](){
+				mBuffer = nullptr;
+				mCompressedBuffer = nullptr;
+				mPlaying = false;
+			});
+		}
+
+
+		void SampleLooperNode::setSpeed(ControllerValue speed)
+		{
+			speed = std::max(speed, 0.f);
+			getNodeManager().enqueueTask([&, speed](){
+				mSpeed = speed;
+			});
+		}
+
+
+		void SampleLooperNode::setQuality(PolyphaseResampler::Quality quality)
+		{
+			mQuality = quality;
+			PolyphaseResampler resampler(quality);
+			getNodeManager().enqueueTask([&, resampler](){
+				mResampler = resampler;
+			});
+		}
+
+
+		void SampleLooperNode::process()
+		{
+			// Reads a channel of a buffer of floats
+			struct Source
+			{
+				const SampleBuffer& mSamples;
+				void read(int64_t first, int count, float* destination) const
+				{
+					// Frames before the start and after the end are silent
+					auto range = clampFrames(first, count, mSamples.size(), destination);
+					std::copy(mSamples.data() + first + range.mBegin, mSamples.data() + first + range.mEnd, destination + range.mBegin);
+				}
+				float getSample(DiscreteTimeValue frame) const { return mSamples[frame]; }
+			};
+
+			// Reads a channel of a compressed buffer, blocks are decoded by the SIMD kernels of the buffer
+			struct CompressedSource
+			{
+				const CompressedSampleBuffer& mBuffer;
+				int mChannel;
+				void read(int64_t first, int count, float* destination) const { mBuffer.read(mChannel, first, count, destination); }
+				float getSample(DiscreteTimeValue frame) const { return mBuffer.getSample(mChannel, frame); }
+			};
+
+			if (auto buffer = mBuffer.get())
+				render(buffer->getSize(), buffer->getChannelCount(), [buffer](int channel) { return Source { (*buffer)[channel] }; });
+			else if (auto buffer = mCompressedBuffer.get())
+				render(buffer->getSize(), buffer->getChannelCount(), [buffer](int channel) { return CompressedSource { *buffer, channel }; });
+			else {
+				for (auto& output : mOutputs)
+				{
+					auto& outputBuffer = getOutputBuffer(*output);
+					std::fill(outputBuffer.begin(), outputBuffer.end(), 0.f);
+				}
+			}
+		}
+
+
+		template <typename MakeSource>
+		void SampleLooperNode::render(DiscreteTimeValue size, int channelCount, const MakeSource& makeSource)
+		{
+			// The section is unrolled, including its crossfades, while the resampler reads it
+			const auto& loop = mLoop;
+			const double speed = mSpeed;
+			for (auto channel = 0; channel < getChannelCount(); ++channel)
+			{
+				auto& outputBuffer = getOutputBuffer(*mOutputs[channel]);
+				if (channel >= channelCount)
+				{
+					std::fill(outputBuffer.begin(), outputBuffer.end(), 0.f);
+					continue;
+				}
+
+				auto source = makeSource(channel);
+				auto reader = [&source, &loop, size](float* destination, int64_t first, int count) { loop.read(source, size, first, count, destination); };
+				mResampler.process(reader, mPosition, speed, outputBuffer.data(), outputBuffer.size(), mScratch.data());
+			}
+			mPosition += speed * getBufferSize();
+
+			// A section that does not loop ends once the resampler has read past the end of the buffer
+			if (mLength != SampleLoop::Endless && mPosition >= double(mLength) + mResampler.getPadding(speed))
+			{
+				mBuffer = nullptr;
+				mCompressedBuffer = nullptr;
+				mPlaying = false;
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,124 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/compressedsamplebuffer.h>
+#include <audio/utility/polyphaseresampler.h>
+#include <audio/utility/safeptr.h>
+#include <audio/utility/sampleloop.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Plays a @SampleLoop of a multichannel buffer as a single node: the start, the loop points and the equal power crossfade of the loop are
+		 * rendered internally and sample accurately, so a looping sampler voice needs no nested voices, envelopes or control thread callbacks.
+		 * The buffer is either a @MultiSampleBuffer or a @CompressedSampleBuffer, which is decoded while it is read.
+		 * Every channel of the node has its own output pin, the playback speed is resampled by a @PolyphaseResampler.
+		 */
+		class NAPAPI SampleLooperNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * Constructor
+			 * @param nodeManager The node manager this node is processed on.
+			 * @param channelCount Number of output channels
+			 */
+			SampleLooperNode(NodeManager& nodeManager, int channelCount = 1);
+
+			/**
+			 * Starts playing a section of a buffer, stopping what was playing before.
+			 * Channels of the node beyond the channels of the buffer are silent.
+			 * @param buffer The buffer
+			 * @param loop The section of the buffer, in frames.
+			 * @param speed Frames of the buffer per output sample, 1 plays the buffer at the sample rate of the node. Negative speeds are clamped to 0, see setSpeed().
+			 */
+			void play(SafePtr<MultiSampleBuffer> buffer, const SampleLoop& loop, ControllerValue speed = 1.f);
+
+			/**
+			 * Starts playing a section of a buffer of 16 or 24 bit samples, stopping what was playing before.
+			 * Channels of the node beyond the channels of the buffer are silent.
+			 * @param buffer The buffer
+			 * @param loop The section of the buffer, in frames.
+			 * @param speed Frames of the buffer per output sample, 1 plays the buffer at the sample rate of the node. Negative speeds are clamped to 0, see setSpeed().
+			 */
+			void play(SafePtr<CompressedSampleBuffer> buffer, const SampleLoop& loop, ControllerValue speed = 1.f);
+
+			/**
+			 * Stops playback
+			 */
+			void stop();
+
+			/**
+			 * Sections are only played forwards: negative speeds are clamped to 0, which holds playback at its current frame.
+			 * A held section that does not loop never reaches its end, so it keeps playing until the speed is raised or it is stopped.
+			 * @param speed Frames of the buffer per output sample, a section keeps its loop points while the speed changes.
+			 */
+			void setSpeed(ControllerValue speed);
+
+			/**
+			 * @return Whether a section is playing, a section that does not loop stops at the end of the buffer.
+			 */
+			bool isPlaying() const { return mPlaying.load(); }
+
+			/**
+			 * @param quality Quality of the resampling
+			 */
+			void setQuality(PolyphaseResampler::Quality quality);
+
+			/**
+			 * @return Quality of the resampling
+			 */
+			PolyphaseResampler::Quality getQuality() const { return mQuality.load(); }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The output pin of the channel
+			 */
+			OutputPin& getOutput(int channel) { return *mOutputs[channel]; }
+
+			/**
+			 * @return Number of output channels
+			 */
+			int getChannelCount() const { return mOutputs.size(); }
+
+		private:
+			void process() override;
+
+			// Renders the section from the channels of the buffer that is playing, makeSource returns the reader of a channel
+			template <typename MakeSource>
+			void render(DiscreteTimeValue size, int channelCount, const MakeSource& makeSource);
+
+			std::vector<std::unique_ptr<OutputPin>> mOutputs;
+
+			// Audio thread, at most one of the buffers is set
+			SafePtr<MultiSampleBuffer> mBuffer = nullptr;
+			SafePtr<CompressedSampleBuffer> mCompressedBuffer = nullptr;
+			SampleLoop mLoop;
+			DiscreteTimeValue mLength = 0;
+			double mPosition = 0.;          // Fractional frame position relative to the start of the section
+			ControllerValue mSpeed = 1.f;
+			PolyphaseResampler mResampler;
+			std::vector<float> mScratch;
+
+			std::atomic<PolyphaseResampler::Quality> mQuality = { PolyphaseResampler::Quality::Medium };
+			std::atomic<bool> mPlaying = { false };
+		};
+
+	}
+
+}
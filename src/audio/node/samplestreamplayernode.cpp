@@ -0,0 +1,171 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "samplestreamplayernode.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		SampleStreamPlayerNode::SampleStreamPlayerNode(NodeManager& nodeManager, int channelCount, TimeValue readAhead, ControllerValue maxSpeed) :
+			Node(nodeManager), mMaxSpeed(std::max(maxSpeed, 0.f))
+		{
+			for (auto channel = 0; channel < channelCount; ++channel)
+				mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+			mScratch.resize(PolyphaseResampler::ScratchSize);
+
+			// The stream is allocated up front, so starting a voice never allocates
+			mService = StreamingService::get(nodeManager);
+			auto frames = StreamingService::getReadAhead(readAhead, mMaxSpeed, nodeManager.getSampleRate());
+			mStream = mService->createStream<SampleStream>(channelCount, frames);
+		}
+
+
+		void SampleStreamPlayerNode::play(const SampleStream::Region& region, SafePtr<MultiSampleBuffer> preload, ControllerValue speed)
+		{
+			auto id = ++mPlayCount;
+			speed = std::min(std::max(speed, 0.f), mMaxSpeed);
+			getNodeManager().enqueueTask([&, region, preload, speed, id](){
+				mRegion = region;
+				mPreloadBuffer = preload;
+				mLength = SampleStream::getLength(region);
+				mPreload = std::min<DiscreteTimeValue>(preload != nullptr ? preload->getSize() : 0, SampleStream::getLinearLength(region));
+				mPosition = 0.;
+				mSpeed = region.mBuffer != nullptr ? double(speed) * region.mBuffer->getSampleRate() / getNodeManager().getSampleRate() : 0.;
+				mFadeLength = 0;
+				mFadeRemaining = 0;
+				mActive = region.mBuffer != nullptr;
+				mActiveId = id;
+				mPlaying = mActive;
+				mStream->play(region, mPreload);
+			});
+		}
+
+
+		void SampleStreamPlayerNode::stop()
+		{
+			mStopCount = mPlayCount.load();
+		}
+
+
+		void SampleStreamPlayerNode::setQuality(PolyphaseResampler::Quality quality)
+		{
+			mQuality = quality;
+			PolyphaseResampler resampler(quality);
+			getNodeManager().enqueueTask([&, resampler](){
+				mResampler = resampler;
+			});
+		}
+
+
+		void SampleStreamPlayerNode::halt()
+		{
+			mActive = false;
+			mPlaying = false;
+			mFadeLength = 0;
+			mFadeRemaining = 0;
+			mPreloadBuffer = nullptr;
+			mStream->stop();
+		}
+
+
+		void SampleStreamPlayerNode::process()
+		{
+			auto bufferSize = getBufferSize();
+			if (mActive && mStopCount.load() >= mActiveId)
+				halt();
+
+			auto i = 0;
+			if (mActive)
+			{
+				auto stream = mStream.get();
+				auto speed = mSpeed;
+				auto padding = mResampler.getPadding(speed);
+
+				// At the end of a region everything can be read, the frames after it are silent
+				DiscreteTimeValue written = stream->getWritten();
+				bool ending = mLength != SampleStream::Endless && (written >= mLength || stream->isEndReached());
+
+				// Start fading out while the stream still holds the frames the fade needs
+				i = bufferSize;
+				if (!ending && mFadeLength == 0)
+				{
+					auto fadeSamples = int(FadeTime * getNodeManager().getSampleRate() / 1000.f);
+					auto limit = double(written) - padding - 1 - mPosition;
+					auto renderable = limit <= 0. ? 0 : speed > 0. ? int(std::min<double>(std::ceil(limit / speed), bufferSize + fadeSamples)) : bufferSize + fadeSamples;
+					if (renderable < bufferSize + fadeSamples)
+					{
+						mFadeLength = std::max(std::min(renderable, fadeSamples), 1);
+						mFadeRemaining = std::min(renderable, fadeSamples);
+						stream->reportUnderrun();
+					}
+				}
+				if (mFadeLength > 0)
+					i = std::min(bufferSize, mFadeRemaining);
+
+				// The preload is read from its copy in memory, the rest from the stream
+				const auto preloadBuffer = mPreloadBuffer.get();
+				const auto preload = mPreload;
+				for (auto channel = 0; channel < getChannelCount(); ++channel)
+				{
+					auto reader = [stream, preloadBuffer, preload, written, channel](float* destination, int64_t first, int count)
+					{
+						auto j = 0;
+						if (first < int64_t(preload))
+						{
+							j = int(std::min<int64_t>(count, int64_t(preload) - first));
+							if (channel < preloadBuffer->getChannelCount())
+							{
+								auto& samples = (*preloadBuffer)[channel];
+								auto range = clampFrames(first, j, samples.size(), destination);
+								std::copy(samples.data() + first + range.mBegin, samples.data() + first + range.mEnd, destination + range.mBegin);
+							}
+							else
+								std::fill(destination, destination + j, 0.f);
+						}
+						for (; j < count; ++j)
+						{
+							DiscreteTimeValue frame = first + j;
+							destination[j] = frame < written && channel < stream->getChannelCount() ? stream->getSample(frame, channel) : 0.f;
+						}
+					};
+					auto output = getOutputBuffer(*mOutputs[channel]).data();
+					mResampler.process(reader, mPosition, speed, output, i, mScratch.data());
+
+					if (mFadeLength > 0)
+						for (auto k = 0; k < i; ++k)
+							output[k] *= float(mFadeRemaining - k) / mFadeLength;
+				}
+				mPosition += speed * i;
+
+				auto consumed = int64_t(mPosition) - mResampler.getMaxPadding();
+				if (consumed > 0)
+					stream->consume(consumed);
+				stream->setConsumptionRate(speed * getNodeManager().getSampleRate());
+
+				if (mFadeLength > 0)
+				{
+					mFadeRemaining -= i;
+					if (mFadeRemaining <= 0)
+						halt();
+				}
+				else if (ending && mPosition >= double(mLength) + padding)
+					halt();
+			}
+
+			for (auto channel = 0; channel < getChannelCount(); ++channel)
+			{
+				auto& outputBuffer = getOutputBuffer(*mOutputs[channel]);
+				std::fill(outputBuffer.begin() + i, outputBuffer.end(), 0.f);
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,127 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/service/samplestream.h>
+#include <audio/service/streamingservice.h>
+#include <audio/utility/polyphaseresampler.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Plays regions of @MappedSampleBuffer objects as a sampler voice, streaming them instead of reading them from memory.
+		 * The start of a region, the preload, is played from a copy in memory while the stream fills, see MappedSampleResource::preload().
+		 * The frames after the preload are filled by the I/O threads of the @StreamingService into a stream slot that every node owns.
+		 * When the I/O threads can not keep up, the voice fades out over FadeTime instead of playing frames that have not been read yet.
+		 * Every channel of the buffer has its own output pin, the speed and sample rate differences are resampled by a @PolyphaseResampler.
+		 */
+		class NAPAPI SampleStreamPlayerNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			static constexpr TimeValue FadeTime = 5.f; ///< Time in ms of the fade out when the stream runs dry.
+
+			/**
+			 * Constructor
+			 * @param nodeManager The node manager this node is processed on.
+			 * @param channelCount Number of output channels
+			 * @param readAhead Time in ms that is streamed ahead of the playback position to cover the latency of the disk.
+			 * @param maxSpeed Maximum playback speed, the read ahead is scaled by it.
+			 */
+			SampleStreamPlayerNode(NodeManager& nodeManager, int channelCount = 1, TimeValue readAhead = 500.f, ControllerValue maxSpeed = 2.f);
+
+			/**
+			 * Starts playing a region, stopping what was playing before.
+			 * This method and stop() can be called from any thread.
+			 * @param region The region. Its buffer has to stay alive until playback has stopped.
+			 * @param preload Copy of the first frames of every channel of the region, see MappedSampleResource::preload(). They play from memory while the stream fills,
+			 * so they should cover the time the I/O threads need. Frames before the start of the region are silent.
+			 * @param speed Playback speed, 1 plays the buffer at its own sample rate. Clamped between 0 and the maximum speed.
+			 */
+			void play(const SampleStream::Region& region, SafePtr<MultiSampleBuffer> preload, ControllerValue speed = 1.f);
+
+			/**
+			 * Stops playing at the start of the next buffer.
+			 */
+			void stop();
+
+			/**
+			 * @return Whether a region is playing, it stops at its end unless it loops.
+			 */
+			bool isPlaying() const { return mPlaying.load(); }
+
+			/**
+			 * @param quality Quality of the resampling
+			 */
+			void setQuality(PolyphaseResampler::Quality quality);
+
+			/**
+			 * @return Quality of the resampling
+			 */
+			PolyphaseResampler::Quality getQuality() const { return mQuality.load(); }
+
+			/**
+			 * @return The number of times playback faded out because the stream ran dry.
+			 */
+			int getUnderrunCount() const { return mStream->getUnderrunCount(); }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The output pin of the channel
+			 */
+			OutputPin& getOutput(int channel) { return *mOutputs[channel]; }
+
+			/**
+			 * @return Number of output channels
+			 */
+			int getChannelCount() const { return mOutputs.size(); }
+
+		private:
+			void process() override;
+
+			// Stops playback and streaming, audio thread
+			void halt();
+
+			std::vector<std::unique_ptr<OutputPin>> mOutputs;
+			std::shared_ptr<StreamingService> mService = nullptr; // Declared before the stream, so it is released before the threads of the service are joined
+			std::shared_ptr<SampleStream> mStream = nullptr;
+			ControllerValue mMaxSpeed = 2.f;
+
+			// Audio thread
+			SampleStream::Region mRegion;
+			SafePtr<MultiSampleBuffer> mPreloadBuffer = nullptr;
+			DiscreteTimeValue mPreload = 0;     // Number of frames played from the preload buffer
+			DiscreteTimeValue mLength = 0;
+			double mPosition = 0.;      // Fractional frame position relative to the start of the region
+			double mSpeed = 1.;         // Frames of the region per output sample
+			bool mActive = false;
+			uint64_t mActiveId = 0;     // Number of the play() call that is playing
+			int mFadeLength = 0;        // Length of the fade out that is in progress, 0 when not fading
+			int mFadeRemaining = 0;
+			PolyphaseResampler mResampler;
+			std::vector<float> mScratch;
+
+			std::atomic<PolyphaseResampler::Quality> mQuality = { PolyphaseResampler::Quality::Medium };
+			std::atomic<bool> mPlaying = { false };
+			std::atomic<uint64_t> mPlayCount = { 0 }; // Number of play() calls
+			std::atomic<uint64_t> mStopCount = { 0 }; // Number of the last play() call that has been stopped
+		};
+
+	}
+
+}
@@ -0,0 +1,122 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "stringbanknode.h"
+
+// Std includes
+#include <cmath>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::StringBankNode)
+	RTTI_PROPERTY("audioInput", &nap::audio::StringBankNode::audioInput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_PROPERTY("audioOutput", &nap::audio::StringBankNode::audioOutput, nap::rtti::EPropertyMetaData::Embedded)
+	RTTI_FUNCTION("setFrequency", &nap::audio::StringBankNode::setFrequency)
+	RTTI_FUNCTION("setDamping", &nap::audio::StringBankNode::setDamping)
+	RTTI_FUNCTION("setFeedback", &nap::audio::StringBankNode::setFeedback)
+	RTTI_FUNCTION("pluck", &nap::audio::StringBankNode::pluck)
+	RTTI_FUNCTION("getStringCount", &nap::audio::StringBankNode::getStringCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		static constexpr int StringsPerBank = KarplusStrongBank<float8>::LaneCount;
+
+
+		StringBankNode::StringBankNode(NodeManager& nodeManager, int stringCount, ControllerValue lowestFrequency) :
+			Node(nodeManager), mDelayMemory(DelayMemory::get(nodeManager)), mLowestFrequency(std::max(lowestFrequency, 1.f)), mStrings(std::max(stringCount, 1))
+		{
+			mAppliedStrings.resize(mStrings.size());
+			mBanks.resize((mStrings.size() + StringsPerBank - 1) / StringsPerBank);
+			sampleRateChanged(nodeManager.getSampleRate());
+			bufferSizeChanged(getBufferSize());
+		}
+
+
+		void StringBankNode::pluck(int string, ControllerValue amplitude, ControllerValue brightness)
+		{
+			mStrings[string].mPluckBrightness = brightness;
+			mStrings[string].mPluckAmplitude.store(std::max(amplitude, 1e-6f), std::memory_order_release);
+		}
+
+
+		void StringBankNode::process()
+		{
+			auto inputBuffer = audioInput.pull();
+			auto& outputBuffer = getOutputBuffer(audioOutput);
+			const auto sampleRate = getNodeManager().getSampleRate();
+			const int count = outputBuffer.size();
+
+			// Apply changed parameters and pending plucks
+			for (auto string = 0; string < mStrings.size(); ++string)
+			{
+				auto& bank = mBanks[string / StringsPerBank];
+				auto lane = string % StringsPerBank;
+				auto& parameters = mStrings[string];
+				auto& applied = mAppliedStrings[string];
+
+				auto frequency = std::max(parameters.mFrequency.load(), mLowestFrequency);
+				if (frequency != applied.mFrequency)
+				{
+					bank.setDelayTime(lane, sampleRate / frequency);
+					applied.mFrequency = frequency;
+				}
+				auto damping = parameters.mDamping.load();
+				if (damping != applied.mDamping)
+				{
+					bank.setDamping(lane, damping, sampleRate);
+					applied.mDamping = damping;
+				}
+				auto feedback = parameters.mFeedback.load();
+				if (feedback != applied.mFeedback)
+				{
+					bank.setFeedback(lane, feedback);
+					applied.mFeedback = feedback;
+				}
+
+				auto amplitude = parameters.mPluckAmplitude.exchange(0.f, std::memory_order_acquire);
+				if (amplitude > 0.f)
+					bank.pluck(lane, amplitude, parameters.mPluckBrightness.load());
+			}
+
+			auto input = inputBuffer != nullptr ? inputBuffer->data() : nullptr;
+			std::fill(outputBuffer.begin(), outputBuffer.end(), 0.f);
+			for (auto& bank : mBanks)
+			{
+				bank.process(input, mBankBuffer.data(), count);
+				for (auto i = 0; i < count; ++i)
+					outputBuffer[i] += mBankBuffer[i];
+			}
+
+			for (auto i = 0; i < count; ++i)
+				outputBuffer[i] = mLowCut.process(outputBuffer[i]);
+		}
+
+
+		void StringBankNode::sampleRateChanged(float sampleRate)
+		{
+			int maxDelay = std::ceil(sampleRate / mLowestFrequency);
+			for (auto& bank : mBanks)
+				bank.reset(*mDelayMemory, maxDelay);
+
+			// Delay times and damping coefficients depend on the sample rate, apply them again
+			for (auto& applied : mAppliedStrings)
+				applied = AppliedString();
+			mLowCut.setCutoffFrequency(20.f, sampleRate);
+		}
+
+
+		void StringBankNode::bufferSizeChanged(int size)
+		{
+			mBankBuffer.resize(size);
+		}
+
+	}
+
+}
@@ -0,0 +1,110 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/utility/karplusstrongbank.h>
+#include <audio/utility/onepole.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Bank of plucked strings using the Karplus Strong algorithm, 8 strings per @KarplusStrongBank in the lanes of a float8.
+		 * Every string has its own frequency, damping and feedback and can be plucked without an external excitation signal.
+		 * The input signal, when connected, excites all strings. The output is the sum of all strings.
+		 * All setters and pluck() are lock free and can be called from any thread, they take effect at the start of the next buffer.
+		 */
+		class NAPAPI StringBankNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			/**
+			 * Constructor
+			 * @param nodeManager The node manager this node is processed on.
+			 * @param stringCount Number of strings.
+			 * @param lowestFrequency The lowest frequency in Hz the strings can be tuned to, this sizes the delay lines.
+			 */
+			StringBankNode(NodeManager& nodeManager, int stringCount = 8, ControllerValue lowestFrequency = 20.f);
+
+			InputPin audioInput = { this };       ///< Optional excitation signal for all strings.
+			OutputPin audioOutput = { this };     ///< The sum of all strings.
+
+			/**
+			 * @param string Index of the string
+			 * @param frequency Frequency in Hz, clamped to the lowest frequency.
+			 */
+			void setFrequency(int string, ControllerValue frequency) { mStrings[string].mFrequency = frequency; }
+
+			/**
+			 * @param string Index of the string
+			 * @param cutoffFrequency Cutoff frequency in Hz of the lowpass filter in the feedback loop.
+			 */
+			void setDamping(int string, ControllerValue cutoffFrequency) { mStrings[string].mDamping = cutoffFrequency; }
+
+			/**
+			 * @param string Index of the string
+			 * @param feedback Gain of the feedback loop, smaller than 1.
+			 */
+			void setFeedback(int string, ControllerValue feedback) { mStrings[string].mFeedback = feedback; }
+
+			/**
+			 * Plucks a string at the start of the next buffer with a burst of noise.
+			 * @param string Index of the string
+			 * @param amplitude Amplitude of the burst
+			 * @param brightness Between 0 and 1, the cutoff of the lowpass filter on the burst as a fraction of the Nyquist frequency.
+			 */
+			void pluck(int string, ControllerValue amplitude, ControllerValue brightness = 1.f);
+
+			/**
+			 * @return Number of strings
+			 */
+			int getStringCount() const { return mStrings.size(); }
+
+		private:
+			// Parameters of a string, written by the control thread
+			struct String
+			{
+				std::atomic<ControllerValue> mFrequency = { 440.f };
+				std::atomic<ControllerValue> mDamping = { 5000.f };
+				std::atomic<ControllerValue> mFeedback = { 0.99f };
+				std::atomic<ControllerValue> mPluckBrightness = { 1.f };
+				std::atomic<ControllerValue> mPluckAmplitude = { 0.f }; // Larger than 0 when a pluck is pending
+			};
+
+			// Parameters of a string as last applied to its bank
+			struct AppliedString
+			{
+				ControllerValue mFrequency = 0.f;
+				ControllerValue mDamping = 0.f;
+				ControllerValue mFeedback = 0.f;
+			};
+
+			void process() override;
+			void sampleRateChanged(float sampleRate) override;
+			void bufferSizeChanged(int size) override;
+
+			std::shared_ptr<DelayMemory> mDelayMemory = nullptr;
+			ControllerValue mLowestFrequency = 20.f;
+			std::vector<String> mStrings;
+			std::vector<AppliedString> mAppliedStrings;
+			std::vector<KarplusStrongBank<float8>> mBanks;
+			SampleBuffer mBankBuffer;
+			OnePoleHighPass<SampleValue> mLowCut;
+		};
+
+	}
+
+}
@@ -0,0 +1,227 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "unisonoscillatornode.h"
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/audiofunctions.h>
+#include <audio/utility/simddispatch.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::UnisonOscillatorNode)
+	RTTI_FUNCTION("setFrequency", &nap::audio::UnisonOscillatorNode::setFrequency)
+	RTTI_FUNCTION("setAmplitude", &nap::audio::UnisonOscillatorNode::setAmplitude)
+	RTTI_FUNCTION("setVoiceCount", &nap::audio::UnisonOscillatorNode::setVoiceCount)
+	RTTI_FUNCTION("setDetune", &nap::audio::UnisonOscillatorNode::setDetune)
+	RTTI_FUNCTION("setSpread", &nap::audio::UnisonOscillatorNode::setSpread)
+	RTTI_FUNCTION("setStereoWidth", &nap::audio::UnisonOscillatorNode::setStereoWidth)
+	RTTI_PROPERTY("fmInput", &nap::audio::UnisonOscillatorNode::fmInput, nap::rtti::EPropertyMetaData::Embedded)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		UnisonOscillatorNode::UnisonOscillatorNode(NodeManager& manager, int channelCount) : Node(manager)
+		{
+			channelCount = std::max(channelCount, 1);
+			for (auto channel = 0; channel < channelCount; ++channel)
+				mOutputs.emplace_back(std::make_unique<OutputPin>(this));
+			mOutputBuffers.resize(channelCount, nullptr);
+			mGains.resize(channelCount, float16(0.f));
+
+			// Spread the start phases of the voices with the golden ratio, so they do not start out in phase
+			float phases[MaxVoiceCount];
+			for (auto voice = 0; voice < MaxVoiceCount; ++voice)
+			{
+				auto phase = voice * 0.618034f;
+				phases[voice] = phase - std::floor(phase);
+			}
+			mPhase = float16(phases);
+			mRatio = float16(1.f);
+
+			mAmplitude.setStepCount(getNodeManager().getSamplesPerMillisecond());
+			sampleRateChanged(getNodeManager().getSampleRate());
+			bufferSizeChanged(getBufferSize());
+			mVoicesDirty.set();
+		}
+
+
+		void UnisonOscillatorNode::setWave(SafePtr<WaveTable> wave)
+		{
+			mWave = wave;
+		}
+
+
+		void UnisonOscillatorNode::setFrequency(ControllerValue frequency, TimeValue rampTime)
+		{
+			if (rampTime == 0.f)
+				mFrequency.setValue(frequency);
+			else
+				mFrequency.ramp(frequency, rampTime * getNodeManager().getSamplesPerMillisecond(), RampMode::Exponential);
+		}
+
+
+		void UnisonOscillatorNode::setAmplitude(ControllerValue amplitude, TimeValue rampTime)
+		{
+			mAmplitude.setValue(amplitude);
+		}
+
+
+		void UnisonOscillatorNode::setVoiceCount(int count)
+		{
+			mVoiceCount = std::min(std::max(count, 1), MaxVoiceCount);
+			mVoicesDirty.set();
+		}
+
+
+		void UnisonOscillatorNode::setDetune(ControllerValue semitones)
+		{
+			mDetune = semitones;
+			mVoicesDirty.set();
+		}
+
+
+		void UnisonOscillatorNode::setSpread(ControllerValue spread)
+		{
+			mSpread = std::min(std::max(spread, 0.f), 1.f);
+			mVoicesDirty.set();
+		}
+
+
+		void UnisonOscillatorNode::setStereoWidth(ControllerValue width)
+		{
+			mStereoWidth = std::min(std::max(width, 0.f), 1.f);
+			mVoicesDirty.set();
+		}
+
+
+		void UnisonOscillatorNode::process()
+		{
+			SampleBuffer* fmInputBuffer = fmInput.pull();
+			for (auto channel = 0; channel < mOutputs.size(); ++channel)
+				mOutputBuffers[channel] = &getOutputBuffer(*mOutputs[channel]);
+
+			if (mWave == nullptr || !mWave->isPowerOfTwo())
+			{
+				for (auto outputBuffer : mOutputBuffers)
+					std::fill(outputBuffer->begin(), outputBuffer->end(), 0.f);
+				return;
+			}
+
+			if (mVoicesDirty.check())
+				updateVoices();
+
+			const auto bufferSize = getBufferSize();
+			const float16 waveSize(float(mWave->getSize()));
+
+			// Advance the phases of all voices at once and store the read positions interleaved
+			auto maxFrequency = 0.f;
+			for (auto i = 0; i < bufferSize; ++i)
+			{
+				auto frequency = mFrequency.getNextValue();
+				maxFrequency = std::max(maxFrequency, frequency);
+				auto increment = frequency * mInverseSampleRate;
+				if (fmInputBuffer)
+					increment *= (*fmInputBuffer)[i] + 1.f;
+				mPhase = mPhase + mRatio * increment;
+				mPhase = mPhase - floorVec(mPhase);
+				(mPhase * waveSize).store(mPositionBuffer.data() + i * MaxVoiceCount);
+			}
+
+			// One band for the whole buffer, selected for the highest voice frequency
+			auto& band = mWave->getBand(maxFrequency * mMaxRatio);
+			getSimdKernels().waveTable(band.data(), int(mWave->getSize() - 1), mPositionBuffer.data(), mUnityBuffer.data(), mValueBuffer.data(), bufferSize * MaxVoiceCount);
+
+			for (auto i = 0; i < bufferSize; ++i)
+			{
+				const float16 values(mValueBuffer.data() + i * MaxVoiceCount);
+				const auto amplitude = mAmplitude.getNextValue();
+				for (auto channel = 0; channel < mOutputBuffers.size(); ++channel)
+					(*mOutputBuffers[channel])[i] = sumVec(values * mGains[channel]) * amplitude;
+			}
+		}
+
+
+		void UnisonOscillatorNode::updateVoices()
+		{
+			const auto voiceCount = mVoiceCount.load();
+			const auto detune = mDetune.load();
+			const auto spread = mSpread.load();
+			const auto width = mStereoWidth.load();
+			const int channelCount = mOutputs.size();
+
+			// Voices are placed evenly between -1 (lowest) and 1 (highest)
+			float positions[MaxVoiceCount];
+			float ratios[MaxVoiceCount];
+			float weights[MaxVoiceCount];
+			auto power = 0.f;
+			mMaxRatio = 1.f;
+			for (auto voice = 0; voice < MaxVoiceCount; ++voice)
+			{
+				if (voice >= voiceCount)
+				{
+					positions[voice] = 0.f;
+					ratios[voice] = 1.f;
+					weights[voice] = 0.f;
+					continue;
+				}
+				positions[voice] = voiceCount > 1 ? 2.f * voice / (voiceCount - 1) - 1.f : 0.f;
+				ratios[voice] = std::pow(2.f, detune * positions[voice] / 12.f);
+				weights[voice] = 1.f - (1.f - spread) * std::abs(positions[voice]) * (voiceCount - 1) / voiceCount;
+				power += weights[voice] * weights[voice];
+				mMaxRatio = std::max(mMaxRatio, ratios[voice]);
+			}
+			mRatio = float16(ratios);
+
+			// Normalize to the loudness of a single voice, assuming the voices are uncorrelated
+			const auto normalize = power > 0.f ? 1.f / std::sqrt(power) : 0.f;
+			for (auto channel = 0; channel < channelCount; ++channel)
+			{
+				float gains[MaxVoiceCount] = { 0.f };
+				for (auto voice = 0; voice < voiceCount; ++voice)
+				{
+					const auto weight = weights[voice] * normalize;
+					if (channelCount == 1)
+					{
+						gains[voice] = weight;
+						continue;
+					}
+
+					// Equal power panning between the two outputs around the pan position
+					const auto pan = (0.5f + 0.5f * width * positions[voice]) * (channelCount - 1);
+					const auto left = std::min(int(pan), channelCount - 2);
+					const auto fraction = pan - left;
+					if (channel == left)
+						gains[voice] = weight * std::cos(fraction * math::PI * 0.5f);
+					else if (channel == left + 1)
+						gains[voice] = weight * std::sin(fraction * math::PI * 0.5f);
+				}
+				mGains[channel] = float16(gains);
+			}
+		}
+
+
+		void UnisonOscillatorNode::sampleRateChanged(float sampleRate)
+		{
+			mInverseSampleRate = sampleRate > 0.f ? 1.f / sampleRate : 0.f;
+		}
+
+
+		void UnisonOscillatorNode::bufferSizeChanged(int size)
+		{
+			mPositionBuffer.resize(size * MaxVoiceCount);
+			mValueBuffer.resize(size * MaxVoiceCount);
+			mUnityBuffer.assign(size * MaxVoiceCount, 1.f);
+		}
+
+	}
+
+}
@@ -0,0 +1,139 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+
+// Audio includes
+#include <audio/core/audionode.h>
+#include <audio/node/oscillatornode.h>
+#include <audio/utility/dirtyflag.h>
+#include <audio/utility/linearsmoothedvalue.h>
+#include <audio/utility/rampedvalue.h>
+#include <audio/utility/safeptr.h>
+#include <audio/utility/vectorextension.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Unison ("supersaw") oscillator: up to 16 detuned copies of one waveform, rendered by a single node.
+		 * The phase accumulators of all voices are kept in the lanes of a float16 vector and the table lookups of all voices run through one call to the wavetable kernel.
+		 * The voices are summed into one output, or panned across multiple outputs with equal power panning.
+		 */
+		class NAPAPI UnisonOscillatorNode : public Node
+		{
+			RTTI_ENABLE(Node)
+
+		public:
+			static constexpr int MaxVoiceCount = 16;
+
+			/**
+			 * Constructor
+			 * @param manager The node manager this node is processed on.
+			 * @param channelCount Number of outputs the voices are panned across.
+			 */
+			UnisonOscillatorNode(NodeManager& manager, int channelCount = 1);
+
+			/**
+			 * Set the waveform for the oscillator. Has to be called before usage.
+			 * @param wave Safe pointer to WaveTable object.
+			 */
+			void setWave(SafePtr<WaveTable> wave);
+
+			/**
+			 * Set the frequency of the center of the unison voices in Hz
+			 * @param frequency Frequency in Hz
+			 * @param rampTime Interpolation time in ms
+			 */
+			void setFrequency(ControllerValue frequency, TimeValue rampTime = 0);
+
+			/**
+			 * Set the amplitude of the summed voices
+			 * @param amplitude Amplitude multiplier
+			 * @param rampTime Interpolation time in ms
+			 */
+			void setAmplitude(ControllerValue amplitude, TimeValue rampTime = 0);
+
+			/**
+			 * Set the number of voices.
+			 * @param count Number of voices between 1 and MaxVoiceCount
+			 */
+			void setVoiceCount(int count);
+
+			/**
+			 * Set the detuning of the outermost voices, the other voices are spaced evenly in between.
+			 * @param semitones Detuning in semitones, up and down from the center frequency.
+			 */
+			void setDetune(ControllerValue semitones);
+
+			/**
+			 * Set the level of the detuned voices relative to the center. 0 fades the voices out towards the outermost ones, 1 gives all voices the same level.
+			 * The sum of the voices is normalized to a constant loudness.
+			 * @param spread Value between 0 and 1
+			 */
+			void setSpread(ControllerValue spread);
+
+			/**
+			 * Set how far the voices are panned apart across the outputs. 0 places all voices in the center, 1 places the outermost voices on the first and last output.
+			 * Has no effect with a single output.
+			 * @param width Value between 0 and 1
+			 */
+			void setStereoWidth(ControllerValue width);
+
+			/**
+			 * @return the number of outputs
+			 */
+			int getChannelCount() const { return mOutputs.size(); }
+
+			/**
+			 * @param channel Index of the output
+			 * @return the output pin for the given channel
+			 */
+			OutputPin& getOutput(int channel) { return *mOutputs[channel]; }
+
+			InputPin fmInput = { this }; ///< Input pin to control frequency modulation.
+
+		private:
+			void process() override;
+			void sampleRateChanged(float sampleRate) override;
+			void bufferSizeChanged(int size) override;
+
+			// Recomputes the detune ratios and the output gains of the voices from the current settings.
+			void updateVoices();
+
+			std::vector<std::unique_ptr<OutputPin>> mOutputs;
+			std::vector<SampleBuffer*> mOutputBuffers;
+
+			SafePtr<WaveTable> mWave = nullptr;
+
+			RampedValue<ControllerValue> mFrequency = { 440 };
+			LinearSmoothedValue<ControllerValue> mAmplitude = { 1.f, 44 };
+
+			std::atomic<int> mVoiceCount = { 7 };
+			std::atomic<ControllerValue> mDetune = { 0.2f };
+			std::atomic<ControllerValue> mSpread = { 0.5f };
+			std::atomic<ControllerValue> mStereoWidth = { 1.f };
+			DirtyFlag mVoicesDirty;
+
+			float16 mPhase; // Phase of every voice in cycles, between 0 and 1
+			float16 mRatio; // Frequency of every voice relative to the center frequency
+			std::vector<float16> mGains; // Gain of every voice on every output, 0 for unused voices
+			float mMaxRatio = 1.f; // Highest ratio in use, used to select the band of the wavetable
+			float mInverseSampleRate = 0.f;
+
+			SampleBuffer mPositionBuffer; // Read positions of all 16 lanes for every sample in the buffer, interleaved
+			SampleBuffer mValueBuffer; // Wavetable values of all 16 lanes for every sample in the buffer, interleaved
+			SampleBuffer mUnityBuffer; // Amplitudes for the wavetable kernel, all 1
+		};
+
+	}
+
+}
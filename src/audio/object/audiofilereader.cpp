@@ -6,7 +6,10 @@
 
 RTTI_BEGIN_CLASS(nap::audio::AudioFileReader)
     RTTI_PROPERTY("AudioFiles", &nap::audio::AudioFileReader::mAudioFiles, nap::rtti::EPropertyMetaData::Required)
-    RTTI_PROPERTY("BufferSize", &nap::audio::AudioFileReader::mBufferSize, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("ReadAhead", &nap::audio::AudioFileReader::mReadAhead, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("MaxSpeed", &nap::audio::AudioFileReader::mMaxSpeed, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("CueCount", &nap::audio::AudioFileReader::mCueCount, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("Quality", &nap::audio::AudioFileReader::mQuality, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::AudioFileReaderInstance)
@@ -15,6 +18,11 @@ RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::AudioFileReaderInstance)
     RTTI_FUNCTION("isPlaying", &nap::audio::AudioFileReaderInstance::isPlaying)
     RTTI_FUNCTION("setLooping", &nap::audio::AudioFileReaderInstance::setLooping)
     RTTI_FUNCTION("isLooping", &nap::audio::AudioFileReaderInstance::isLooping)
+    RTTI_FUNCTION("setSpeed", &nap::audio::AudioFileReaderInstance::setSpeed)
+    RTTI_FUNCTION("seek", &nap::audio::AudioFileReaderInstance::seek)
+    RTTI_FUNCTION("setCue", &nap::audio::AudioFileReaderInstance::setCue)
+    RTTI_FUNCTION("cue", &nap::audio::AudioFileReaderInstance::cue)
+    RTTI_FUNCTION("getUnderrunCount", &nap::audio::AudioFileReaderInstance::getUnderrunCount)
 RTTI_END_CLASS
 
 
@@ -27,7 +35,7 @@ namespace nap
         std::unique_ptr<AudioObjectInstance> AudioFileReader::createInstance(NodeManager &nodeManager, utility::ErrorState &errorState)
         {
             auto instance = std::make_unique<AudioFileReaderInstance>();
-            if (!instance->init(nodeManager, mAudioFiles, mBufferSize, errorState))
+            if (!instance->init(nodeManager, mAudioFiles, mReadAhead, mMaxSpeed, mCueCount, mQuality, errorState))
             {
                 errorState.fail("Failed to initialize AudioFileReaderInstance");
                 return nullptr;
@@ -37,24 +45,29 @@ namespace nap
         }
 
 
-        bool AudioFileReaderInstance::init(NodeManager &nodeManager, std::vector<ResourcePtr<AudioFileIO>>& audioFileReaders, int bufferSize, utility::ErrorState &errorState)
+        bool AudioFileReaderInstance::init(NodeManager &nodeManager, std::vector<ResourcePtr<AudioFileIO>>& audioFileReaders, TimeValue readAhead, ControllerValue maxSpeed, int cueCount, PolyphaseResampler::Quality quality, utility::ErrorState &errorState)
         {
+            if (audioFileReaders.empty())
+            {
+                errorState.fail("AudioFileReader: No audio files");
+                return false;
+            }
+
             mAudioFiles = audioFileReaders;
             for (auto& audioFile : mAudioFiles)
             {
-                if (audioFile->getDescriptor()->getMode() != AudioFileDescriptor::Mode::READ && audioFile->getDescriptor()->getMode() != AudioFileDescriptor::Mode::READWRITE)
+                auto descriptor = audioFile->getDescriptor();
+                if (descriptor->getMode() != AudioFileDescriptor::Mode::READ && descriptor->getMode() != AudioFileDescriptor::Mode::READWRITE)
                 {
                     errorState.fail("AudioFileReader: Audio file not opened for reading");
                     return false;
                 }
-                if (audioFile->getDescriptor()->getChannelCount() != 1)
-                {
-                    errorState.fail("AudioFileReader works with mono AudioFileIO resources");
-                    return false;
-                }
 
-                auto node = nodeManager.makeSafe<AudioFileReaderNode>(nodeManager, bufferSize);
-                node->setAudioFile(audioFile->getDescriptor());
+                auto node = nodeManager.makeSafe<AudioFileReaderNode>(nodeManager, descriptor->getChannelCount(), readAhead, maxSpeed, cueCount);
+                node->setQuality(quality);
+                node->setAudioFile(descriptor);
+                for (auto channel = 0; channel < node->getChannelCount(); ++channel)
+                    mChannels.emplace_back(&node->getOutput(channel));
                 mNodes.emplace_back(std::move(node));
             }
 
@@ -75,7 +88,43 @@ namespace nap
                 node->setLooping(looping);
         }
 
+
+        void AudioFileReaderInstance::setSpeed(ControllerValue speed)
+        {
+            for (auto& node : mNodes)
+                node->setSpeed(speed);
+        }
+
+
+        void AudioFileReaderInstance::seek(TimeValue time)
+        {
+            for (auto i = 0; i < mNodes.size(); ++i)
+                mNodes[i]->seek(time * mAudioFiles[i]->getDescriptor()->getSampleRate() / 1000.f);
+        }
+
+
+        void AudioFileReaderInstance::setCue(int index, TimeValue time)
+        {
+            for (auto i = 0; i < mNodes.size(); ++i)
+                mNodes[i]->setCue(index, time * mAudioFiles[i]->getDescriptor()->getSampleRate() / 1000.f);
+        }
+
+
+        void AudioFileReaderInstance::cue(int index)
+        {
+            for (auto& node : mNodes)
+                node->cue(index);
+        }
+
+
+        int AudioFileReaderInstance::getUnderrunCount() const
+        {
+            auto result = 0;
+            for (auto& node : mNodes)
+                result += node->getUnderrunCount();
+            return result;
+        }
+
     }
 
 }
-
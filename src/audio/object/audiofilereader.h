@@ -18,7 +18,8 @@ namespace nap
     {
 
         /**
-         * Audio object for reading audio data directly from file(s) on disk
+         * Audio object for streaming audio data directly from file(s) on disk.
+         * The channels of the object are the channels of all audio files in order, so a stereo file followed by a mono file gives three channels.
          */
         class NAPAPI AudioFileReader : public AudioObject
         {
@@ -27,8 +28,11 @@ namespace nap
         public:
             AudioFileReader() = default;
 
-            std::vector<ResourcePtr<AudioFileIO>> mAudioFiles; ///< property: 'AudioFiles' Vector that points to mono @AudioFileIO resources to read each channel of the object from.
-            int mBufferSize = 65536;                           ///< Property: 'BufferSize' Size of the internal circular buffers of the audio file readers
+            std::vector<ResourcePtr<AudioFileIO>> mAudioFiles; ///< property: 'AudioFiles' Vector that points to the @AudioFileIO resources to read the channels of the object from.
+            TimeValue mReadAhead = 500.f;                      ///< Property: 'ReadAhead' Time in ms that is read from disk ahead of the playback position.
+            ControllerValue mMaxSpeed = 1.f;                   ///< Property: 'MaxSpeed' Maximum playback speed, the read ahead is scaled by it.
+            int mCueCount = 0;                                 ///< Property: 'CueCount' Number of cues that can be set per file, the first frames after every cue are kept in memory.
+            PolyphaseResampler::Quality mQuality = PolyphaseResampler::Quality::Medium; ///< Property: 'Quality' Quality of the resampling when the sample rate or speed differs.
 
         private:
             std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
@@ -50,22 +54,25 @@ namespace nap
              * Initialize the instance
              * @param nodeManager The NodeManager that the AudioFileReaderNode run on
              * @param audioFiles Audio file descriptors for the audio files that will be read
-             * @param bufferSize Buffer size of the audio file reader nodes' internal circular buffers.
+             * @param readAhead Time in ms that is read from disk ahead of the playback position.
+             * @param maxSpeed Maximum playback speed
+             * @param cueCount Number of cues that can be set per file
+             * @param quality Quality of the resampling
              * @param errorState Logs errors during the initialization process
              * @return True on success
              */
-            bool init(NodeManager& nodeManager, std::vector<ResourcePtr<AudioFileIO>>& audioFiles, int bufferSize, utility::ErrorState& errorState);
+            bool init(NodeManager& nodeManager, std::vector<ResourcePtr<AudioFileIO>>& audioFiles, TimeValue readAhead, ControllerValue maxSpeed, int cueCount, PolyphaseResampler::Quality quality, utility::ErrorState& errorState);
 
             /**
              * @return The number of audio channels of this object
              */
-            int getChannelCount() const override { return mNodes.size(); }
+            int getChannelCount() const override { return mChannels.size(); }
 
             /**
              * @param channel Index of the requested output channel
              * @return Audio pin for the requested output channel.
              */
-            OutputPin* getOutputForChannel(int channel) override { return &mNodes[channel]->audioOutput; }
+            OutputPin* getOutputForChannel(int channel) override { return mChannels[channel]; }
 
             /**
              * Starts or stops reading from disk
@@ -88,11 +95,41 @@ namespace nap
              */
             bool isLooping() const { return (*mNodes.begin())->isLooping(); }
 
+            /**
+             * @param speed Playback speed, 1 plays the files at their own sample rate.
+             */
+            void setSpeed(ControllerValue speed);
+
+            /**
+             * Continues playback of all files at a position.
+             * @param time Position in ms from the start of the files
+             */
+            void seek(TimeValue time);
+
+            /**
+             * Sets a cue on all files, the first frames after the cue are preloaded.
+             * @param index Index of the cue, smaller than the cue count.
+             * @param time Position in ms from the start of the files
+             */
+            void setCue(int index, TimeValue time);
+
+            /**
+             * Continues playback of all files at a cue without waiting for the disk.
+             * @param index Index of the cue, smaller than the cue count.
+             */
+            void cue(int index);
+
+            /**
+             * @return The total number of times playback of the files needed frames that had not been read from disk yet.
+             */
+            int getUnderrunCount() const;
+
         private:
             std::vector<ResourcePtr<AudioFileIO>> mAudioFiles;
             std::vector<SafeOwner<AudioFileReaderNode>> mNodes;
+            std::vector<OutputPin*> mChannels;
         };
 
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,89 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "audiofilerecorder.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::AudioFileRecorder)
+	RTTI_PROPERTY("Input", &nap::audio::AudioFileRecorder::mInput, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("ChannelRouting", &nap::audio::AudioFileRecorder::mChannelRouting, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("AudioFile", &nap::audio::AudioFileRecorder::mAudioFile, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("BufferTime", &nap::audio::AudioFileRecorder::mBufferTime, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::AudioFileRecorderInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::AudioFileRecorderInstance::getNode)
+	RTTI_FUNCTION("setRecording", &nap::audio::AudioFileRecorderInstance::setRecording)
+	RTTI_FUNCTION("isRecording", &nap::audio::AudioFileRecorderInstance::isRecording)
+	RTTI_FUNCTION("startAt", &nap::audio::AudioFileRecorderInstance::startAt)
+	RTTI_FUNCTION("stopAt", &nap::audio::AudioFileRecorderInstance::stopAt)
+	RTTI_FUNCTION("getOverrunCount", &nap::audio::AudioFileRecorderInstance::getOverrunCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> AudioFileRecorder::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto input = mInput->getInstance();
+			auto routing = mChannelRouting;
+			if (routing.empty())
+				for (auto channel = 0; channel < input->getChannelCount(); ++channel)
+					routing.emplace_back(channel);
+
+			if (mAudioFile->getDescriptor()->getChannelCount() != routing.size())
+			{
+				errorState.fail("%s: The audio file has %i channels, %i channels are recorded", mID.c_str(), mAudioFile->getDescriptor()->getChannelCount(), int(routing.size()));
+				return nullptr;
+			}
+
+			auto result = std::make_unique<AudioFileRecorderInstance>();
+			if (!result->init(*mAudioFile, mBufferTime, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize AudioFileRecorder: %s", mID.c_str());
+				return nullptr;
+			}
+
+			for (auto channel = 0; channel < routing.size(); ++channel)
+			{
+				if (routing[channel] < 0 || routing[channel] >= input->getChannelCount())
+				{
+					errorState.fail("%s: Trying to rout input channel that is out of bounds.", mID.c_str());
+					return nullptr;
+				}
+				result->connect(channel, *input->getOutputForChannel(routing[channel]));
+			}
+
+			return result;
+		}
+
+
+		bool AudioFileRecorderInstance::init(AudioFileIO& audioFile, TimeValue bufferTime, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto descriptor = audioFile.getDescriptor();
+			if (descriptor->getMode() != AudioFileDescriptor::Mode::WRITE && descriptor->getMode() != AudioFileDescriptor::Mode::READWRITE)
+			{
+				errorState.fail("AudioFileRecorder: Audio file not opened for writing");
+				return false;
+			}
+			if (descriptor->getChannelCount() < 1)
+			{
+				errorState.fail("AudioFileRecorder needs at least one channel");
+				return false;
+			}
+
+			auto bufferSize = std::max<unsigned int>(bufferTime * nodeManager.getSamplesPerMillisecond(), nodeManager.getInternalBufferSize());
+			mNode = nodeManager.makeSafe<AudioFileRecorderNode>(nodeManager, descriptor->getChannelCount(), bufferSize, true);
+			mNode->setAudioFile(descriptor);
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,107 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/audiofilerecordernode.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Object that records any number of channels of its input into one interleaved audio file, using a single @AudioFileRecorderNode.
+		 * Unlike @AudioFileWriter, which writes a mono file per channel with a thread per channel, all channels share one ring buffer and one writer thread.
+		 * The sample format and container of the file are set on the @AudioFileIO, use RF64 for recordings larger than 4 GB.
+		 */
+		class NAPAPI AudioFileRecorder : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			AudioFileRecorder() = default;
+
+			ResourcePtr<AudioObject> mInput = nullptr;      ///< Property: 'Input' The object whose audio output is recorded.
+			std::vector<int> mChannelRouting;               ///< Property: 'ChannelRouting' For each channel of the file the channel of the input that is recorded into it. When empty all channels of the input are recorded in order.
+			ResourcePtr<AudioFileIO> mAudioFile = nullptr;  ///< Property: 'AudioFile' The file to record to, opened for writing with the number of channels that is recorded.
+			TimeValue mBufferTime = 5000.f;                 ///< Property: 'BufferTime' Length in ms of the ring buffer, the longest disk stall that can be absorbed without losing audio.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of AudioFileRecorder
+		 */
+		class NAPAPI AudioFileRecorderInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			AudioFileRecorderInstance() = default;
+			AudioFileRecorderInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initializes the AudioFileRecorderInstance
+			 * @param audioFile The file to record to, opened for writing.
+			 * @param bufferTime Length in ms of the ring buffer
+			 * @param nodeManager The NodeManager the recorder will be processed on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(AudioFileIO& audioFile, TimeValue bufferTime, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that records the file.
+			 */
+			AudioFileRecorderNode* getNode() { return mNode.getRaw(); }
+
+			/**
+			 * Starts or stops recording with the next buffer.
+			 */
+			void setRecording(bool recording) { mNode->setRecording(recording); }
+
+			/**
+			 * @return Whether the recorder is recording.
+			 */
+			bool isRecording() const { return mNode->isRecording(); }
+
+			/**
+			 * Starts recording at an exact sample time of the NodeManager.
+			 */
+			void startAt(DiscreteTimeValue sampleTime) { mNode->startAt(sampleTime); }
+
+			/**
+			 * Stops recording at an exact sample time of the NodeManager.
+			 */
+			void stopAt(DiscreteTimeValue sampleTime) { mNode->stopAt(sampleTime); }
+
+			/**
+			 * @return The number of buffers that were replaced by silence because the disk did not keep up.
+			 */
+			int getOverrunCount() const { return mNode->getOverrunCount(); }
+
+			// Inherited from AudioObjectInstance
+			void connect(unsigned int channel, OutputPin& pin) override { mNode->getInput(channel).connect(pin); }
+			int getInputChannelCount() const override { return mNode->getChannelCount(); }
+
+		private:
+			// Inherited from AudioObjectInstance
+			OutputPin* getOutputForChannel(int channel) override { return nullptr; }
+			int getChannelCount() const override { return 0; }
+
+			SafeOwner<AudioFileRecorderNode> mNode = nullptr;
+		};
+
+	}
+
+}
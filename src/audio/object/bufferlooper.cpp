@@ -5,7 +5,10 @@
 #include "bufferlooper.h"
 
 RTTI_BEGIN_STRUCT(nap::audio::BufferLooper::Settings)
-    RTTI_PROPERTY("Buffer", &nap::audio::BufferLooper::Settings::mBufferResource, nap::rtti::EPropertyMetaData::Required)
+    RTTI_PROPERTY("Buffer", &nap::audio::BufferLooper::Settings::mBufferResource, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("CompressedBuffer", &nap::audio::BufferLooper::Settings::mCompressedBufferResource, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("Stream", &nap::audio::BufferLooper::Settings::mStreamResource, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("PreloadTime", &nap::audio::BufferLooper::Settings::mPreloadTime, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("Loop", &nap::audio::BufferLooper::Settings::mLoop, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("Start", &nap::audio::BufferLooper::Settings::mStart, nap::rtti::EPropertyMetaData::Required)
     RTTI_PROPERTY("LoopStart", &nap::audio::BufferLooper::Settings::mLoopStart, nap::rtti::EPropertyMetaData::Required)
@@ -39,25 +42,32 @@ namespace nap
         
         bool BufferLooper::Settings::init(utility::ErrorState& errorState)
         {
-            if (mBufferResource == nullptr)
+            if (mBufferResource == nullptr && mCompressedBufferResource == nullptr && mStreamResource == nullptr)
             {
-                errorState.fail("Invalid BufferLooper settings: no buffer given");
+                errorState.fail("Invalid BufferLooper settings: no buffer, compressed buffer or stream given");
                 return false;
             }
             
-            if (mStart < 0.f || mStart >= mBufferResource->toMilliseconds(mBufferResource->getSize()))
+            TimeValue length;
+            if (isStreamed())
+                length = mStreamResource->toMilliseconds(mStreamResource->getSize());
+            else if (isCompressed())
+                length = mCompressedBufferResource->toMilliseconds(mCompressedBufferResource->getSize());
+            else
+                length = mBufferResource->toMilliseconds(mBufferResource->getSize());
+            if (mStart < 0.f || mStart >= length)
             {
                 errorState.fail("Invalid BufferLooper settings: invalid start position");
                 return false;
             }
             
-            if (mLoopStart < 0.f || mLoopStart >= mBufferResource->toMilliseconds(mBufferResource->getSize()))
+            if (mLoopStart < 0.f || mLoopStart >= length)
             {
                 errorState.fail("Invalid BufferLooper settings: invalid loop start position");
                 return false;
             }
             
-            if (mLoopEnd < 0.f || mLoopEnd >= mBufferResource->toMilliseconds(mBufferResource->getSize()) || mLoopEnd <= mLoopStart)
+            if (mLoopEnd < 0.f || mLoopEnd >= length || mLoopEnd <= mLoopStart)
             {
                 errorState.fail("Invalid BufferLooper settings: invalid loop end position");
                 return false;
@@ -95,6 +105,18 @@ namespace nap
             if (!mSettings.init(errorState))
                 return false;
             
+            if (mSettings.isStreamed())
+            {
+                errorState.fail("BufferLooper " + getName() + " can not play streamed settings, use a SamplePlayer instead");
+                return false;
+            }
+            
+            if (mSettings.isCompressed())
+            {
+                errorState.fail("BufferLooper " + getName() + " can not play a compressed buffer, use a SampleLooper instead");
+                return false;
+            }
+            
             mBufferPlayer = std::make_unique<BufferPlayer>();
             mBufferPlayer->mID = "BufferPlayer";
             mBufferPlayer->mAutoPlay = false;
@@ -7,6 +7,8 @@
 #include <audio/object/bufferplayer.h>
 #include <audio/object/multiply.h>
 #include <audio/core/polyphonic.h>
+#include <audio/resource/compressedbufferresource.h>
+#include <audio/resource/mappedsampleresource.h>
 
 namespace nap
 {
@@ -38,6 +40,9 @@ namespace nap
                 bool init(utility::ErrorState& errorState);
                 
                 ResourcePtr<AudioBufferResource> mBufferResource = nullptr; ///< Property: 'Buffer' Pointer to the AudioBufferResource that contains the audio data to play back. Mostly an AudioFileResource.
+                ResourcePtr<CompressedBufferResource> mCompressedBufferResource = nullptr; ///< Property: 'CompressedBuffer' Pointer to a CompressedBufferResource that is played from memory as 16 or 24 bit samples. Used when no Buffer is given, a SampleLooper or a SamplePlayer can play it.
+                ResourcePtr<MappedSampleResource> mStreamResource = nullptr; ///< Property: 'Stream' Pointer to a MappedSampleResource that is streamed instead of played from memory. Used when no Buffer or CompressedBuffer is given, only a SamplePlayer can play it.
+                TimeValue mPreloadTime = 500.f;                             ///< Property: 'PreloadTime' Time in ms after the start position of a streamed sample that is kept in memory. It covers the time the stream needs to fill.
                 TimeValue mCrossFadeTime  = 1000.f;                         ///< Property: 'CrossFadeTime' Time in ms for the crossfade from the end of the loop to the start od the loop.
                 TimeValue mStart = 0.f;                                     ///< Property: 'Start' Offset in ms where to start playback.
                 TimeValue mLoopStart = 0.f;                                 ///< Property: 'LoopStart' Offset in ms where the looped section starts. Has to be greater than mStart.
@@ -54,6 +59,16 @@ namespace nap
                  * @return The length of the section between the start of playback and the start of the loop.
                  */
                 TimeValue getFirstSustainDuration() const { return mFirstSustainDuration; }
+
+                /**
+                 * @return True if the sample is streamed from a MappedSampleResource instead of played from a buffer in memory.
+                 */
+                bool isStreamed() const { return mBufferResource == nullptr && mCompressedBufferResource == nullptr && mStreamResource != nullptr; }
+
+                /**
+                 * @return True if the sample is played from a CompressedBufferResource instead of a buffer of floats.
+                 */
+                bool isCompressed() const { return mBufferResource == nullptr && mCompressedBufferResource != nullptr; }
                 
             private:
                 TimeValue mLoopSustainDuration = 0.f;
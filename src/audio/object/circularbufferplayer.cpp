@@ -6,6 +6,7 @@
 
 
 RTTI_BEGIN_CLASS(nap::audio::CircularBufferPlayer)
+    RTTI_PROPERTY("Quality", &nap::audio::CircularBufferPlayer::mQuality, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::ParallelNodeObjectInstance<nap::audio::CircularBufferPlayerNode>)
@@ -16,7 +17,13 @@ namespace nap
     
     namespace audio
     {
-        
+
+        bool CircularBufferPlayer::initNode(int channel, CircularBufferPlayerNode& node, utility::ErrorState& errorState)
+        {
+            node.setQuality(mQuality);
+            return true;
+        }
+
     }
     
 }
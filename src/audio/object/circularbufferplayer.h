@@ -22,6 +22,11 @@ namespace nap
             
         public:
             CircularBufferPlayer() = default;
+
+            PolyphaseResampler::Quality mQuality = PolyphaseResampler::Quality::Medium; ///< Property: 'Quality' Quality of the resampling when playing at other speeds than 1.
+
+        private:
+            bool initNode(int channel, CircularBufferPlayerNode& node, utility::ErrorState& errorState) override;
         };
 
 
@@ -0,0 +1,38 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "compressedbufferplayer.h"
+
+RTTI_BEGIN_CLASS(nap::audio::CompressedBufferPlayer)
+    RTTI_PROPERTY("AutoPlay", &nap::audio::CompressedBufferPlayer::mAutoPlay, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("Buffer", &nap::audio::CompressedBufferPlayer::mBufferResource, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("Quality", &nap::audio::CompressedBufferPlayer::mQuality, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::ParallelNodeObjectInstance<nap::audio::CompressedBufferPlayerNode>)
+RTTI_END_CLASS
+
+namespace nap
+{
+    
+    namespace audio
+    {
+        
+        bool CompressedBufferPlayer::initNode(int channel, CompressedBufferPlayerNode& node, utility::ErrorState& errorState)
+        {
+            node.setQuality(mQuality);
+            if (mBufferResource != nullptr)
+            {
+                node.setBuffer(mBufferResource->getBuffer());
+                node.setChannel(channel);
+            }
+
+            if (mAutoPlay)
+                node.play(channel, 0, 1.f);
+            return true;
+        }
+                
+    }
+    
+}
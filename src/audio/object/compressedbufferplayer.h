@@ -0,0 +1,48 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/utility/safeptr.h>
+#include <audio/core/nodeobject.h>
+#include <audio/node/compressedbufferplayernode.h>
+#include <audio/resource/compressedbufferresource.h>
+
+namespace nap
+{
+    
+    namespace audio
+    {
+        
+        /**
+         * AudioObject to play back audio contained by a CompressedBufferResource.
+         */
+        class NAPAPI CompressedBufferPlayer : public ParallelNodeObject<CompressedBufferPlayerNode>
+        {
+            RTTI_ENABLE(ParallelNodeObjectBase)
+            
+        public:
+            CompressedBufferPlayer() = default;
+            
+            ResourcePtr<CompressedBufferResource> mBufferResource = nullptr;   ///< Property: 'Buffer' Resource containing the buffer that will be played.
+            bool mAutoPlay = true;                                              ///< Property: 'AutoPlay' If true, the object will start playing back immediately after initialization.
+            PolyphaseResampler::Quality mQuality = PolyphaseResampler::Quality::Medium; ///< Property: 'Quality' Quality of the resampling when the speed or the sample rate differs.
+            
+        private:
+            bool initNode(int channel, CompressedBufferPlayerNode& node, utility::ErrorState& errorState) override;
+        };
+
+
+        /**
+         * Instance of CompressedBufferPlayer
+         */
+        using CompressedBufferPlayerInstance = ParallelNodeObjectInstance<CompressedBufferPlayerNode>;
+        
+    }
+    
+}
@@ -4,10 +4,13 @@
 
 #include "delay.h"
 
+#include <algorithm>
+
 RTTI_BEGIN_CLASS(nap::audio::DelayObject)
     RTTI_PROPERTY("Time", &nap::audio::DelayObject::mTime, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("Feedback", &nap::audio::DelayObject::mFeedback, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("DryWet", &nap::audio::DelayObject::mDryWet, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("MaxTime", &nap::audio::DelayObject::mMaxTime, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("Input", &nap::audio::DelayObject::mInput, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
@@ -22,6 +25,8 @@ namespace nap
         
         bool DelayObject::initNode(int channel, DelayNode& node, utility::ErrorState& errorState)
         {
+            auto maxTime = mMaxTime > 0.f ? mMaxTime : std::max(DelayNode::DefaultMaxTime, *std::max_element(mTime.begin(), mTime.end()));
+            node.setMaxTime(maxTime);
             node.setTime(mTime[channel % mTime.size()]);
             node.setFeedback(mFeedback[channel % mFeedback.size()]);
             node.setDryWet(mDryWet[channel % mDryWet.size()]);
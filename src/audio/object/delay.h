@@ -28,6 +28,7 @@ namespace nap
             std::vector<TimeValue> mTime = { 0.f };             ///< Property: 'Time' array of delay time values per output channel. If the size of the array is less than the number of channels it will be repeated.
             std::vector<ControllerValue> mFeedback = { 0.f };   ///< Property: 'Time' array of feedback values per output channel. If the size of the array is less than the number of channels it will be repeated.
             std::vector<TimeValue> mDryWet = { 0.f };           ///< Property: 'DryWet' array of dry wet balance levels per output channel. If the size of the array is less than the number of channels it will be repeated.
+            TimeValue mMaxTime = 0.f;                           ///< Property: 'MaxTime' maximum delay time in ms that the delay lines are sized for. When 0 the delay lines are sized for DelayNode::DefaultMaxTime, or for the largest value in Time when that is longer. Set it to save memory on short delays.
             ResourcePtr<AudioObject> mInput;                    ///< Property: "Input" AudioObject whose output channels will be used as inputs for the delay channels.
             
         private:
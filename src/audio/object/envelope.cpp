@@ -62,12 +62,13 @@ namespace nap
             if (segmentIndex >= mEnvelopeGenerator->getEnvelope().size())
                 return;
             
-            auto& segment = mEnvelopeGenerator->getEnvelope()[segmentIndex];
+            auto segment = mEnvelopeGenerator->getEnvelope()[segmentIndex];
             segment.mDuration = duration;
             segment.mDestination = destination;
             segment.mDurationRelative = durationRelative;
             segment.mMode = exponential ? RampMode::Exponential : RampMode::Linear;
             segment.mTranslate = useTranslator;
+            mEnvelopeGenerator->setSegment(segmentIndex, segment);
         }
 
     }
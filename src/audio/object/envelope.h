@@ -101,7 +101,7 @@ namespace nap
              * Assigns new envelope data
              * @param envelope Input envelope data that will be copied to this object
              */
-            void setEnvelopeData(const EnvelopeNode::Envelope& envelope) { mEnvelopeGenerator->getEnvelope() = envelope; }
+            void setEnvelopeData(const EnvelopeNode::Envelope& envelope) { mEnvelopeGenerator->setEnvelope(envelope); }
 
             /**
              * @return the current output value of the envelope generator.
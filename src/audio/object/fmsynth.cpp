@@ -0,0 +1,67 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "fmsynth.h"
+
+RTTI_BEGIN_CLASS(nap::audio::FMSynth)
+	RTTI_PROPERTY("WaveTable", &nap::audio::FMSynth::mWaveTable, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("OperatorCount", &nap::audio::FMSynth::mOperatorCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Operators", &nap::audio::FMSynth::mOperators, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Modulations", &nap::audio::FMSynth::mModulations, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_DEFINE_CLASS(nap::audio::FMSynthInstance)
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		bool FMSynth::initNode(int channel, FMNode& node, utility::ErrorState& errorState)
+		{
+			if (mOperatorCount < 1 || mOperatorCount > FMNode::MaxOperatorCount)
+			{
+				errorState.fail("%s: OperatorCount has to be between 1 and %i", mID.c_str(), FMNode::MaxOperatorCount);
+				return false;
+			}
+
+			if (mOperators.size() > mOperatorCount)
+			{
+				errorState.fail("%s: More operator settings than operators", mID.c_str());
+				return false;
+			}
+
+			if (!mWaveTable->getWave()->isPowerOfTwo())
+			{
+				errorState.fail("%s: WaveTable size has to be a power of two", mID.c_str());
+				return false;
+			}
+
+			node.setWave(mWaveTable->getWave());
+			node.setOperatorCount(mOperatorCount);
+			for (auto op = 0; op < mOperators.size(); ++op)
+				node.setOperator(op, mOperators[op]);
+
+			for (auto& modulation : mModulations)
+			{
+				if (modulation.mModulator < 0 || modulation.mModulator >= mOperatorCount || modulation.mTarget < 0 || modulation.mTarget >= mOperatorCount)
+				{
+					errorState.fail("%s: Modulation between operators %i and %i out of range", mID.c_str(), modulation.mModulator, modulation.mTarget);
+					return false;
+				}
+				if (modulation.mModulator == modulation.mTarget)
+				{
+					errorState.fail("%s: Operator %i modulates itself, use its Feedback instead", mID.c_str(), modulation.mModulator);
+					return false;
+				}
+				node.setModulation(modulation.mModulator, modulation.mTarget, modulation.mDepth);
+			}
+
+			return true;
+		}
+
+	}
+
+}
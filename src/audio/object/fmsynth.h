@@ -0,0 +1,49 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/nodeobject.h>
+#include <audio/node/fmnode.h>
+#include <audio/object/oscillator.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Multichannel FM synthesizer, containing an @FMNode on each channel.
+		 * Every channel plays the same patch, described by the operators and the algorithm matrix.
+		 */
+		class NAPAPI FMSynth : public ParallelNodeObject<FMNode>
+		{
+			RTTI_ENABLE(ParallelNodeObjectBase)
+
+		public:
+			FMSynth() = default;
+
+			ResourcePtr<WaveTableResource> mWaveTable = nullptr; ///< Property: 'WaveTable' Waveform of the operators, normally a sine. Its size has to be a power of two.
+			int mOperatorCount = 4;                              ///< Property: 'OperatorCount' Number of operators, up to 6.
+			std::vector<FMOperator> mOperators;                  ///< Property: 'Operators' Settings of the operators. Operators without settings use the defaults.
+			std::vector<FMModulation> mModulations;              ///< Property: 'Modulations' The algorithm matrix: which operator modulates which.
+
+			// Inherited from ParallelNodeObject
+			bool initNode(int channel, FMNode& node, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of FMSynth
+		 */
+		using FMSynthInstance = ParallelNodeObjectInstance<FMNode>;
+
+	}
+
+}
@@ -0,0 +1,110 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "granulator.h"
+
+// Std includes
+#include <cmath>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::Granulator)
+	RTTI_PROPERTY("Input", &nap::audio::Granulator::mInput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("InputChannel", &nap::audio::Granulator::mInputChannel, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("BufferTime", &nap::audio::Granulator::mBufferTime, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Buffer", &nap::audio::Granulator::mBuffer, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("BufferChannel", &nap::audio::Granulator::mBufferChannel, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("MaxGrains", &nap::audio::Granulator::mMaxGrains, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Density", &nap::audio::Granulator::mDensity, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Duration", &nap::audio::Granulator::mDuration, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Position", &nap::audio::Granulator::mPosition, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("PositionJitter", &nap::audio::Granulator::mPositionJitter, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Pitch", &nap::audio::Granulator::mPitch, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("PitchJitter", &nap::audio::Granulator::mPitchJitter, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Pan", &nap::audio::Granulator::mPan, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("PanSpread", &nap::audio::Granulator::mPanSpread, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Window", &nap::audio::Granulator::mWindow, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Gain", &nap::audio::Granulator::mGain, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::GranulatorInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::GranulatorInstance::getNode)
+	RTTI_FUNCTION("setFrozen", &nap::audio::GranulatorInstance::setFrozen)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> Granulator::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto result = std::make_unique<GranulatorInstance>();
+			if (!result->init(mMaxGrains, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize Granulator: %s", mID.c_str());
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			if (mBuffer != nullptr)
+			{
+				if (mBufferChannel < 0 || mBufferChannel >= mBuffer->getChannelCount())
+				{
+					errorState.fail("%s: Buffer channel out of bounds", mID.c_str());
+					return nullptr;
+				}
+				node->setSource(mBuffer->getBuffer(), mBufferChannel);
+			}
+			else if (mInput != nullptr)
+			{
+				auto input = mInput->getInstance();
+				if (mInputChannel < 0 || mInputChannel >= input->getChannelCount())
+				{
+					errorState.fail("%s: Input channel out of bounds", mID.c_str());
+					return nullptr;
+				}
+				result->setInput(*input->getOutputForChannel(mInputChannel), mBufferTime, nodeManager);
+			}
+
+			node->setDensity(mDensity);
+			node->setDuration(mDuration);
+			node->setPosition(mPosition);
+			node->setPositionJitter(mPositionJitter);
+			node->setPitch(mPitch);
+			node->setPitchJitter(mPitchJitter);
+			node->setPan(mPan);
+			node->setPanSpread(mPanSpread);
+			node->setWindow(mWindow);
+			node->setGain(mGain);
+
+			return result;
+		}
+
+
+		bool GranulatorInstance::init(int maxGrains, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (maxGrains < 1)
+			{
+				errorState.fail("Granulator needs at least one grain");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<GranularNode>(nodeManager, maxGrains);
+			return true;
+		}
+
+
+		void GranulatorInstance::setInput(OutputPin& input, TimeValue bufferTime, NodeManager& nodeManager)
+		{
+			auto size = (unsigned int) std::ceil(std::max(bufferTime, 1.f) * nodeManager.getSamplesPerMillisecond()) + nodeManager.getInternalBufferSize();
+			mCircularBuffer = nodeManager.makeSafe<CircularBufferNode>(nodeManager, size);
+			mCircularBuffer->audioInput.connect(input);
+			mNode->setSource(mCircularBuffer.getRaw());
+		}
+
+	}
+
+}
@@ -0,0 +1,107 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/circularbuffernode.h>
+#include <audio/node/granularnode.h>
+#include <audio/resource/audiobufferresource.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Granular synthesizer with a stereo output, processed by a single @GranularNode.
+		 * The grains either play from a live input, recorded into a circular buffer, or from an @AudioBufferResource.
+		 * With a live input the buffer can be frozen to keep granulating the same material.
+		 */
+		class NAPAPI Granulator : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			Granulator() = default;
+
+			ResourcePtr<AudioObject> mInput = nullptr;              ///< Property: 'Input' Live input that is recorded and granulated. Not used when a buffer is set.
+			int mInputChannel = 0;                                  ///< Property: 'InputChannel' Channel of the input that is granulated.
+			TimeValue mBufferTime = 5000.f;                         ///< Property: 'BufferTime' Length in ms of the recorded live input, the maximum position of the grains.
+			ResourcePtr<AudioBufferResource> mBuffer = nullptr;     ///< Property: 'Buffer' Buffer that is granulated instead of a live input.
+			int mBufferChannel = 0;                                 ///< Property: 'BufferChannel' Channel of the buffer that is granulated.
+			int mMaxGrains = 256;                                   ///< Property: 'MaxGrains' Maximum number of grains that play at the same time.
+			ControllerValue mDensity = 20.f;                        ///< Property: 'Density' Number of grains started per second.
+			TimeValue mDuration = 100.f;                            ///< Property: 'Duration' Duration of the grains in ms.
+			TimeValue mPosition = 100.f;                            ///< Property: 'Position' Start position of the grains in ms, behind the live input or from the start of the buffer.
+			TimeValue mPositionJitter = 0.f;                        ///< Property: 'PositionJitter' Maximum random deviation of the start position in ms.
+			ControllerValue mPitch = 1.f;                           ///< Property: 'Pitch' Playback speed of the grains.
+			ControllerValue mPitchJitter = 0.f;                     ///< Property: 'PitchJitter' Maximum random deviation of the pitch in semitones.
+			ControllerValue mPan = 0.f;                             ///< Property: 'Pan' Pan position of the grains between -1 and 1.
+			ControllerValue mPanSpread = 0.f;                       ///< Property: 'PanSpread' Maximum random deviation of the pan position.
+			GranularNode::Window mWindow = GranularNode::Window::Hann; ///< Property: 'Window' Window of the grains.
+			ControllerValue mGain = 1.f;                            ///< Property: 'Gain' Gain of every grain.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of Granulator
+		 */
+		class NAPAPI GranulatorInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			GranulatorInstance() = default;
+			GranulatorInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the GranulatorInstance
+			 * @param maxGrains Maximum number of grains that play at the same time
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int maxGrains, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * Records a live input into a circular buffer and granulates it.
+			 * @param input Output pin of the live input
+			 * @param bufferTime Length of the circular buffer in ms
+			 * @param nodeManager The NodeManager this object will process on
+			 */
+			void setInput(OutputPin& input, TimeValue bufferTime, NodeManager& nodeManager);
+
+			/**
+			 * Freezes or resumes recording of the live input.
+			 * @param frozen True to keep granulating the material that is in the buffer now.
+			 */
+			void setFrozen(bool frozen) { if (mCircularBuffer != nullptr) mCircularBuffer->setFrozen(frozen); }
+
+			/**
+			 * @return The node that plays the grains.
+			 */
+			GranularNode* getNode() { return mNode.getRaw(); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return 2; }
+			OutputPin* getOutputForChannel(int channel) override { return channel == 0 ? &mNode->leftOutput : &mNode->rightOutput; }
+
+		private:
+			SafeOwner<GranularNode> mNode = nullptr;
+			SafeOwner<CircularBufferNode> mCircularBuffer = nullptr; // Records the live input
+		};
+
+	}
+
+}
@@ -0,0 +1,72 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "limiter.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::Limiter)
+	RTTI_PROPERTY("ChannelCount", &nap::audio::Limiter::mChannelCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Input", &nap::audio::Limiter::mInput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Lookahead", &nap::audio::Limiter::mLookahead, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Ceiling", &nap::audio::Limiter::mCeiling, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Release", &nap::audio::Limiter::mRelease, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Linked", &nap::audio::Limiter::mLinked, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::LimiterInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::LimiterInstance::getNode)
+	RTTI_FUNCTION("getChannelCount", &nap::audio::LimiterInstance::getChannelCount)
+	RTTI_FUNCTION("getLatency", &nap::audio::LimiterInstance::getLatency)
+	RTTI_FUNCTION("getGainReduction", &nap::audio::LimiterInstance::getGainReduction)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> Limiter::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto result = std::make_unique<LimiterInstance>();
+			if (!result->init(mChannelCount, mLookahead, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize Limiter: %s", mID.c_str());
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			node->setCeiling(mCeiling);
+			node->setRelease(mRelease);
+			node->setLinked(mLinked);
+
+			if (mInput != nullptr)
+				for (auto channel = 0; channel < mChannelCount; ++channel)
+					node->getInput(channel).connect(*mInput->getInstance()->getOutputForChannel(channel % mInput->getInstance()->getChannelCount()));
+
+			return result;
+		}
+
+
+		bool LimiterInstance::init(int channelCount, TimeValue lookahead, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (channelCount < 1)
+			{
+				errorState.fail("Limiter needs at least one channel");
+				return false;
+			}
+			if (lookahead < 0.f)
+			{
+				errorState.fail("Limiter lookahead can not be negative");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<LimiterNode>(nodeManager, channelCount, lookahead);
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,93 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/limiternode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Multichannel lookahead limiter object. All channels are processed by a single @LimiterNode, so their gain can be linked.
+		 * The output is delayed by the lookahead time, use LimiterInstance::getLatency() to compensate other signal paths.
+		 */
+		class NAPAPI Limiter : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			Limiter() = default;
+
+			int mChannelCount = 2;                          ///< Property: 'ChannelCount' Number of channels.
+			ResourcePtr<AudioObject> mInput = nullptr;      ///< Property: 'Input' Audio object of which the outputs are limited.
+			TimeValue mLookahead = 5.f;                     ///< Property: 'Lookahead' Lookahead time in ms, which is also the latency of the limiter.
+			ControllerValue mCeiling = -0.3f;               ///< Property: 'Ceiling' Maximum output level in dB.
+			TimeValue mRelease = 100.f;                     ///< Property: 'Release' Time in ms for the gain to recover 60dB.
+			bool mLinked = true;                            ///< Property: 'Linked' Whether all channels get the same gain, driven by the loudest channel.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of Limiter
+		 */
+		class NAPAPI LimiterInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			LimiterInstance() = default;
+			LimiterInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the LimiterInstance
+			 * @param channelCount Number of channels
+			 * @param lookahead Lookahead time in ms
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int channelCount, TimeValue lookahead, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that performs the limiting.
+			 */
+			LimiterNode* getNode() { return mNode.getRaw(); }
+
+			/**
+			 * @return The latency of the limiter in samples.
+			 */
+			int getLatency() const { return mNode->getLatency(); }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return The largest gain reduction of the channel during the last processed buffer, in dB.
+			 */
+			ControllerValue getGainReduction(int channel) const { return mNode->getGainReduction(channel); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return mNode->getChannelCount(); }
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->getOutput(channel); }
+			void connect(unsigned int channel, OutputPin& pin) override { mNode->getInput(channel).connect(pin); }
+			int getInputChannelCount() const override { return mNode->getChannelCount(); }
+
+		private:
+			SafeOwner<LimiterNode> mNode = nullptr;
+		};
+
+	}
+
+}
@@ -0,0 +1,259 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "modulationmatrix.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/object/delay.h>
+#include <audio/object/filter.h>
+#include <audio/object/gain.h>
+#include <audio/object/oscillator.h>
+
+RTTI_BEGIN_ENUM(nap::audio::ModulationTarget::EParameter)
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::None, "None"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::FilterFrequency, "FilterFrequency"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::FilterResonance, "FilterResonance"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::FilterBand, "FilterBand"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::FilterGain, "FilterGain"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::OscillatorFrequency, "OscillatorFrequency"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::OscillatorAmplitude, "OscillatorAmplitude"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::Gain, "Gain"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::DelayTime, "DelayTime"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::DelayFeedback, "DelayFeedback"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::EParameter::DelayDryWet, "DelayDryWet")
+RTTI_END_ENUM
+
+RTTI_BEGIN_ENUM(nap::audio::ModulationTarget::ERate)
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::ERate::Control, "Control"),
+	RTTI_ENUM_VALUE(nap::audio::ModulationTarget::ERate::Audio, "Audio")
+RTTI_END_ENUM
+
+RTTI_BEGIN_STRUCT(nap::audio::ModulationTarget)
+	RTTI_PROPERTY("Object", &nap::audio::ModulationTarget::mObject, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Parameter", &nap::audio::ModulationTarget::mParameter, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Rate", &nap::audio::ModulationTarget::mRate, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Base", &nap::audio::ModulationTarget::mBase, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Minimum", &nap::audio::ModulationTarget::mMinimum, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Maximum", &nap::audio::ModulationTarget::mMaximum, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_STRUCT
+
+RTTI_BEGIN_STRUCT(nap::audio::ModulationRoute)
+	RTTI_PROPERTY("Source", &nap::audio::ModulationRoute::mSource, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Target", &nap::audio::ModulationRoute::mTarget, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Depth", &nap::audio::ModulationRoute::mDepth, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_STRUCT
+
+RTTI_BEGIN_CLASS(nap::audio::ModulationMatrix)
+	RTTI_PROPERTY("Sources", &nap::audio::ModulationMatrix::mSources, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Targets", &nap::audio::ModulationMatrix::mTargets, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Routes", &nap::audio::ModulationMatrix::mRoutes, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Gate", &nap::audio::ModulationMatrix::mGate, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::ModulationMatrixInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::ModulationMatrixInstance::getNode)
+	RTTI_FUNCTION("setBase", &nap::audio::ModulationMatrixInstance::setBase)
+	RTTI_FUNCTION("setDepth", &nap::audio::ModulationMatrixInstance::setDepth)
+	RTTI_FUNCTION("setVelocity", &nap::audio::ModulationMatrixInstance::setVelocity)
+	RTTI_FUNCTION("getValue", &nap::audio::ModulationMatrixInstance::getValue)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Collects the nodes of all channels of a parallel node object, fails if the object is of another type.
+		 */
+		template <typename NodeType>
+		static bool getTargetNodes(const ModulationTarget& target, std::vector<NodeType*>& nodes, utility::ErrorState& errorState)
+		{
+			auto instance = target.mObject == nullptr ? nullptr : rtti_cast<ParallelNodeObjectInstance<NodeType>>(target.mObject->getInstance());
+			if (instance == nullptr)
+			{
+				errorState.fail("Modulation target %s does not match its parameter", target.mObject == nullptr ? "" : target.mObject->mID.c_str());
+				return false;
+			}
+			for (auto channel = 0; channel < instance->getChannelCount(); ++channel)
+				nodes.emplace_back(instance->getChannel(channel));
+			return true;
+		}
+
+
+		std::unique_ptr<AudioObjectInstance> ModulationMatrix::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			std::vector<ModulationMatrixNode::Target> targets;
+			for (auto& target : mTargets)
+			{
+				targets.emplace_back();
+				if (!createTarget(target, nodeManager, targets.back(), errorState))
+				{
+					errorState.fail("Invalid modulation target in %s", mID.c_str());
+					return nullptr;
+				}
+			}
+
+			std::vector<ModulationMatrixNode::Route> routes;
+			for (auto& route : mRoutes)
+			{
+				if (route.mSource < ModulationMatrixNode::VelocitySource || route.mSource >= int(mSources.size()) || route.mTarget < 0 || route.mTarget >= int(mTargets.size()))
+				{
+					errorState.fail("Invalid modulation route in %s", mID.c_str());
+					return nullptr;
+				}
+				routes.push_back({ route.mSource, route.mTarget, route.mDepth });
+			}
+
+			auto result = std::make_unique<ModulationMatrixInstance>();
+			if (!result->init(mSources.size(), targets, routes, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize ModulationMatrix");
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			for (auto source = 0; source < mSources.size(); ++source)
+				node->getSource(source).connect(*mSources[source]->getInstance()->getOutputForChannel(0));
+			if (mGate != nullptr)
+				node->gate.connect(*mGate->getInstance()->getOutputForChannel(0));
+
+			// Audio rate oscillator targets drive the fm inputs
+			for (auto i = 0; i < mTargets.size(); ++i)
+			{
+				auto& target = mTargets[i];
+				if (target.mRate == ModulationTarget::ERate::Audio && target.mParameter == ModulationTarget::EParameter::OscillatorFrequency)
+				{
+					auto oscillator = rtti_cast<OscillatorInstance>(target.mObject->getInstance());
+					for (auto channel = 0; channel < oscillator->getChannelCount(); ++channel)
+						oscillator->getChannel(channel)->fmInput.connect(node->getOutput(i));
+				}
+			}
+
+			return result;
+		}
+
+
+		bool ModulationMatrix::createTarget(const ModulationTarget& target, NodeManager& nodeManager, ModulationMatrixNode::Target& result, utility::ErrorState& errorState)
+		{
+			using EParameter = ModulationTarget::EParameter;
+
+			result.mAudioRate = target.mRate == ModulationTarget::ERate::Audio;
+			result.mBase = target.mBase;
+			result.mMinimum = target.mMinimum;
+			result.mMaximum = target.mMaximum;
+
+			if (target.mParameter == EParameter::None)
+				return true;
+
+			if (result.mAudioRate && target.mParameter != EParameter::OscillatorFrequency)
+			{
+				errorState.fail("Only OscillatorFrequency can be modulated at audio rate");
+				return false;
+			}
+
+			// Ramped parameters glide to the new value over one buffer
+			auto rampTime = nodeManager.getInternalBufferSize() / nodeManager.getSamplesPerMillisecond();
+
+			switch (target.mParameter)
+			{
+				case EParameter::FilterFrequency:
+				case EParameter::FilterResonance:
+				case EParameter::FilterBand:
+				case EParameter::FilterGain:
+				{
+					std::vector<FilterNode*> nodes;
+					if (!getTargetNodes(target, nodes, errorState))
+						return false;
+					auto parameter = target.mParameter;
+					result.mSetter = [nodes, parameter](ControllerValue value)
+					{
+						for (auto node : nodes)
+						{
+							if (parameter == EParameter::FilterFrequency)
+								node->setFrequency(value);
+							else if (parameter == EParameter::FilterResonance)
+								node->setResonance(value);
+							else if (parameter == EParameter::FilterBand)
+								node->setBand(value);
+							else
+								node->setGain(value);
+						}
+					};
+					return true;
+				}
+				case EParameter::OscillatorFrequency:
+				case EParameter::OscillatorAmplitude:
+				{
+					auto oscillator = target.mObject == nullptr ? nullptr : rtti_cast<OscillatorInstance>(target.mObject->getInstance());
+					if (oscillator == nullptr)
+					{
+						errorState.fail("Modulation target is not an Oscillator");
+						return false;
+					}
+					if (result.mAudioRate)
+					{
+						auto resource = rtti_cast<Oscillator>(target.mObject.get());
+						if (resource != nullptr && resource->mFmInput != nullptr)
+						{
+							errorState.fail("Oscillator %s already has an fm input", resource->mID.c_str());
+							return false;
+						}
+						return true;
+					}
+					std::vector<OscillatorNode*> nodes;
+					for (auto channel = 0; channel < oscillator->getChannelCount(); ++channel)
+						nodes.emplace_back(oscillator->getChannel(channel));
+					if (target.mParameter == EParameter::OscillatorFrequency)
+						result.mSetter = [nodes, rampTime](ControllerValue value) { for (auto node : nodes) node->setFrequency(value, rampTime); };
+					else
+						result.mSetter = [nodes, rampTime](ControllerValue value) { for (auto node : nodes) node->setAmplitude(value, rampTime); };
+					return true;
+				}
+				case EParameter::Gain:
+				{
+					std::vector<GainNode*> nodes;
+					if (!getTargetNodes(target, nodes, errorState))
+						return false;
+					result.mSetter = [nodes, rampTime](ControllerValue value) { for (auto node : nodes) node->setGain(value, rampTime); };
+					return true;
+				}
+				case EParameter::DelayTime:
+				case EParameter::DelayFeedback:
+				case EParameter::DelayDryWet:
+				{
+					std::vector<DelayNode*> nodes;
+					if (!getTargetNodes(target, nodes, errorState))
+						return false;
+					if (target.mParameter == EParameter::DelayTime)
+						result.mSetter = [nodes, rampTime](ControllerValue value) { for (auto node : nodes) node->setTime(value, rampTime); };
+					else if (target.mParameter == EParameter::DelayFeedback)
+						result.mSetter = [nodes](ControllerValue value) { for (auto node : nodes) node->setFeedback(value); };
+					else
+						result.mSetter = [nodes, rampTime](ControllerValue value) { for (auto node : nodes) node->setDryWet(value, rampTime); };
+					return true;
+				}
+				default:
+					errorState.fail("Unknown modulation parameter");
+					return false;
+			}
+		}
+
+
+		bool ModulationMatrixInstance::init(int sourceCount, const std::vector<ModulationMatrixNode::Target>& targets, const std::vector<ModulationMatrixNode::Route>& routes, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (targets.empty())
+			{
+				errorState.fail("ModulationMatrix needs at least one target");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<ModulationMatrixNode>(nodeManager, sourceCount, targets, routes);
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,165 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <limits>
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/modulationmatrixnode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * A parameter of an object in the same graph that is modulated by a @ModulationMatrix.
+		 */
+		struct NAPAPI ModulationTarget
+		{
+			/**
+			 * The parameter of the object that is modulated.
+			 */
+			enum class EParameter
+			{
+				None,                   ///< No parameter, the value is only available on the output of the matrix.
+				FilterFrequency,        ///< Cutoff or center frequency of a Filter in Hz.
+				FilterResonance,        ///< Resonance of a Filter.
+				FilterBand,             ///< Bandwidth of a Filter in Hz.
+				FilterGain,             ///< Gain of a Filter.
+				OscillatorFrequency,    ///< Frequency of an Oscillator in Hz. At audio rate the value is a relative frequency deviation that drives the fm input.
+				OscillatorAmplitude,    ///< Amplitude of an Oscillator.
+				Gain,                   ///< Gain of a Gain object.
+				DelayTime,              ///< Delay time of a DelayObject in ms.
+				DelayFeedback,          ///< Feedback of a DelayObject.
+				DelayDryWet             ///< Dry/wet balance of a DelayObject.
+			};
+
+			/**
+			 * The rate at which the value of the target is computed.
+			 */
+			enum class ERate
+			{
+				Control,                ///< Once per buffer, the parameter is set on the audio thread.
+				Audio                   ///< Per sample, only for OscillatorFrequency and None.
+			};
+
+			ResourcePtr<AudioObject> mObject = nullptr;                                 ///< Property: 'Object' The Filter, Oscillator, Gain or DelayObject that is modulated, on all of its channels. Can be empty for parameter None.
+			EParameter mParameter = EParameter::None;                                   ///< Property: 'Parameter' The parameter of the object that is modulated.
+			ERate mRate = ERate::Control;                                               ///< Property: 'Rate' The rate at which the value is computed.
+			ControllerValue mBase = 0.f;                                                ///< Property: 'Base' Value of the parameter before modulation.
+			ControllerValue mMinimum = std::numeric_limits<ControllerValue>::lowest();  ///< Property: 'Minimum' The value is clamped to this minimum.
+			ControllerValue mMaximum = std::numeric_limits<ControllerValue>::max();     ///< Property: 'Maximum' The value is clamped to this maximum.
+		};
+
+
+		/**
+		 * A connection from a source to a target of a @ModulationMatrix.
+		 */
+		struct NAPAPI ModulationRoute
+		{
+			int mSource = 0;                ///< Property: 'Source' Index in the sources of the matrix, -1 for the note velocity.
+			int mTarget = 0;                ///< Property: 'Target' Index in the targets of the matrix.
+			ControllerValue mDepth = 1.f;   ///< Property: 'Depth' Multiplier of the source value.
+		};
+
+
+		/**
+		 * Modulation matrix within a graph, typically a @Voice.
+		 * Routes sources (envelopes, LFOs, controls and the note velocity) to parameters of Filter, Oscillator, Gain and Delay objects in the same graph.
+		 * The modulation is computed on the audio thread, so the control thread only has to send note events and parameter changes.
+		 * The channels of the instance are the values of the targets.
+		 */
+		class NAPAPI ModulationMatrix : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			ModulationMatrix() = default;
+
+			std::vector<ResourcePtr<AudioObject>> mSources; ///< Property: 'Sources' Objects of which the first channel is used as a modulation source.
+			std::vector<ModulationTarget> mTargets;         ///< Property: 'Targets' The modulated parameters.
+			std::vector<ModulationRoute> mRoutes;           ///< Property: 'Routes' Connections from sources to targets.
+			ResourcePtr<AudioObject> mGate = nullptr;       ///< Property: 'Gate' Optional object of which the first channel gates the matrix, normally the envelope of the voice. The matrix is only computed while this signal is not silent.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+
+			// Creates the node target for a target description, connecting it to the object it modulates.
+			bool createTarget(const ModulationTarget& target, NodeManager& nodeManager, ModulationMatrixNode::Target& result, utility::ErrorState& errorState);
+		};
+
+
+		/**
+		 * Instance of ModulationMatrix
+		 */
+		class NAPAPI ModulationMatrixInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			ModulationMatrixInstance() = default;
+			ModulationMatrixInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the ModulationMatrixInstance
+			 * @param sourceCount Number of sources
+			 * @param targets The targets of the matrix
+			 * @param routes The routes of the matrix
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int sourceCount, const std::vector<ModulationMatrixNode::Target>& targets, const std::vector<ModulationMatrixNode::Route>& routes, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that computes the modulation.
+			 */
+			ModulationMatrixNode* getNode() { return mNode.getRaw(); }
+
+			/**
+			 * Sets the value of a target before modulation.
+			 * @param target Index of the target
+			 * @param value New base value
+			 */
+			void setBase(int target, ControllerValue value) { mNode->setBase(target, value); }
+
+			/**
+			 * Sets the depth of a route.
+			 * @param route Index of the route
+			 * @param depth New multiplier of the source value
+			 */
+			void setDepth(int route, ControllerValue depth) { mNode->setDepth(route, depth); }
+
+			/**
+			 * Sets the note velocity that can be used as a source.
+			 * @param velocity Velocity, normally between 0 and 1.
+			 */
+			void setVelocity(ControllerValue velocity) { mNode->setVelocity(velocity); }
+
+			/**
+			 * @param target Index of the target
+			 * @return The value of the target at the end of the last processed buffer.
+			 */
+			ControllerValue getValue(int target) const { return mNode->getValue(target); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return mNode->getTargetCount(); }
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->getOutput(channel); }
+
+		private:
+			SafeOwner<ModulationMatrixNode> mNode = nullptr;
+		};
+
+	}
+
+}
@@ -0,0 +1,74 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "multichannelcircularbuffer.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::MultichannelCircularBuffer)
+	RTTI_PROPERTY("Input", &nap::audio::MultichannelCircularBuffer::mInput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("ChannelRouting", &nap::audio::MultichannelCircularBuffer::mChannelRouting, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("RootProcess", &nap::audio::MultichannelCircularBuffer::mRootProcess, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("BufferSize", &nap::audio::MultichannelCircularBuffer::mBufferSize, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MultichannelCircularBufferInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::MultichannelCircularBufferInstance::getNode)
+	RTTI_FUNCTION("getBufferChannelCount", &nap::audio::MultichannelCircularBufferInstance::getBufferChannelCount)
+	RTTI_FUNCTION("clear", &nap::audio::MultichannelCircularBufferInstance::clear)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> MultichannelCircularBuffer::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto result = std::make_unique<MultichannelCircularBufferInstance>();
+			if (!result->init(mChannelRouting.size(), mRootProcess, mBufferSize, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize MultichannelCircularBuffer: %s", mID.c_str());
+				return nullptr;
+			}
+
+			if (mInput != nullptr)
+			{
+				auto input = mInput->getInstance();
+				for (auto channel = 0; channel < mChannelRouting.size(); ++channel)
+				{
+					if (mChannelRouting[channel] < 0 || mChannelRouting[channel] >= input->getChannelCount())
+					{
+						errorState.fail("%s: Trying to rout input channel that is out of bounds.", mID.c_str());
+						return nullptr;
+					}
+					result->connect(channel, *input->getOutputForChannel(mChannelRouting[channel]));
+				}
+			}
+
+			return result;
+		}
+
+
+		bool MultichannelCircularBufferInstance::init(int channelCount, bool rootProcess, int bufferSize, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (channelCount < 1)
+			{
+				errorState.fail("MultichannelCircularBuffer needs at least one channel");
+				return false;
+			}
+			if (bufferSize < 1)
+			{
+				errorState.fail("MultichannelCircularBuffer buffer size has to be larger than 0");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<MultichannelCircularBufferNode>(nodeManager, channelCount, bufferSize, rootProcess);
+			return true;
+		}
+
+	}
+
+}
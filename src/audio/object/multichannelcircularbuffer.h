@@ -0,0 +1,99 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/multichannelcircularbuffernode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Object that records any number of channels of its input into a single @MultichannelCircularBufferNode.
+		 * Unlike @CircularBuffer all channels share one write position and one root process, which is cheaper for large channel counts.
+		 */
+		class NAPAPI MultichannelCircularBuffer : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			MultichannelCircularBuffer() = default;
+
+			ResourcePtr<AudioObject> mInput = nullptr;  ///< Property: 'Input' The object whose audio output to rout to the circular buffer.
+			std::vector<int> mChannelRouting = { 0 };   ///< Property: 'ChannelRouting' For each channel of the circular buffer the channel of the input that is recorded into it.
+			bool mRootProcess = true;                   ///< Property: 'RootProcess' Indicates if the node is added as root process to the NodeManager.
+			int mBufferSize = 65536;                    ///< Property: 'BufferSize' The size of the circular buffer of every channel in samples.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of MultichannelCircularBuffer
+		 */
+		class NAPAPI MultichannelCircularBufferInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			MultichannelCircularBufferInstance() = default;
+			MultichannelCircularBufferInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initializes the MultichannelCircularBufferInstance
+			 * @param channelCount Number of channels of the circular buffer
+			 * @param rootProcess True if the node should be a root process of the NodeManager.
+			 * @param bufferSize The size of the circular buffer of every channel in samples
+			 * @param nodeManager The NodeManager the circular buffer will be processed on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int channelCount, bool rootProcess, int bufferSize, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that holds the circular buffer.
+			 */
+			MultichannelCircularBufferNode* getNode() { return mNode.getRaw(); }
+
+			/**
+			 * @param channel Index of the channel
+			 * @return Read access to the channel, for example for a @CircularBufferPlayerNode.
+			 */
+			const CircularBufferView& getView(int channel) const { return mNode->getView(channel); }
+
+			/**
+			 * @return Number of channels of the circular buffer
+			 */
+			int getBufferChannelCount() const { return mNode->getChannelCount(); }
+
+			/**
+			 * Clears the contents of all channels of the circular buffer.
+			 */
+			void clear() { mNode->clear(); }
+
+			// Inherited from AudioObjectInstance
+			void connect(unsigned int channel, OutputPin& pin) override { mNode->getInput(channel).connect(pin); }
+			int getInputChannelCount() const override { return mNode->getChannelCount(); }
+
+		private:
+			// Inherited from AudioObjectInstance
+			OutputPin* getOutputForChannel(int channel) override { return nullptr; }
+			int getChannelCount() const override { return 0; }
+
+			SafeOwner<MultichannelCircularBufferNode> mNode = nullptr;
+		};
+
+	}
+
+}
@@ -0,0 +1,73 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "multichannelcompressor.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::MultiChannelCompressor)
+	RTTI_PROPERTY("ChannelCount", &nap::audio::MultiChannelCompressor::mChannelCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Input", &nap::audio::MultiChannelCompressor::mInput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Sidechain", &nap::audio::MultiChannelCompressor::mSidechain, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Ratio", &nap::audio::MultiChannelCompressor::mRatio, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Threshold", &nap::audio::MultiChannelCompressor::mThreshold, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Attack", &nap::audio::MultiChannelCompressor::mAttack, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Release", &nap::audio::MultiChannelCompressor::mRelease, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Link", &nap::audio::MultiChannelCompressor::mLink, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("GainInterval", &nap::audio::MultiChannelCompressor::mGainInterval, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MultiChannelCompressorInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::MultiChannelCompressorInstance::getNode)
+	RTTI_FUNCTION("getChannelCount", &nap::audio::MultiChannelCompressorInstance::getChannelCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> MultiChannelCompressor::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto result = std::make_unique<MultiChannelCompressorInstance>();
+			if (!result->init(mChannelCount, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize MultiChannelCompressor: %s", mID.c_str());
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			node->setRatio(mRatio);
+			node->setThreshold(mThreshold);
+			node->setAttack(mAttack);
+			node->setRelease(mRelease);
+			node->setLink(mLink);
+			node->setGainInterval(mGainInterval);
+
+			if (mInput != nullptr)
+				for (auto channel = 0; channel < mChannelCount; ++channel)
+					node->getInput(channel).connect(*mInput->getInstance()->getOutputForChannel(channel % mInput->getInstance()->getChannelCount()));
+			if (mSidechain != nullptr)
+				node->sidechainInput.connect(*mSidechain->getInstance()->getOutputForChannel(0));
+
+			return result;
+		}
+
+
+		bool MultiChannelCompressorInstance::init(int channelCount, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (channelCount < 1)
+			{
+				errorState.fail("MultiChannelCompressor needs at least one channel");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<MultiChannelCompressorNode>(nodeManager, channelCount);
+			return true;
+		}
+
+	}
+
+}
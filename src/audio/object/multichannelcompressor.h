@@ -0,0 +1,83 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/multichannelcompressornode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Multichannel compressor object. All channels are processed by a single @MultiChannelCompressorNode, so their level detection can be linked.
+		 */
+		class NAPAPI MultiChannelCompressor : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			MultiChannelCompressor() = default;
+
+			int mChannelCount = 2;                                                              ///< Property: 'ChannelCount' Number of channels.
+			ResourcePtr<AudioObject> mInput = nullptr;                                          ///< Property: 'Input' Audio object of which the outputs are compressed.
+			ResourcePtr<AudioObject> mSidechain = nullptr;                                      ///< Property: 'Sidechain' Optional audio object of which the first channel drives the gain reduction of all channels.
+			ControllerValue mRatio = 4.f;                                                       ///< Property: 'Ratio' Ratio between 1 and 20.
+			ControllerValue mThreshold = -6.f;                                                  ///< Property: 'Threshold' Threshold in dB.
+			TimeValue mAttack = 0.8f;                                                           ///< Property: 'Attack' Attack time in ms.
+			TimeValue mRelease = 500.f;                                                         ///< Property: 'Release' Release time in ms.
+			MultiChannelCompressorNode::ELink mLink = MultiChannelCompressorNode::ELink::None;  ///< Property: 'Link' How the level detection of the channels is linked.
+			int mGainInterval = 1;                                                              ///< Property: 'GainInterval' Number of samples between two gain computations, the gain is interpolated in between.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of MultiChannelCompressor
+		 */
+		class NAPAPI MultiChannelCompressorInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			MultiChannelCompressorInstance() = default;
+			MultiChannelCompressorInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the MultiChannelCompressorInstance
+			 * @param channelCount Number of channels
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int channelCount, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that performs the compression.
+			 */
+			MultiChannelCompressorNode* getNode() { return mNode.getRaw(); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return mNode->getChannelCount(); }
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->getOutput(channel); }
+			void connect(unsigned int channel, OutputPin& pin) override { mNode->getInput(channel).connect(pin); }
+			int getInputChannelCount() const override { return mNode->getChannelCount(); }
+
+		private:
+			SafeOwner<MultiChannelCompressorNode> mNode = nullptr;
+		};
+
+	}
+
+}
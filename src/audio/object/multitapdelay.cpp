@@ -0,0 +1,70 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "multitapdelay.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_STRUCT(nap::audio::MultiTapDelayTap)
+	RTTI_PROPERTY("Time", &nap::audio::MultiTapDelayTap::mTime, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Gain", &nap::audio::MultiTapDelayTap::mGain, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Pan", &nap::audio::MultiTapDelayTap::mPan, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_STRUCT
+
+RTTI_BEGIN_CLASS(nap::audio::MultiTapDelay)
+	RTTI_PROPERTY("Input", &nap::audio::MultiTapDelay::mInput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Taps", &nap::audio::MultiTapDelay::mTaps, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("MaxTime", &nap::audio::MultiTapDelay::mMaxTime, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MultiTapDelayInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::MultiTapDelayInstance::getNode)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> MultiTapDelay::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto maxTime = mMaxTime;
+			if (maxTime <= 0.f)
+				for (auto& tap : mTaps)
+					maxTime = std::max(maxTime, tap.mTime);
+
+			auto result = std::make_unique<MultiTapDelayInstance>();
+			if (!result->init(mTaps.size(), maxTime, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize MultiTapDelay: %s", mID.c_str());
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			for (auto i = 0; i < mTaps.size(); ++i)
+				node->setTap(i, mTaps[i].mTime, mTaps[i].mGain, mTaps[i].mPan);
+
+			if (mInput != nullptr)
+				node->input.connect(*mInput->getInstance()->getOutputForChannel(0));
+
+			return result;
+		}
+
+
+		bool MultiTapDelayInstance::init(int tapCount, TimeValue maxTime, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (tapCount < 1)
+			{
+				errorState.fail("MultiTapDelay needs at least one tap");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<MultiTapDelayNode>(nodeManager, tapCount, maxTime);
+			return true;
+		}
+
+	}
+
+}
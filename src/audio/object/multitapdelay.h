@@ -0,0 +1,89 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/multitapdelaynode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * A single tap of a @MultiTapDelay.
+		 */
+		struct NAPAPI MultiTapDelayTap
+		{
+			TimeValue mTime = 0.f;          ///< Property: 'Time' Delay time in ms.
+			ControllerValue mGain = 1.f;    ///< Property: 'Gain' Gain multiplier of the tap.
+			ControllerValue mPan = 0.f;     ///< Property: 'Pan' Pan position between -1 (left) and 1 (right).
+		};
+
+
+		/**
+		 * Stereo multi tap delay of a mono input, for example for early reflections. All taps are read from one @MultiTapDelayNode.
+		 */
+		class NAPAPI MultiTapDelay : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			MultiTapDelay() = default;
+
+			ResourcePtr<AudioObject> mInput = nullptr;      ///< Property: 'Input' Audio object of which the first channel is delayed.
+			std::vector<MultiTapDelayTap> mTaps;            ///< Property: 'Taps' The taps of the delay.
+			TimeValue mMaxTime = 0.f;                       ///< Property: 'MaxTime' Maximum delay time in ms. When 0 the delay line is sized for the longest tap.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of MultiTapDelay
+		 */
+		class NAPAPI MultiTapDelayInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			MultiTapDelayInstance() = default;
+			MultiTapDelayInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the MultiTapDelayInstance
+			 * @param tapCount Number of taps
+			 * @param maxTime Maximum delay time in ms
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int tapCount, TimeValue maxTime, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that reads the taps.
+			 */
+			MultiTapDelayNode* getNode() { return mNode.getRaw(); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return 2; }
+			OutputPin* getOutputForChannel(int channel) override { return channel == 0 ? &mNode->leftOutput : &mNode->rightOutput; }
+			void connect(unsigned int channel, OutputPin& pin) override { mNode->input.connect(pin); }
+			int getInputChannelCount() const override { return 1; }
+
+		private:
+			SafeOwner<MultiTapDelayNode> mNode = nullptr;
+		};
+
+	}
+
+}
@@ -4,6 +4,15 @@
 
 #include "oscillator.h"
 
+// Std includes
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+// Nap includes
+#include <utility/fileutils.h>
+
 RTTI_BEGIN_ENUM(nap::audio::WaveTable::Waveform)
 	RTTI_ENUM_VALUE(nap::audio::WaveTable::Waveform::Sine, "Sine"),
 	RTTI_ENUM_VALUE(nap::audio::WaveTable::Waveform::Saw, "Saw"),
@@ -16,6 +25,7 @@ RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::WaveTableResource)
     RTTI_PROPERTY("Size", &nap::audio::WaveTableResource::mSize, nap::rtti::EPropertyMetaData::Default)
 	RTTI_PROPERTY("Waveform", &nap::audio::WaveTableResource::mWaveform, nap::rtti::EPropertyMetaData::Default)
 	RTTI_PROPERTY("NumberOfBands", &nap::audio::WaveTableResource::mNumberOfBands, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("CacheDirectory", &nap::audio::WaveTableResource::mCacheDirectory, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
 RTTI_BEGIN_CLASS(nap::audio::Oscillator)
@@ -24,6 +34,7 @@ RTTI_BEGIN_CLASS(nap::audio::Oscillator)
     RTTI_PROPERTY("FmInput", &nap::audio::Oscillator::mFmInput, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("WaveTables", &nap::audio::Oscillator::mWaveTables, nap::rtti::EPropertyMetaData::Required)
 	RTTI_PROPERTY("WaveTableSelection", &nap::audio::Oscillator::mWaveTableSelection, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("Interpolation", &nap::audio::Oscillator::mInterpolation, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::OscillatorInstance)
@@ -41,10 +52,95 @@ namespace nap
 
         bool WaveTableResource::init(utility::ErrorState& errorState)
         {
-            mWave = mNodeManager->makeSafe<WaveTable>(mSize, mWaveform, mNumberOfBands);
+            if (mSize <= 0)
+            {
+                errorState.fail("WaveTable size has to be positive: %s", mID.c_str());
+                return false;
+            }
+            mWave = mNodeManager->makeSafe<WaveTable>(getData(mNodeManager->getSampleRate()));
             return true;
         }
 
+
+        // Wave table data that is in use by at least one resource, keyed by waveform, size, number of bands and sample rate.
+        using WaveTableKey = std::tuple<WaveTable::Waveform, int, int, int>;
+        static std::mutex sharedWaveTablesMutex;
+        static std::map<WaveTableKey, std::weak_ptr<WaveTable::Data>> sharedWaveTables;
+
+        static const uint32_t cacheFileIdentifier = 0x4e415057; // "NAPW"
+
+
+        static bool readWaveTable(const std::string& path, int size, WaveTable::Data& data)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                return false;
+
+            uint32_t identifier = 0;
+            int32_t fileSize = 0;
+            int32_t bandCount = 0;
+            file.read(reinterpret_cast<char*>(&identifier), sizeof(identifier));
+            file.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+            file.read(reinterpret_cast<char*>(&bandCount), sizeof(bandCount));
+            if (!file || identifier != cacheFileIdentifier || fileSize != size || bandCount <= 0 || bandCount > 1024)
+                return false;
+
+            data.mBandBottoms.resize(bandCount);
+            file.read(reinterpret_cast<char*>(data.mBandBottoms.data()), bandCount * sizeof(int32_t));
+            data.mBands.resize(bandCount, size);
+            for (auto band = 0; band < bandCount; ++band)
+                file.read(reinterpret_cast<char*>(data.mBands[band].data()), size * sizeof(SampleValue));
+            return bool(file);
+        }
+
+
+        static void writeWaveTable(const std::string& path, const WaveTable::Data& data)
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return;
+
+            const int32_t size = data.mBands.getSize();
+            const int32_t bandCount = data.mBandBottoms.size();
+            file.write(reinterpret_cast<const char*>(&cacheFileIdentifier), sizeof(cacheFileIdentifier));
+            file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            file.write(reinterpret_cast<const char*>(&bandCount), sizeof(bandCount));
+            file.write(reinterpret_cast<const char*>(data.mBandBottoms.data()), bandCount * sizeof(int32_t));
+            for (auto band = 0; band < bandCount; ++band)
+                file.write(reinterpret_cast<const char*>(data.mBands[band].data()), size * sizeof(SampleValue));
+        }
+
+
+        std::shared_ptr<WaveTable::Data> WaveTableResource::getData(float sampleRate)
+        {
+            // Sine tables have a single band and do not depend on the sample rate
+            auto sine = mWaveform == WaveTable::Waveform::Sine;
+            WaveTableKey key(mWaveform, mSize, sine ? 1 : mNumberOfBands, sine ? 0 : int(sampleRate));
+
+            std::lock_guard<std::mutex> lock(sharedWaveTablesMutex);
+            auto data = sharedWaveTables[key].lock();
+            if (data != nullptr)
+                return data;
+
+            auto cachePath = mCacheDirectory.empty() ? std::string() : getCachePath(sampleRate);
+            data = std::make_shared<WaveTable::Data>();
+            if (cachePath.empty() || !readWaveTable(cachePath, mSize, *data))
+            {
+                auto nyquist = sampleRate > 0.f ? sampleRate / 2.f : WaveTable::Nyquist;
+                data = WaveTable::generate(mSize, mWaveform, mNumberOfBands, nyquist);
+                if (!cachePath.empty() && utility::makeDirs(mCacheDirectory))
+                    writeWaveTable(cachePath, *data);
+            }
+            sharedWaveTables[key] = data;
+            return data;
+        }
+
+
+        std::string WaveTableResource::getCachePath(float sampleRate) const
+        {
+            return mCacheDirectory + "/wavetable_" + std::to_string(int(mWaveform)) + "_" + std::to_string(mSize) + "_" + std::to_string(mNumberOfBands) + "_" + std::to_string(int(sampleRate)) + ".bin";
+        }
+
         WaveTableResource::WaveTableResource(Core &core) : Resource()
         {
             auto audioService = core.getService<AudioService>();
@@ -70,6 +166,7 @@ namespace nap
 				auto node = result->getChannel(channel);
 				node->setFrequency(mFrequency[channel % mFrequency.size()]);
 				node->setAmplitude(mAmplitude[channel % mAmplitude.size()]);
+				node->setInterpolation(mInterpolation);
                 if (mFmInput != nullptr)
                 {
                     node->fmInput.connect(*mFmInput->getInstance()->getOutputForChannel(channel % mFmInput->getInstance()->getChannelCount()));
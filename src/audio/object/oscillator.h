@@ -26,6 +26,8 @@ namespace nap
 
 		/**
 		 * Resource wrapper around WaveTable object.
+		 * Resources with the same waveform, size, number of bands and sample rate share their sample data.
+		 * When a cache directory is specified the generated data is stored there and loaded on the next run.
 		 */
         class NAPAPI WaveTableResource : public Resource
 		{
@@ -35,9 +37,10 @@ namespace nap
             WaveTableResource(Core& core);
             bool init(utility::ErrorState& errorState) override;
 
-            int mSize = 2048;                                          ///< Property: 'Size' Size of the wavetable. Has to be a power of two.
-            int mNumberOfBands = 100;                                  ///< Property: 'NumberOfBands' Number of bands used for band limiting
+            int mSize = 2048;                                          ///< Property: 'Size' Size of the wavetable. A power of two renders per block, other sizes are rendered per sample.
+            int mNumberOfBands = 0;                                    ///< Property: 'NumberOfBands' Number of bands used for band limiting. 0 uses one band per octave.
             WaveTable::Waveform mWaveform = WaveTable::Waveform::Sine; ///< Property: 'Waveform' Waveform of the wave table.
+            std::string mCacheDirectory;                               ///< Property: 'CacheDirectory' Optional directory to cache generated wave tables on disk.
 
             /**
              * @return Pointer to the managed WaveTable object.
@@ -47,6 +50,11 @@ namespace nap
         protected:
             SafeOwner<WaveTable> mWave = nullptr;
             NodeManager* mNodeManager = nullptr;
+
+        private:
+            // Returns the data for the current properties, shared with other resources or loaded from the cache when available.
+            std::shared_ptr<WaveTable::Data> getData(float sampleRate);
+            std::string getCachePath(float sampleRate) const;
         };
 
 
@@ -65,6 +73,7 @@ namespace nap
             std::vector<ResourcePtr<WaveTableResource>> mWaveTables; ///< property: 'WaveTables' Pointers to a collection of different wave table resources that can be chosen from at runtime.
 			int mWaveTableSelection = 0; ///< property: 'WaveTableIndex' Selection from the list of wavetables that will be used on initialization.
 			int mChannelCount = 1; ///< property: 'ChannelCount' Number of channels
+			OscillatorNode::Interpolation mInterpolation = OscillatorNode::Interpolation::Linear; ///< property: 'Interpolation' Linear or cubic interpolation of the wavetables
             
         private:
 			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
@@ -0,0 +1,74 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "samplelooper.h"
+
+RTTI_BEGIN_CLASS(nap::audio::SampleLooper)
+	RTTI_PROPERTY("ChannelCount", &nap::audio::SampleLooper::mChannelCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Quality", &nap::audio::SampleLooper::mQuality, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::SampleLooperInstance)
+	RTTI_FUNCTION("play", &nap::audio::SampleLooperInstance::play)
+	RTTI_FUNCTION("stop", &nap::audio::SampleLooperInstance::stop)
+	RTTI_FUNCTION("isPlaying", &nap::audio::SampleLooperInstance::isPlaying)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> SampleLooper::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto instance = std::make_unique<SampleLooperInstance>();
+			if (!instance->init(mChannelCount, mQuality, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize SampleLooperInstance");
+				return nullptr;
+			}
+
+			return std::move(instance);
+		}
+
+
+		bool SampleLooperInstance::init(int channelCount, PolyphaseResampler::Quality quality, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (!errorState.check(channelCount > 0, "SampleLooper: Channel count has to be at least 1"))
+				return false;
+
+			mNode = nodeManager.makeSafe<SampleLooperNode>(nodeManager, channelCount);
+			mNode->setQuality(quality);
+			return true;
+		}
+
+
+		void SampleLooperInstance::play(const BufferLooper::Settings& settings)
+		{
+			if (settings.isCompressed())
+				playResource(*settings.mCompressedBufferResource, settings);
+			else
+				playResource(*settings.mBufferResource, settings);
+		}
+
+
+		template <typename Resource>
+		void SampleLooperInstance::playResource(Resource& resource, const BufferLooper::Settings& settings)
+		{
+			SampleLoop loop;
+			loop.mStart = resource.toSamples(settings.mStart);
+			loop.mLoop = settings.mLoop;
+			loop.mLoopStart = resource.toSamples(settings.mLoopStart);
+			loop.mLoopEnd = resource.toSamples(settings.mLoopEnd);
+			loop.mCrossFade = resource.toSamples(settings.mCrossFadeTime);
+
+			// The transposition is played at the sample rate of the buffer
+			auto speed = mtof(64.f + settings.mTranspose) / mtof(64.f) * resource.getSampleRate() / mNode->getNodeManager().getSampleRate();
+			mNode->play(resource.getBuffer(), loop, speed);
+		}
+
+	}
+
+}
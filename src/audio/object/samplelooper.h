@@ -0,0 +1,88 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/sampleloopernode.h>
+#include <audio/object/bufferlooper.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Plays BufferLooper settings with a single @SampleLooperNode: start, loop points and the equal power crossfade are rendered by the node itself.
+		 * Unlike the BufferLooper it needs no internal voices, envelopes or callbacks, which makes it the looper of choice for the voices of a sampler.
+		 */
+		class NAPAPI SampleLooper : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			SampleLooper() = default;
+
+			int mChannelCount = 1;                                                      ///< Property: 'ChannelCount' Number of channels
+			PolyphaseResampler::Quality mQuality = PolyphaseResampler::Quality::Medium; ///< Property: 'Quality' Quality of the resampling when the sample is transposed or its sample rate differs.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of SampleLooper
+		 */
+		class NAPAPI SampleLooperInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			SampleLooperInstance() = default;
+			SampleLooperInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the instance
+			 * @param channelCount Number of channels
+			 * @param quality Quality of the resampling
+			 * @param nodeManager The NodeManager the node runs on
+			 * @param errorState Logs errors during the initialization process
+			 * @return True on success
+			 */
+			bool init(int channelCount, PolyphaseResampler::Quality quality, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			// Inherited from AudioObjectInstance
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->getOutput(channel); }
+			int getChannelCount() const override { return mNode->getChannelCount(); }
+
+			/**
+			 * Starts playback, stopping what was playing before.
+			 * @param settings Settings of a buffer or a compressed buffer that is played from memory, they have to be initialized.
+			 */
+			void play(const BufferLooper::Settings& settings);
+
+			/**
+			 * Stops playback
+			 */
+			void stop() { mNode->stop(); }
+
+			/**
+			 * @return Whether the looper is playing
+			 */
+			bool isPlaying() const { return mNode->isPlaying(); }
+
+		private:
+			// Plays the settings from an AudioBufferResource or a CompressedBufferResource
+			template <typename Resource>
+			void playResource(Resource& resource, const BufferLooper::Settings& settings);
+
+			SafeOwner<SampleLooperNode> mNode = nullptr;
+		};
+
+	}
+
+}
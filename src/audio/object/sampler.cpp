@@ -10,6 +10,7 @@ RTTI_BEGIN_CLASS(nap::audio::SamplePlayer)
     RTTI_PROPERTY("ChannelCount", &nap::audio::SamplePlayer::mChannelCount, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("VoiceCount", &nap::audio::SamplePlayer::mVoiceCount, nap::rtti::EPropertyMetaData::Default)
     RTTI_PROPERTY("EqualPowerTable", &nap::audio::SamplePlayer::mEqualPowerTable, nap::rtti::EPropertyMetaData::Required)
+    RTTI_PROPERTY("StreamReadAhead", &nap::audio::SamplePlayer::mStreamReadAhead, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
 RTTI_BEGIN_CLASS(nap::audio::SamplePlayerInstance)
@@ -35,33 +36,79 @@ namespace nap
         std::unique_ptr<AudioObjectInstance> SamplePlayer::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
         {
             auto instance = std::make_unique<SamplePlayerInstance>();
-            if (!instance->init(mSampleEntries, mEqualPowerTable, mEnvelopeData, mChannelCount, mVoiceCount, nodeManager, errorState))
+            if (!instance->init(mSampleEntries, mEqualPowerTable, mEnvelopeData, mChannelCount, mVoiceCount, mStreamReadAhead, nodeManager, errorState))
                 return nullptr;
             
             return std::move(instance);
         }
 
         
-        bool SamplePlayerInstance::init(SamplePlayer::SamplerEntries& samplerEntries, ResourcePtr<EqualPowerTable> equalPowerTable, EnvelopeNode::Envelope& envelopeData, int channelCount, int voiceCount, NodeManager& nodeManager, utility::ErrorState& errorState)
+        bool SamplePlayerInstance::init(SamplePlayer::SamplerEntries& samplerEntries, ResourcePtr<EqualPowerTable> equalPowerTable, EnvelopeNode::Envelope& envelopeData, int channelCount, int voiceCount, TimeValue streamReadAhead, NodeManager& nodeManager, utility::ErrorState& errorState)
         {
             mSamplerEntries = samplerEntries;
             mEnvelopeData = envelopeData;
             
+            // Streamed entries keep a copy of the start of their sample in memory, the stream slot of every voice is sized for the fastest of them
+            bool resident = false;
+            ControllerValue maxSpeed = 0.f;
+            mPreloads.clear();
             for (auto& entry : mSamplerEntries)
+            {
                 if (!entry.init(errorState))
                     return false;
+                
+                if (entry.isStreamed())
+                {
+                    mPreloads.emplace_back(entry.mStreamResource->preload(entry.mStart, entry.mPreloadTime));
+                    maxSpeed = std::max(maxSpeed, mtof(64.f + entry.mTranspose) / mtof(64.f));
+                }
+                else {
+                    mPreloads.emplace_back(nullptr);
+                    resident = true;
+                }
+            }
             
-            mBufferLooper = std::make_unique<BufferLooper>();
-            mBufferLooper->mID = "BufferLooper";
-            mBufferLooper->mAutoPlay = false;
-            if (!mSamplerEntries.empty())
-                mBufferLooper->mSettings = mSamplerEntries[0];
-            mBufferLooper->mChannelCount = channelCount;
-            mBufferLooper->mEqualPowerTable = equalPowerTable;
-            if (!mBufferLooper->init(errorState))
+            if (resident || maxSpeed == 0.f)
             {
-                errorState.fail("Failed to initialize BufferLooper");
-                return false;
+                mSampleLooper = std::make_unique<SampleLooper>();
+                mSampleLooper->mID = "SampleLooper";
+                mSampleLooper->mChannelCount = channelCount;
+                if (!mSampleLooper->init(errorState))
+                {
+                    errorState.fail("Failed to initialize SampleLooper");
+                    return false;
+                }
+            }
+            
+            if (maxSpeed > 0.f)
+            {
+                mStreamPlayer = std::make_unique<SampleStreamPlayer>();
+                mStreamPlayer->mID = "SampleStreamPlayer";
+                mStreamPlayer->mChannelCount = channelCount;
+                mStreamPlayer->mReadAhead = streamReadAhead;
+                mStreamPlayer->mMaxSpeed = maxSpeed;
+                if (!mStreamPlayer->init(errorState))
+                {
+                    errorState.fail("Failed to initialize SampleStreamPlayer");
+                    return false;
+                }
+            }
+            
+            // A voice that plays both resident and streamed entries mixes the looper and the stream player
+            AudioObject* source = mSampleLooper != nullptr ? static_cast<AudioObject*>(mSampleLooper.get()) : mStreamPlayer.get();
+            if (mSampleLooper != nullptr && mStreamPlayer != nullptr)
+            {
+                mMixer = std::make_unique<Mixer>();
+                mMixer->mID = "Mixer";
+                mMixer->mChannelCount = channelCount;
+                mMixer->mInputs.emplace_back(mSampleLooper.get());
+                mMixer->mInputs.emplace_back(mStreamPlayer.get());
+                if (!mMixer->init(errorState))
+                {
+                    errorState.fail("Failed to initialize Sampler " + getName());
+                    return false;
+                }
+                source = mMixer.get();
             }
             
 
@@ -79,7 +126,7 @@ namespace nap
             mGain = std::make_unique<Multiply>();
             mGain->mID = "Gain";
             mGain->mChannelCount = channelCount;
-            mGain->mInputs.emplace_back(mBufferLooper.get());
+            mGain->mInputs.emplace_back(source);
             mGain->mInputs.emplace_back(mEnvelope.get());
             if (!mGain->init(errorState))
             {
@@ -89,7 +136,12 @@ namespace nap
             
             mVoice = std::make_unique<Voice>();
             mVoice->mID = "Voice";
-            mVoice->mObjects.emplace_back(mBufferLooper.get());
+            if (mSampleLooper != nullptr)
+                mVoice->mObjects.emplace_back(mSampleLooper.get());
+            if (mStreamPlayer != nullptr)
+                mVoice->mObjects.emplace_back(mStreamPlayer.get());
+            if (mMixer != nullptr)
+                mVoice->mObjects.emplace_back(mMixer.get());
             mVoice->mObjects.emplace_back(mGain.get());
             mVoice->mObjects.emplace_back(mEnvelope.get());
             mVoice->mEnvelope = mEnvelope.get();
@@ -125,7 +177,7 @@ namespace nap
         
         VoiceInstance* SamplePlayerInstance::play(unsigned int samplerEntryIndex, TimeValue duration)
         {
-            if (samplerEntryIndex > mSamplerEntries.size())
+            if (samplerEntryIndex >= mSamplerEntries.size())
                 return nullptr;
 
             auto voice = mPolyphonicInstance->findFreeVoice();
@@ -134,11 +186,34 @@ namespace nap
 				Logger::warn("Failed to acquire free voice");
 				return nullptr;
 			}
-            auto bufferLooper = voice->getObject<BufferLooperInstance>("BufferLooper");
+            auto sampleLooper = voice->getObject<SampleLooperInstance>("SampleLooper");
+            auto streamPlayer = voice->getObject<SampleStreamPlayerInstance>("SampleStreamPlayer");
             auto& envelope = voice->getEnvelope();
+            auto& entry = mSamplerEntries[samplerEntryIndex];
+
+            // Playing replaces what the looper or the stream player played before, only the one that is not used has to be stopped
+            if (entry.isStreamed())
+            {
+                if (sampleLooper != nullptr)
+                    sampleLooper->stop();
+                auto& resource = *entry.mStreamResource;
+                SampleStream::Region region;
+                region.mBuffer = resource.getBuffer().get();
+                region.mStart = resource.toSamples(entry.mStart);
+                region.mLoop = entry.mLoop;
+                region.mLoopStart = resource.toSamples(entry.mLoopStart);
+                region.mLoopEnd = resource.toSamples(entry.mLoopEnd);
+                region.mCrossFade = resource.toSamples(entry.mCrossFadeTime);
+                streamPlayer->getNode().play(region, mPreloads[samplerEntryIndex], mtof(64.f + entry.mTranspose) / mtof(64.f));
+            }
+            else {
+                if (streamPlayer != nullptr)
+                    streamPlayer->stop();
+                sampleLooper->play(entry);
+            }
 
-            bufferLooper->reset();
-            bufferLooper->start(mSamplerEntries[samplerEntryIndex]);
+            voice->finishedSignal.disconnect(voiceFinishedSlot); // Disconnect first to avoid connecting to the same signal twice.
+            voice->finishedSignal.connect(voiceFinishedSlot);
             envelope.setEnvelopeData(mEnvelopeData);
 
             mPolyphonicInstance->play(voice, duration);
@@ -149,13 +224,21 @@ namespace nap
 
         void SamplePlayerInstance::stop(VoiceInstance* voice, TimeValue release)
         {
-            auto bufferLooper = voice->getObject<BufferLooperInstance>("BufferLooper");
             auto& envelope = voice->getEnvelope();
             if (release == 0.f)
                 envelope.stop(1.f);
             else
                 envelope.stop(release);
-//            bufferLooper->stop();
+        }
+
+
+        void SamplePlayerInstance::voiceFinished(VoiceInstance& voice)
+        {
+            // Called on the audio thread. The looper of the voice is no longer processed and is replaced by the next play(),
+            // the stream player is stopped through an atomic, so its I/O thread stops reading the buffer.
+            auto streamPlayer = voice.getObject<SampleStreamPlayerInstance>("SampleStreamPlayer");
+            if (streamPlayer != nullptr)
+                streamPlayer->stop();
         }
 
         
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <audio/object/bufferlooper.h>
+#include <audio/object/mixer.h>
+#include <audio/object/samplelooper.h>
+#include <audio/object/samplestreamplayer.h>
 
 namespace nap
 {
@@ -14,6 +17,9 @@ namespace nap
 
         /**
          * Object that plays back samples along with some metadata about start point, loop points and transposition
+         * Every voice plays resident entries with a single @SampleLooper, an envelope and a gain.
+         * Entries with a Stream instead of a Buffer are streamed from disk: only their first PreloadTime ms is kept in memory.
+         * Every voice then streams the rest of the sample, including its loop, into a stream slot of its own.
          */
         class NAPAPI SamplePlayer : public AudioObject
         {
@@ -32,7 +38,8 @@ namespace nap
             EnvelopeNode::Envelope mEnvelopeData;                       ///< Property: 'Envelope' Default envelope settings
             int mChannelCount = 1;                                      ///< Property: 'ChannelCount' Number of channels
             int mVoiceCount = 10;                                       ///< Property: 'VoiceCount' Number of voices in the pool.
-            ResourcePtr<EqualPowerTable> mEqualPowerTable = nullptr;    ///< Property: 'EqualPowerTable' Pointer to EqualPowerTable that will be used by crossfades and envelopes.
+            ResourcePtr<EqualPowerTable> mEqualPowerTable = nullptr;    ///< Property: 'EqualPowerTable' Pointer to EqualPowerTable that will be used by the envelopes of the voices. The loop crossfades are rendered by the loopers themselves.
+            TimeValue mStreamReadAhead = 500.f;                         ///< Property: 'StreamReadAhead' Time in ms that streamed entries are read ahead of their playback position.
             
         private:
             std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
@@ -53,14 +60,16 @@ namespace nap
 
             /**
              * @param sampleEntries Sample entries containing playback metadata that can be played by this sampler
-             * @param equalPowerTable EqualPowerTable that will be used by crossfades and envelopes
+             * @param equalPowerTable EqualPowerTable that will be used by the envelopes of the voices
              * @param envelopeData Default envelope data
              * @param channelCount Number of output channels of the sampler
+             * @param voiceCount Number of voices in the pool
+             * @param streamReadAhead Time in ms that streamed entries are read ahead of their playback position
              * @param nodeManager NodeManager this sampler runs on
              * @param errorState Contains error information if the init() fails
              * @return True on success
              */
-            bool init(SamplePlayer::SamplerEntries& sampleEntries, ResourcePtr<EqualPowerTable> equalPowerTable, EnvelopeNode::Envelope& envelopeData, int channelCount, int voiceCount, NodeManager& nodeManager, utility::ErrorState& errorState);
+            bool init(SamplePlayer::SamplerEntries& sampleEntries, ResourcePtr<EqualPowerTable> equalPowerTable, EnvelopeNode::Envelope& envelopeData, int channelCount, int voiceCount, TimeValue streamReadAhead, NodeManager& nodeManager, utility::ErrorState& errorState);
 
             // Inhrited from AudioObjectInstance
             OutputPin* getOutputForChannel(int channel) override { return mPolyphonicInstance->getOutputForChannel(channel); }
@@ -104,13 +113,20 @@ namespace nap
             
         private:
 			SamplePlayer::SamplerEntries mSamplerEntries;
+			std::vector<SafePtr<MultiSampleBuffer>> mPreloads; // Copy in memory of the start of every streamed entry, nullptr for entries played from memory
             EnvelopeNode::Envelope mEnvelopeData;
             
             std::unique_ptr<PolyphonicInstance> mPolyphonicInstance = nullptr;
             
+            // Stops the stream of a voice that has finished, so its buffer is not read anymore.
+            Slot<VoiceInstance&> voiceFinishedSlot = { this, &SamplePlayerInstance::voiceFinished };
+            void voiceFinished(VoiceInstance& voice);
+            
             // private resources
             std::unique_ptr<Envelope> mEnvelope = nullptr;
-            std::unique_ptr<BufferLooper> mBufferLooper = nullptr;
+            std::unique_ptr<SampleLooper> mSampleLooper = nullptr;
+            std::unique_ptr<SampleStreamPlayer> mStreamPlayer = nullptr;
+            std::unique_ptr<Mixer> mMixer = nullptr;
             std::unique_ptr<Multiply> mGain = nullptr;
             std::unique_ptr<Voice> mVoice = nullptr;
             std::unique_ptr<Polyphonic> mPolyphonic = nullptr;
@@ -0,0 +1,61 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "samplestreamplayer.h"
+
+RTTI_BEGIN_CLASS(nap::audio::SampleStreamPlayer)
+	RTTI_PROPERTY("ChannelCount", &nap::audio::SampleStreamPlayer::mChannelCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("ReadAhead", &nap::audio::SampleStreamPlayer::mReadAhead, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("MaxSpeed", &nap::audio::SampleStreamPlayer::mMaxSpeed, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Quality", &nap::audio::SampleStreamPlayer::mQuality, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::SampleStreamPlayerInstance)
+	RTTI_FUNCTION("play", &nap::audio::SampleStreamPlayerInstance::play)
+	RTTI_FUNCTION("stop", &nap::audio::SampleStreamPlayerInstance::stop)
+	RTTI_FUNCTION("isPlaying", &nap::audio::SampleStreamPlayerInstance::isPlaying)
+	RTTI_FUNCTION("getUnderrunCount", &nap::audio::SampleStreamPlayerInstance::getUnderrunCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> SampleStreamPlayer::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto instance = std::make_unique<SampleStreamPlayerInstance>();
+			if (!instance->init(mChannelCount, mReadAhead, mMaxSpeed, mQuality, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize SampleStreamPlayerInstance");
+				return nullptr;
+			}
+
+			return std::move(instance);
+		}
+
+
+		bool SampleStreamPlayerInstance::init(int channelCount, TimeValue readAhead, ControllerValue maxSpeed, PolyphaseResampler::Quality quality, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (!errorState.check(channelCount > 0, "SampleStreamPlayer: Channel count has to be at least 1"))
+				return false;
+
+			mNode = nodeManager.makeSafe<SampleStreamPlayerNode>(nodeManager, channelCount, readAhead, maxSpeed);
+			mNode->setQuality(quality);
+			return true;
+		}
+
+
+		void SampleStreamPlayerInstance::play(MappedSampleResource& sample, TimeValue start, TimeValue preload, ControllerValue speed)
+		{
+			SampleStream::Region region;
+			region.mBuffer = sample.getBuffer().get();
+			region.mStart = sample.toSamples(start);
+			mNode->play(region, sample.preload(start, preload), speed);
+		}
+
+	}
+
+}
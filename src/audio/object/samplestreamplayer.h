@@ -0,0 +1,105 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/samplestreamplayernode.h>
+#include <audio/resource/mappedsampleresource.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Plays @MappedSampleResource samples with a single @SampleStreamPlayerNode, streaming everything after the preloaded start of a sample.
+		 * Meant as a sampler voice: the stream slot of the node is reused by every sample it plays.
+		 */
+		class NAPAPI SampleStreamPlayer : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			SampleStreamPlayer() = default;
+
+			int mChannelCount = 1;              ///< Property: 'ChannelCount' Number of channels
+			TimeValue mReadAhead = 500.f;       ///< Property: 'ReadAhead' Time in ms that is streamed ahead of the playback position.
+			ControllerValue mMaxSpeed = 2.f;    ///< Property: 'MaxSpeed' Maximum playback speed, the read ahead is scaled by it.
+			PolyphaseResampler::Quality mQuality = PolyphaseResampler::Quality::Medium; ///< Property: 'Quality' Quality of the resampling when the sample rate or speed differs.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of SampleStreamPlayer
+		 */
+		class NAPAPI SampleStreamPlayerInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			SampleStreamPlayerInstance() = default;
+			SampleStreamPlayerInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the instance
+			 * @param channelCount Number of channels
+			 * @param readAhead Time in ms that is streamed ahead of the playback position.
+			 * @param maxSpeed Maximum playback speed
+			 * @param quality Quality of the resampling
+			 * @param nodeManager The NodeManager the node runs on
+			 * @param errorState Logs errors during the initialization process
+			 * @return True on success
+			 */
+			bool init(int channelCount, TimeValue readAhead, ControllerValue maxSpeed, PolyphaseResampler::Quality quality, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			// Inherited from AudioObjectInstance
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->getOutput(channel); }
+			int getChannelCount() const override { return mNode->getChannelCount(); }
+
+			/**
+			 * Plays a sample from a start position to its end.
+			 * @param sample The sample
+			 * @param start Start position in ms
+			 * @param preload Time in ms after the start position that is played from a copy in memory, see MappedSampleResource::preload().
+			 * The copy is made by the first call for a start position and preload time, preload them on load to keep that off the first play().
+			 * @param speed Playback speed
+			 */
+			void play(MappedSampleResource& sample, TimeValue start, TimeValue preload, ControllerValue speed);
+
+			/**
+			 * Stops playback.
+			 */
+			void stop() { mNode->stop(); }
+
+			/**
+			 * @return Whether a sample is playing.
+			 */
+			bool isPlaying() const { return mNode->isPlaying(); }
+
+			/**
+			 * @return The number of times playback faded out because the stream ran dry.
+			 */
+			int getUnderrunCount() const { return mNode->getUnderrunCount(); }
+
+			/**
+			 * @return The node that plays the samples
+			 */
+			SampleStreamPlayerNode& getNode() { return *mNode; }
+
+		private:
+			SafeOwner<SampleStreamPlayerNode> mNode = nullptr;
+		};
+
+	}
+
+}
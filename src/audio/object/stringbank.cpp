@@ -0,0 +1,81 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "stringbank.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::StringBank)
+	RTTI_PROPERTY("StringCount", &nap::audio::StringBank::mStringCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("LowestFrequency", &nap::audio::StringBank::mLowestFrequency, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Input", &nap::audio::StringBank::mInput, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Frequencies", &nap::audio::StringBank::mFrequencies, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Damping", &nap::audio::StringBank::mDamping, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Feedback", &nap::audio::StringBank::mFeedback, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::StringBankInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::StringBankInstance::getNode)
+	RTTI_FUNCTION("pluck", &nap::audio::StringBankInstance::pluck)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Returns the value for a string, repeating the last value for strings without an entry
+		static ControllerValue getStringValue(const std::vector<ControllerValue>& values, int string, ControllerValue defaultValue)
+		{
+			if (values.empty())
+				return defaultValue;
+			return values[std::min<size_t>(string, values.size() - 1)];
+		}
+
+
+		std::unique_ptr<AudioObjectInstance> StringBank::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			auto result = std::make_unique<StringBankInstance>();
+			if (!result->init(mStringCount, mLowestFrequency, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize StringBank: %s", mID.c_str());
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			for (auto string = 0; string < mStringCount; ++string)
+			{
+				node->setFrequency(string, getStringValue(mFrequencies, string, 440.f));
+				node->setDamping(string, getStringValue(mDamping, string, 5000.f));
+				node->setFeedback(string, getStringValue(mFeedback, string, 0.99f));
+			}
+
+			if (mInput != nullptr)
+				node->audioInput.connect(*mInput->getInstance()->getOutputForChannel(0));
+
+			return result;
+		}
+
+
+		bool StringBankInstance::init(int stringCount, ControllerValue lowestFrequency, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (stringCount < 1)
+			{
+				errorState.fail("StringBank needs at least one string");
+				return false;
+			}
+			if (lowestFrequency <= 0.f)
+			{
+				errorState.fail("StringBank lowest frequency has to be larger than 0");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<StringBankNode>(nodeManager, stringCount, lowestFrequency);
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,90 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/stringbanknode.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Bank of plucked strings processed by a single @StringBankNode, with a mono output.
+		 * Strings are played with StringBankInstance::pluck(), an input object can excite all strings as well.
+		 */
+		class NAPAPI StringBank : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			StringBank() = default;
+
+			int mStringCount = 8;                               ///< Property: 'StringCount' Number of strings.
+			ControllerValue mLowestFrequency = 20.f;            ///< Property: 'LowestFrequency' Lowest frequency in Hz the strings can be tuned to.
+			ResourcePtr<AudioObject> mInput = nullptr;          ///< Property: 'Input' Optional audio object whose first channel excites all strings.
+			std::vector<ControllerValue> mFrequencies;          ///< Property: 'Frequencies' Frequency in Hz per string. Strings without an entry repeat the last one.
+			std::vector<ControllerValue> mDamping = { 5000.f }; ///< Property: 'Damping' Cutoff frequency in Hz of the lowpass in the feedback loop per string. Strings without an entry repeat the last one.
+			std::vector<ControllerValue> mFeedback = { 0.99f }; ///< Property: 'Feedback' Gain of the feedback loop per string. Strings without an entry repeat the last one.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of StringBank
+		 */
+		class NAPAPI StringBankInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			StringBankInstance() = default;
+			StringBankInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the StringBankInstance
+			 * @param stringCount Number of strings
+			 * @param lowestFrequency Lowest frequency in Hz the strings can be tuned to
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int stringCount, ControllerValue lowestFrequency, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that processes the strings.
+			 */
+			StringBankNode* getNode() { return mNode.getRaw(); }
+
+			/**
+			 * Plucks a string, see StringBankNode::pluck().
+			 * @param string Index of the string
+			 * @param amplitude Amplitude of the pluck
+			 * @param brightness Between 0 and 1
+			 */
+			void pluck(int string, ControllerValue amplitude, ControllerValue brightness) { mNode->pluck(string, amplitude, brightness); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return 1; }
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->audioOutput; }
+			void connect(unsigned int channel, OutputPin& pin) override { mNode->audioInput.connect(pin); }
+			int getInputChannelCount() const override { return 1; }
+
+		private:
+			SafeOwner<StringBankNode> mNode = nullptr;
+		};
+
+	}
+
+}
@@ -0,0 +1,82 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "unisonoscillator.h"
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+RTTI_BEGIN_CLASS(nap::audio::UnisonOscillator)
+	RTTI_PROPERTY("WaveTable", &nap::audio::UnisonOscillator::mWaveTable, nap::rtti::EPropertyMetaData::Required)
+	RTTI_PROPERTY("Frequency", &nap::audio::UnisonOscillator::mFrequency, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Amplitude", &nap::audio::UnisonOscillator::mAmplitude, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("VoiceCount", &nap::audio::UnisonOscillator::mVoiceCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Detune", &nap::audio::UnisonOscillator::mDetune, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("Spread", &nap::audio::UnisonOscillator::mSpread, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("StereoWidth", &nap::audio::UnisonOscillator::mStereoWidth, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("ChannelCount", &nap::audio::UnisonOscillator::mChannelCount, nap::rtti::EPropertyMetaData::Default)
+	RTTI_PROPERTY("FmInput", &nap::audio::UnisonOscillator::mFmInput, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::UnisonOscillatorInstance)
+	RTTI_FUNCTION("getNode", &nap::audio::UnisonOscillatorInstance::getNode)
+	RTTI_FUNCTION("getChannelCount", &nap::audio::UnisonOscillatorInstance::getChannelCount)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		std::unique_ptr<AudioObjectInstance> UnisonOscillator::createInstance(NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (mVoiceCount < 1 || mVoiceCount > UnisonOscillatorNode::MaxVoiceCount)
+			{
+				errorState.fail("Invalid voice count for UnisonOscillator: %s", mID.c_str());
+				return nullptr;
+			}
+
+			if (!mWaveTable->getWave()->isPowerOfTwo())
+			{
+				errorState.fail("WaveTable size of UnisonOscillator has to be a power of two: %s", mID.c_str());
+				return nullptr;
+			}
+
+			auto result = std::make_unique<UnisonOscillatorInstance>();
+			if (!result->init(mChannelCount, nodeManager, errorState))
+			{
+				errorState.fail("Failed to initialize UnisonOscillator");
+				return nullptr;
+			}
+
+			auto node = result->getNode();
+			node->setWave(mWaveTable->getWave());
+			node->setFrequency(mFrequency);
+			node->setAmplitude(mAmplitude);
+			node->setVoiceCount(mVoiceCount);
+			node->setDetune(mDetune);
+			node->setSpread(mSpread);
+			node->setStereoWidth(mStereoWidth);
+			if (mFmInput != nullptr)
+				node->fmInput.connect(*mFmInput->getInstance()->getOutputForChannel(0));
+
+			return result;
+		}
+
+
+		bool UnisonOscillatorInstance::init(int channelCount, NodeManager& nodeManager, utility::ErrorState& errorState)
+		{
+			if (channelCount < 1)
+			{
+				errorState.fail("UnisonOscillator needs at least one channel");
+				return false;
+			}
+			mNode = nodeManager.makeSafe<UnisonOscillatorNode>(nodeManager, channelCount);
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,81 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resourceptr.h>
+
+// Audio includes
+#include <audio/core/audioobject.h>
+#include <audio/node/unisonoscillatornode.h>
+#include <audio/object/oscillator.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Unison oscillator object: a stack of detuned oscillators rendered by a single @UnisonOscillatorNode.
+		 * The voices are panned across the channels of the object.
+		 */
+		class NAPAPI UnisonOscillator : public AudioObject
+		{
+			RTTI_ENABLE(AudioObject)
+
+		public:
+			ResourcePtr<WaveTableResource> mWaveTable = nullptr; ///< property: 'WaveTable' The waveform of the voices, its size has to be a power of two.
+			ControllerValue mFrequency = 220.f;                  ///< property: 'Frequency' Center frequency in Hz.
+			ControllerValue mAmplitude = 1.f;                    ///< property: 'Amplitude' Amplitude of the summed voices.
+			int mVoiceCount = 7;                                 ///< property: 'VoiceCount' Number of voices, up to 16.
+			ControllerValue mDetune = 0.2f;                      ///< property: 'Detune' Detuning of the outermost voices in semitones.
+			ControllerValue mSpread = 0.5f;                      ///< property: 'Spread' Level of the detuned voices relative to the center, between 0 and 1.
+			ControllerValue mStereoWidth = 1.f;                  ///< property: 'StereoWidth' Panning width of the voices across the channels, between 0 and 1.
+			int mChannelCount = 2;                               ///< property: 'ChannelCount' Number of channels the voices are panned across.
+			ResourcePtr<AudioObject> mFmInput = nullptr;         ///< property: 'FmInput' Optional audio object of which the first channel modulates the frequency.
+
+		private:
+			std::unique_ptr<AudioObjectInstance> createInstance(NodeManager& nodeManager, utility::ErrorState& errorState) override;
+		};
+
+
+		/**
+		 * Instance of UnisonOscillator
+		 */
+		class NAPAPI UnisonOscillatorInstance : public AudioObjectInstance
+		{
+			RTTI_ENABLE(AudioObjectInstance)
+
+		public:
+			UnisonOscillatorInstance() = default;
+			UnisonOscillatorInstance(const std::string& name) : AudioObjectInstance(name) { }
+
+			/**
+			 * Initialize the UnisonOscillatorInstance
+			 * @param channelCount Number of channels the voices are panned across
+			 * @param nodeManager The NodeManager this object will process on
+			 * @param errorState Logs errors during initialization
+			 * @return True on success
+			 */
+			bool init(int channelCount, NodeManager& nodeManager, utility::ErrorState& errorState);
+
+			/**
+			 * @return The node that renders the voices.
+			 */
+			UnisonOscillatorNode* getNode() { return mNode.getRaw(); }
+
+			// Inherited from AudioObjectInstance
+			int getChannelCount() const override { return mNode->getChannelCount(); }
+			OutputPin* getOutputForChannel(int channel) override { return &mNode->getOutput(channel); }
+
+		private:
+			SafeOwner<UnisonOscillatorNode> mNode = nullptr;
+		};
+
+	}
+
+}
@@ -17,11 +17,26 @@ RTTI_BEGIN_ENUM(nap::audio::AudioFileDescriptor::Mode)
     RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::Mode::READWRITE, "ReadWrite")
 RTTI_END_ENUM
 
+RTTI_BEGIN_ENUM(nap::audio::AudioFileDescriptor::FileFormat)
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::FileFormat::WAV, "WAV"),
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::FileFormat::RF64, "RF64"),
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::FileFormat::FLAC, "FLAC")
+RTTI_END_ENUM
+
+RTTI_BEGIN_ENUM(nap::audio::AudioFileDescriptor::SampleFormat)
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::SampleFormat::FLOAT32, "Float32"),
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::SampleFormat::PCM16, "PCM16"),
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::SampleFormat::PCM24, "PCM24"),
+    RTTI_ENUM_VALUE(nap::audio::AudioFileDescriptor::SampleFormat::PCM32, "PCM32")
+RTTI_END_ENUM
+
 RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::AudioFileIO)
     RTTI_CONSTRUCTOR(nap::Core&)
     RTTI_PROPERTY("Path", &nap::audio::AudioFileIO::mPath, nap::rtti::EPropertyMetaData::FileLink)
     RTTI_PROPERTY("Mode", &nap::audio::AudioFileIO::mMode, nap::rtti::EPropertyMetaData::Required)
     RTTI_PROPERTY("ChannelCount", &nap::audio::AudioFileIO::mChannelCount, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("FileFormat", &nap::audio::AudioFileIO::mFileFormat, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("SampleFormat", &nap::audio::AudioFileIO::mSampleFormat, nap::rtti::EPropertyMetaData::Default)
 RTTI_END_CLASS
 
 namespace nap
@@ -30,7 +45,7 @@ namespace nap
     namespace audio
     {
 
-        AudioFileDescriptor::AudioFileDescriptor(const std::string& path, Mode mode, int channelCount, float sampleRate)
+        AudioFileDescriptor::AudioFileDescriptor(const std::string& path, Mode mode, int channelCount, float sampleRate, FileFormat fileFormat, SampleFormat sampleFormat)
         {
             mMode = mode;
             SF_INFO sfInfo;
@@ -39,6 +54,19 @@ namespace nap
             {
                 sfInfo.channels = channelCount;
                 sfInfo.samplerate = sampleRate;
+                switch (fileFormat)
+                {
+                    case FileFormat::WAV: sfInfo.format = SF_FORMAT_WAV; break;
+                    case FileFormat::RF64: sfInfo.format = SF_FORMAT_RF64; break;
+                    case FileFormat::FLAC: sfInfo.format = SF_FORMAT_FLAC; break;
+                }
+                switch (sampleFormat)
+                {
+                    case SampleFormat::FLOAT32: sfInfo.format |= SF_FORMAT_FLOAT; break;
+                    case SampleFormat::PCM16: sfInfo.format |= SF_FORMAT_PCM_16; break;
+                    case SampleFormat::PCM24: sfInfo.format |= SF_FORMAT_PCM_24; break;
+                    case SampleFormat::PCM32: sfInfo.format |= SF_FORMAT_PCM_32; break;
+                }
             }
             int libSndFileMode;
             if (mode == Mode::WRITE)
@@ -50,6 +78,11 @@ namespace nap
             mSndFile = sf_open(path.c_str(), libSndFileMode, &sfInfo);
             mSampleRate = sfInfo.samplerate;
             mChannelCount = sfInfo.channels;
+            mFrameCount = mSndFile != nullptr ? sfInfo.frames : 0;
+
+            // Clip instead of wrapping around when writing floats out of range to integer formats
+            if (mSndFile != nullptr)
+                sf_command(mSndFile, SFC_SET_CLIPPING, nullptr, SF_TRUE);
         }
 
 
@@ -59,7 +92,7 @@ namespace nap
         }
 
 
-        unsigned int AudioFileDescriptor::write(float* buffer, int size)
+        unsigned int AudioFileDescriptor::write(const float* buffer, int size)
         {
             return sf_write_float(mSndFile, buffer, size);
         }
@@ -88,7 +121,13 @@ namespace nap
 
         bool AudioFileIO::init(utility::ErrorState& errorState)
         {
-            mAudioFileDescriptor = mNodeManager->makeSafe<AudioFileDescriptor>(mPath, mMode, mChannelCount, mNodeManager->getSampleRate());
+            if (mFileFormat == AudioFileDescriptor::FileFormat::FLAC && mSampleFormat != AudioFileDescriptor::SampleFormat::PCM16 && mSampleFormat != AudioFileDescriptor::SampleFormat::PCM24)
+            {
+                errorState.fail("%s: FLAC files only support the PCM16 and PCM24 sample formats", mID.c_str());
+                return false;
+            }
+
+            mAudioFileDescriptor = mNodeManager->makeSafe<AudioFileDescriptor>(mPath, mMode, mChannelCount, mNodeManager->getSampleRate(), mFileFormat, mSampleFormat);
 
             if (!mAudioFileDescriptor->isValid())
             {
@@ -30,6 +30,17 @@ namespace nap
         public:
             enum class Mode { READ, WRITE, READWRITE };
 
+            /**
+             * Container of files that are created for writing.
+             * RF64 is a WAV file that can grow beyond 4 GB, as needed for long multichannel recordings.
+             */
+            enum class FileFormat { WAV, RF64, FLAC };
+
+            /**
+             * Encoding of the samples in files that are created for writing. FLAC supports PCM16 and PCM24.
+             */
+            enum class SampleFormat { FLOAT32, PCM16, PCM24, PCM32 };
+
         public:
             /**
              * Constructor
@@ -37,8 +48,10 @@ namespace nap
              * @param mode Indicating if the file is opened for reading, created for writing of opened for reading and writing
              * @param channelCount Number of channels if the file is created for writing (Mode::WRITE)
              * @param sampleRate Samplerate if the file is created for writing (Mode::WRITE)
+             * @param fileFormat Container if the file is created for writing (Mode::WRITE)
+             * @param sampleFormat Sample encoding if the file is created for writing (Mode::WRITE)
              */
-            AudioFileDescriptor(const std::string& path, Mode mode, int channelCount = 1, float sampleRate = 44100.f);
+            AudioFileDescriptor(const std::string& path, Mode mode, int channelCount = 1, float sampleRate = 44100.f, FileFormat fileFormat = FileFormat::WAV, SampleFormat sampleFormat = SampleFormat::FLOAT32);
             ~AudioFileDescriptor();
 
             /**
@@ -48,11 +61,12 @@ namespace nap
 
             /**
              * Writes multichannel interleaved data to the file.
+             * Samples are clipped to the range of integer sample formats.
              * @param buffer A vector containing multichannel interleaved audio sample data.
              * @param size The size of the buffer is required to be a multiple of the number of channels in the file.
              * @return The number of samples written
              */
-            unsigned int write(float* buffer, int size);
+            unsigned int write(const float* buffer, int size);
 
             /**
              * Reads multichannel interleaved data from the file.
@@ -63,7 +77,7 @@ namespace nap
             unsigned int read(float* buffer, int size);
 
             /**
-             * Moves the read/write position to the given offset.
+             * Moves the read/write position to the given offset in frames.
              */
             void seek(DiscreteTimeValue offset);
 
@@ -77,6 +91,11 @@ namespace nap
              */
             float getSampleRate() const { return mSampleRate; }
 
+            /**
+             * @return The length of the audio file in frames when it was opened
+             */
+            DiscreteTimeValue getFrameCount() const { return mFrameCount; }
+
             /**
              * @return If the file is opened for reading, writing or both
              */
@@ -86,6 +105,7 @@ namespace nap
             SNDFILE* mSndFile;
             int mChannelCount = 1;
             float mSampleRate = 44100.f;
+            DiscreteTimeValue mFrameCount = 0;
             Mode mMode = Mode::WRITE;
         };
 
@@ -105,6 +125,8 @@ namespace nap
             std::string mPath = "";                                             ///< Property: 'Path' Path to the audio file
             AudioFileDescriptor::Mode mMode = AudioFileDescriptor::Mode::WRITE; ///< Property: 'Mode' Indicates if the file is opened for reading, writing or both
             int mChannelCount = 1;                                              ///< Property: 'ChannelCount' Number of channels if the files is created for writing.
+            AudioFileDescriptor::FileFormat mFileFormat = AudioFileDescriptor::FileFormat::WAV;             ///< Property: 'FileFormat' Container if the file is created for writing.
+            AudioFileDescriptor::SampleFormat mSampleFormat = AudioFileDescriptor::SampleFormat::FLOAT32;   ///< Property: 'SampleFormat' Sample encoding if the file is created for writing.
 
             /**
              * @return Pointer to the audio file descriptor to perform reading or writing
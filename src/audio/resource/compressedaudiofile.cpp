@@ -0,0 +1,51 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "compressedaudiofile.h"
+
+// Audio includes
+#include <audio/resource/audiofileio.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::CompressedAudioFile)
+    RTTI_CONSTRUCTOR(nap::Core&)
+    RTTI_PROPERTY("AudioFilePath", &nap::audio::CompressedAudioFile::mAudioFilePath, nap::rtti::EPropertyMetaData::FileLink | nap::rtti::EPropertyMetaData::Required)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+    namespace audio
+    {
+
+        bool CompressedAudioFile::init(utility::ErrorState& errorState)
+        {
+            AudioFileDescriptor audioFile(mAudioFilePath, AudioFileDescriptor::Mode::READ);
+            if (!audioFile.isValid())
+            {
+                errorState.fail("%s: Failed to open audio file %s", mID.c_str(), mAudioFilePath.c_str());
+                return false;
+            }
+
+            // Interleaved chunks are encoded channel by channel
+            const int chunkSize = 4096;
+            auto channelCount = audioFile.getChannelCount();
+            std::vector<float> chunk(size_t(chunkSize) * channelCount);
+            mBuffer = mNodeManager->makeSafe<CompressedSampleBuffer>(channelCount, audioFile.getFrameCount(), audioFile.getSampleRate(), mSampleFormat);
+            DiscreteTimeValue position = 0;
+            while (position < mBuffer->getSize())
+            {
+                auto count = int(audioFile.read(chunk.data(), chunkSize * channelCount) / channelCount);
+                if (count <= 0)
+                    break;
+                for (auto channel = 0; channel < channelCount; ++channel)
+                    mBuffer->write(channel, position, chunk.data() + channel, count, channelCount);
+                position += count;
+            }
+
+            return true;
+        }
+
+    }
+
+}
@@ -0,0 +1,36 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Audio includes
+#include <audio/resource/compressedbufferresource.h>
+
+namespace nap
+{
+
+    class Core;
+
+    namespace audio
+    {
+
+        /**
+         * Loads an audio file into memory as 16 or 24 bit integers, see @CompressedBufferResource.
+         * The file is decoded and encoded in chunks, so loading never holds the whole file as floats.
+         */
+        class NAPAPI CompressedAudioFile : public CompressedBufferResource {
+            RTTI_ENABLE(CompressedBufferResource)
+
+        public:
+            CompressedAudioFile(Core& core) : CompressedBufferResource(core) { }
+
+            // Inherited from Resource
+            bool init(utility::ErrorState& errorState) override;
+
+            std::string mAudioFilePath = "";    ///< Property: 'AudioFilePath' Path to the audio file
+        };
+
+    }
+
+}
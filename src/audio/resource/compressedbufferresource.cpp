@@ -0,0 +1,38 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "compressedbufferresource.h"
+
+// Audio includes
+#include <audio/service/audioservice.h>
+
+// Nap includes
+#include <nap/core.h>
+
+RTTI_BEGIN_ENUM(nap::audio::CompressedSampleBuffer::SampleFormat)
+    RTTI_ENUM_VALUE(nap::audio::CompressedSampleBuffer::SampleFormat::PCM16, "PCM16"),
+    RTTI_ENUM_VALUE(nap::audio::CompressedSampleBuffer::SampleFormat::PCM24, "PCM24")
+RTTI_END_ENUM
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::CompressedBufferResource)
+    RTTI_CONSTRUCTOR(nap::Core&)
+    RTTI_PROPERTY("SampleFormat", &nap::audio::CompressedBufferResource::mSampleFormat, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+    namespace audio
+    {
+
+        CompressedBufferResource::CompressedBufferResource(Core& core) : Resource()
+        {
+            auto audioService = core.getService<AudioService>();
+            assert(audioService != nullptr);
+            mNodeManager = &audioService->getNodeManager();
+        }
+
+    }
+
+}
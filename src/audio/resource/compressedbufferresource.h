@@ -0,0 +1,77 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resource.h>
+#include <rtti/factory.h>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/compressedsamplebuffer.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+    class Core;
+
+    namespace audio
+    {
+
+        /**
+         * Resource holding a @CompressedSampleBuffer: audio in memory stored as 16 or 24 bit integers instead of floats.
+         * The counterpart of AudioBufferResource for large resident sample sets, played by a @CompressedBufferPlayer,
+         * or as the CompressedBuffer of BufferLooper settings by a @SampleLooper and the voices of a @SamplePlayer.
+         * Use a @CompressedAudioFile to load an audio file into it.
+         */
+        class NAPAPI CompressedBufferResource : public Resource {
+            RTTI_ENABLE(Resource)
+
+        public:
+            CompressedBufferResource(Core& core);
+
+            CompressedSampleBuffer::SampleFormat mSampleFormat = CompressedSampleBuffer::SampleFormat::PCM16; ///< Property: 'SampleFormat' Encoding of the samples in memory, PCM16 halves the memory of float samples, PCM24 takes three quarters.
+
+            /**
+             * @return Pointer to the buffer that can be played from.
+             */
+            SafePtr<CompressedSampleBuffer> getBuffer() { return mBuffer; }
+
+            /**
+             * @return The number of frames per channel.
+             */
+            DiscreteTimeValue getSize() const { return mBuffer->getSize(); }
+
+            /**
+             * @return The number of channels.
+             */
+            int getChannelCount() const { return mBuffer->getChannelCount(); }
+
+            /**
+             * @return The sample rate of the samples.
+             */
+            float getSampleRate() const { return mBuffer->getSampleRate(); }
+
+            /**
+             * @param milliseconds Time in ms
+             * @return The time in frames at the sample rate of the buffer.
+             */
+            DiscreteTimeValue toSamples(TimeValue milliseconds) const { return DiscreteTimeValue(std::max(milliseconds, 0.f) * getSampleRate() / 1000.f); }
+
+            /**
+             * @param samples Time in frames at the sample rate of the buffer.
+             * @return The time in ms
+             */
+            TimeValue toMilliseconds(DiscreteTimeValue samples) const { return samples * 1000.f / getSampleRate(); }
+
+        protected:
+            NodeManager* mNodeManager = nullptr;
+            SafeOwner<CompressedSampleBuffer> mBuffer = nullptr;
+        };
+
+    }
+
+}
@@ -0,0 +1,114 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "mappedaudiofile.h"
+
+// Std includes
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+
+// Audio includes
+#include <audio/resource/audiofileio.h>
+
+// Nap includes
+#include <utility/fileutils.h>
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MappedAudioFile)
+    RTTI_CONSTRUCTOR(nap::Core&)
+    RTTI_PROPERTY("CacheDirectory", &nap::audio::MappedAudioFile::mCacheDirectory, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("SampleFormat", &nap::audio::MappedAudioFile::mSampleFormat, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+    namespace audio
+    {
+
+        bool MappedAudioFile::init(utility::ErrorState& errorState)
+        {
+            // Convert when the sample file is missing or older than the audio file
+            auto samplePath = getSampleFilePath();
+            std::error_code error;
+            auto sourceTime = std::filesystem::last_write_time(mPath, error);
+            bool sourceExists = !error;
+            auto sampleTime = std::filesystem::last_write_time(samplePath, error);
+            bool sampleExists = !error;
+            if (!sourceExists && !sampleExists)
+            {
+                errorState.fail("%s: Neither the audio file %s nor the sample file %s exists", mID.c_str(), mPath.c_str(), samplePath.c_str());
+                return false;
+            }
+
+            mBuffer = mNodeManager->makeSafe<MappedSampleBuffer>();
+            bool converted = false;
+            if (sourceExists && (!sampleExists || sampleTime < sourceTime))
+            {
+                if (!convert(samplePath, errorState))
+                    return false;
+                converted = true;
+            }
+            if (!errorState.check(mBuffer->open(samplePath, errorState), "%s: Failed to load sample file", mID.c_str()))
+                return false;
+
+            // A sample file in another format is converted again, unless it is all there is
+            if (!converted && sourceExists && mBuffer->getSampleFormat() != mSampleFormat)
+            {
+                mBuffer->close();
+                if (!convert(samplePath, errorState) || !mBuffer->open(samplePath, errorState))
+                    return false;
+            }
+
+            return MappedSampleResource::init(errorState);
+        }
+
+
+        std::string MappedAudioFile::getSampleFilePath() const
+        {
+            if (mCacheDirectory.empty())
+                return mPath + ".napsamples";
+
+            // Audio files with the same name in different directories share the cache directory, so the name is followed by a hash of the full path.
+            // FNV-1a is used because it gives the same hash on every platform and in every run.
+            std::error_code error;
+            auto path = std::filesystem::weakly_canonical(mPath, error);
+            if (error)
+                path = mPath;
+            uint64_t hash = 14695981039346656037ull;
+            for (auto c : path.generic_string())
+            {
+                hash ^= uint8_t(c);
+                hash *= 1099511628211ull;
+            }
+            char key[17];
+            std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+            return mCacheDirectory + "/" + path.filename().string() + "." + key + ".napsamples";
+        }
+
+
+        bool MappedAudioFile::convert(const std::string& samplePath, utility::ErrorState& errorState)
+        {
+            AudioFileDescriptor audioFile(mPath, AudioFileDescriptor::Mode::READ);
+            if (!audioFile.isValid())
+            {
+                errorState.fail("%s: Failed to open audio file %s", mID.c_str(), mPath.c_str());
+                return false;
+            }
+            if (!mCacheDirectory.empty() && !utility::makeDirs(mCacheDirectory))
+            {
+                errorState.fail("%s: Failed to create cache directory %s", mID.c_str(), mCacheDirectory.c_str());
+                return false;
+            }
+
+            auto channelCount = audioFile.getChannelCount();
+            auto reader = [&audioFile, channelCount](float* destination, int frameCount) {
+                return int(audioFile.read(destination, frameCount * channelCount) / channelCount);
+            };
+            return MappedSampleBuffer::create(samplePath, channelCount, audioFile.getFrameCount(), audioFile.getSampleRate(), mSampleFormat, reader, errorState);
+        }
+
+    }
+
+}
@@ -0,0 +1,48 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Audio includes
+#include <audio/resource/mappedsampleresource.h>
+
+namespace nap
+{
+
+    class Core;
+
+    namespace audio
+    {
+
+        /**
+         * Audio file that is played from a memory mapped sample file instead of being decoded into memory. Its Path is the path to the audio file.
+         * The audio file is converted to a sample file once, next to the audio file or in the cache directory, and converted again when the audio file changes.
+         * A sample file without the audio file it was converted from can be loaded as well, so a library can be shipped pre-converted.
+         */
+        class NAPAPI MappedAudioFile : public MappedSampleResource {
+            RTTI_ENABLE(MappedSampleResource)
+
+        public:
+            MappedAudioFile(Core& core) : MappedSampleResource(core) { }
+
+            // Inherited from Resource
+            bool init(utility::ErrorState& errorState) override;
+
+            std::string mCacheDirectory = "";           ///< Property: 'CacheDirectory' Optional directory for the sample file, by default it is stored next to the audio file. In the cache directory the sample file is named after the audio file and a hash of its full path, so pre-converted libraries should be shipped next to their audio files.
+            MappedSampleBuffer::SampleFormat mSampleFormat = MappedSampleBuffer::SampleFormat::Float32; ///< Property: 'SampleFormat' Encoding of the sample file, PCM16 halves its size.
+
+        protected:
+            /**
+             * @return Path of the sample file the audio file at Path is converted to.
+             */
+            std::string getSampleFilePath() const override;
+
+        private:
+            // Converts the audio file to the sample file
+            bool convert(const std::string& samplePath, utility::ErrorState& errorState);
+        };
+
+    }
+
+}
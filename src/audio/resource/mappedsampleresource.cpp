@@ -0,0 +1,84 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "mappedsampleresource.h"
+
+// Std includes
+#include <algorithm>
+
+// Audio includes
+#include <audio/service/audioservice.h>
+
+// Nap includes
+#include <nap/core.h>
+#include <nap/logger.h>
+
+RTTI_BEGIN_ENUM(nap::audio::MappedSampleBuffer::SampleFormat)
+    RTTI_ENUM_VALUE(nap::audio::MappedSampleBuffer::SampleFormat::Float32, "Float32"),
+    RTTI_ENUM_VALUE(nap::audio::MappedSampleBuffer::SampleFormat::PCM16, "PCM16")
+RTTI_END_ENUM
+
+RTTI_BEGIN_CLASS_NO_DEFAULT_CONSTRUCTOR(nap::audio::MappedSampleResource)
+    RTTI_CONSTRUCTOR(nap::Core&)
+    RTTI_PROPERTY("Path", &nap::audio::MappedSampleResource::mPath, nap::rtti::EPropertyMetaData::FileLink | nap::rtti::EPropertyMetaData::Required)
+    RTTI_PROPERTY("PrefaultTime", &nap::audio::MappedSampleResource::mPrefaultTime, nap::rtti::EPropertyMetaData::Default)
+    RTTI_PROPERTY("LockPrefault", &nap::audio::MappedSampleResource::mLockPrefault, nap::rtti::EPropertyMetaData::Default)
+RTTI_END_CLASS
+
+namespace nap
+{
+
+    namespace audio
+    {
+
+        MappedSampleResource::MappedSampleResource(Core& core) : Resource()
+        {
+            auto audioService = core.getService<AudioService>();
+            assert(audioService != nullptr);
+            mNodeManager = &audioService->getNodeManager();
+        }
+
+
+        bool MappedSampleResource::init(utility::ErrorState& errorState)
+        {
+            if (mBuffer == nullptr)
+                mBuffer = mNodeManager->makeSafe<MappedSampleBuffer>();
+            if (!mBuffer->isValid() && !errorState.check(mBuffer->open(getSampleFilePath(), errorState), "%s: Failed to load sample file", mID.c_str()))
+                return false;
+
+            // Copies of the previous sample file are released, voices that still play them keep them until they are done
+            mPreloads.clear();
+
+            prefault(0.f, mPrefaultTime);
+            return true;
+        }
+
+
+        void MappedSampleResource::prefault(TimeValue start, TimeValue duration)
+        {
+            if (!mBuffer->prefault(toSamples(start), toSamples(duration), mLockPrefault))
+                Logger::warn("%s: Failed to lock samples in memory", mID.c_str());
+        }
+
+
+        SafePtr<MultiSampleBuffer> MappedSampleResource::preload(TimeValue start, TimeValue duration)
+        {
+            auto first = std::min(toSamples(start), getSize());
+            auto count = std::min(toSamples(duration), getSize() - first);
+            auto key = std::make_pair(first, count);
+            auto it = mPreloads.find(key);
+            if (it != mPreloads.end())
+                return it->second;
+
+            auto copy = mNodeManager->makeSafe<MultiSampleBuffer>(getChannelCount(), count);
+            for (auto channel = 0; channel < getChannelCount(); ++channel)
+                mBuffer->read(channel, first, int(count), (*copy)[channel].data());
+            SafePtr<MultiSampleBuffer> result = copy;
+            mPreloads.emplace(key, std::move(copy));
+            return result;
+        }
+
+    }
+
+}
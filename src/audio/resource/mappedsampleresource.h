@@ -0,0 +1,111 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Nap includes
+#include <nap/resource.h>
+#include <rtti/factory.h>
+
+// Std includes
+#include <map>
+#include <utility>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+#include <audio/utility/mappedsamplebuffer.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+    class Core;
+
+    namespace audio
+    {
+
+        /**
+         * Sample file created by @MappedSampleBuffer::create() that is played from a memory mapping instead of being read into memory.
+         * On load only the first PrefaultTime ms of every channel is read from disk, the rest is read when it is played.
+         * Use a @MappedAudioFile to convert an audio file to a sample file on load.
+         */
+        class NAPAPI MappedSampleResource : public Resource {
+            RTTI_ENABLE(Resource)
+
+        public:
+            MappedSampleResource(Core& core);
+
+            // Inherited from Resource
+            bool init(utility::ErrorState& errorState) override;
+
+            std::string mPath = "";                     ///< Property: 'Path' Path to the sample file
+            TimeValue mPrefaultTime = 500.f;            ///< Property: 'PrefaultTime' Time in ms at the start of every channel that is read into memory on load.
+            bool mLockPrefault = false;                 ///< Property: 'LockPrefault' Keeps prefaulted sections in memory, so they are not paged out when memory runs low.
+
+            /**
+             * @return Pointer to the mapped buffer that can be played from.
+             */
+            SafePtr<MappedSampleBuffer> getBuffer() { return mBuffer; }
+
+            /**
+             * @return The number of frames per channel.
+             */
+            DiscreteTimeValue getSize() const { return mBuffer->getSize(); }
+
+            /**
+             * @return The number of channels.
+             */
+            int getChannelCount() const { return mBuffer->getChannelCount(); }
+
+            /**
+             * @return The sample rate of the sample file.
+             */
+            float getSampleRate() const { return mBuffer->getSampleRate(); }
+
+            /**
+             * @param milliseconds Time in ms
+             * @return The time in frames at the sample rate of the file.
+             */
+            DiscreteTimeValue toSamples(TimeValue milliseconds) const { return DiscreteTimeValue(std::max(milliseconds, 0.f) * getSampleRate() / 1000.f); }
+
+            /**
+             * @param samples Time in frames at the sample rate of the file.
+             * @return The time in ms
+             */
+            TimeValue toMilliseconds(DiscreteTimeValue samples) const { return samples * 1000.f / getSampleRate(); }
+
+            /**
+             * Reads a section of every channel into memory, for example the start of a sample that does not start at the beginning of the file.
+             * Locks the section when LockPrefault is set.
+             * @param start Start of the section in ms
+             * @param duration Duration of the section in ms
+             */
+            void prefault(TimeValue start, TimeValue duration);
+
+            /**
+             * Returns a copy in memory of a section of every channel, for example the start of a sample that has to play on the audio thread without waiting for the disk.
+             * Prefaulted pages of the mapping can be dropped by the system and then block the thread that reads them, the copy stays in memory like any other buffer.
+             * The copy is made by the first call for a section and shared by later calls, so call this on load for the sections that will be played.
+             * @param start Start of the section in ms
+             * @param duration Duration of the section in ms
+             * @return The copy, shorter than the duration when the section reaches the end of the sample.
+             */
+            SafePtr<MultiSampleBuffer> preload(TimeValue start, TimeValue duration);
+
+        protected:
+            /**
+             * @return Path of the sample file that is mapped.
+             */
+            virtual std::string getSampleFilePath() const { return mPath; }
+
+            NodeManager* mNodeManager = nullptr;
+            SafeOwner<MappedSampleBuffer> mBuffer = nullptr;
+
+        private:
+            std::map<std::pair<DiscreteTimeValue, DiscreteTimeValue>, SafeOwner<MultiSampleBuffer>> mPreloads; // Copies by first frame and frame count
+        };
+
+    }
+
+}
@@ -0,0 +1,265 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "audiofilestream.h"
+
+// Std includes
+#include <algorithm>
+#include <cassert>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		AudioFileStream::AudioFileStream(SafePtr<AudioFileDescriptor> file, unsigned int readAhead, int cueCount) : mFile(file)
+		{
+			assert(mFile != nullptr);
+			mChannelCount = std::max(mFile->getChannelCount(), 1);
+			mReadAhead = std::max(readAhead, 64u);
+
+			// Leave room for the frames that are being read while the read ahead frames are played
+			mCapacity = 1;
+			while (mCapacity < 2 * mReadAhead)
+				mCapacity *= 2;
+			mRing.resize(size_t(mCapacity) * mChannelCount, 0.f);
+
+			for (auto i = 0; i < cueCount; ++i)
+			{
+				auto cue = std::make_unique<Cue>();
+				cue->mData.resize(size_t(mReadAhead) * mChannelCount, 0.f);
+				mCues.emplace_back(std::move(cue));
+			}
+		}
+
+
+		void AudioFileStream::setCue(int index, DiscreteTimeValue frame)
+		{
+			auto& cue = *mCues[index];
+			cue.mReady = false;
+			cue.mFrame = frame;
+			cue.mPending = true;
+			mCuesPending = true;
+			wake();
+		}
+
+
+		unsigned int AudioFileStream::getAvailable() const
+		{
+			auto written = mWriteState.load(std::memory_order_acquire) & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_relaxed);
+			auto head = mHead != nullptr ? mHead->mFrameCount - mHeadPosition : 0;
+			return head + (written - consumed);
+		}
+
+
+		SampleValue AudioFileStream::getSample(unsigned int frame, int channel) const
+		{
+			if (mHead != nullptr)
+			{
+				auto head = mHead->mFrameCount - mHeadPosition;
+				if (frame < head)
+					return mHead->mData[size_t(mHeadPosition + frame) * mChannelCount + channel];
+				frame -= head;
+			}
+			auto index = (mConsumed.load(std::memory_order_relaxed) + frame) & (mCapacity - 1);
+			return mRing[index * mChannelCount + channel];
+		}
+
+
+		void AudioFileStream::consume(unsigned int frames)
+		{
+			if (mHead != nullptr)
+			{
+				auto head = std::min(frames, mHead->mFrameCount - mHeadPosition);
+				mHeadPosition += head;
+				frames -= head;
+				if (mHeadPosition == mHead->mFrameCount)
+					mHead = nullptr;
+			}
+			if (frames > 0)
+				mConsumed.store(mConsumed.load(std::memory_order_relaxed) + frames, std::memory_order_release);
+		}
+
+
+		void AudioFileStream::seek(DiscreteTimeValue frame)
+		{
+			mHead = nullptr;
+			startEpoch(frame);
+		}
+
+
+		void AudioFileStream::cue(int index)
+		{
+			auto& cue = *mCues[index];
+			if (!cue.mReady.load(std::memory_order_acquire))
+			{
+				seek(cue.mFrame.load());
+				return;
+			}
+
+			// Play the preloaded frames and continue reading the file after them
+			mHead = &cue;
+			mHeadPosition = 0;
+			auto next = cue.mFrame.load() + cue.mFrameCount;
+			auto frameCount = mFile->getFrameCount();
+			if (mLooping && frameCount > 0)
+				next %= frameCount;
+			startEpoch(next);
+		}
+
+
+		bool AudioFileStream::isEndReached() const
+		{
+			auto end = mEnd.load(std::memory_order_acquire);
+			auto state = mWriteState.load(std::memory_order_acquire);
+			return end != NoEnd && (end >> EpochShift) == (state >> EpochShift);
+		}
+
+
+		void AudioFileStream::startEpoch(DiscreteTimeValue frame)
+		{
+			mEnd.store(NoEnd, std::memory_order_relaxed);
+			mEpochFrame.store(frame, std::memory_order_relaxed);
+
+			// Frames that the I/O thread publishes for the previous epoch are rejected by the compare and swap
+			auto state = mWriteState.load(std::memory_order_relaxed);
+			uint64_t next;
+			do {
+				next = ((state >> EpochShift) + 1) << EpochShift | (state & FrameMask);
+			} while (!mWriteState.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+			// Everything written so far belongs to the previous epoch
+			mConsumed.store(next & FrameMask, std::memory_order_release);
+		}
+
+
+		void AudioFileStream::prepare()
+		{
+			while (needsRefill())
+				refill();
+		}
+
+
+		bool AudioFileStream::needsRefill() const
+		{
+			if (mCuesPending.load())
+				return true;
+
+			auto state = mWriteState.load(std::memory_order_acquire);
+			if ((state >> EpochShift) != mProducerEpoch)
+				return true;
+			if (mEndReached)
+				return false;
+
+			auto written = state & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_acquire);
+			return mCapacity - (written - consumed) >= std::min(mCapacity / 4, ChunkSize);
+		}
+
+
+		double AudioFileStream::getTimeToUnderrun() const
+		{
+			auto written = mWriteState.load(std::memory_order_acquire) & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_acquire);
+			return double(written - consumed) / std::max(mConsumptionRate.load(), 1.f);
+		}
+
+
+		void AudioFileStream::refill()
+		{
+			if (mCuesPending.exchange(false))
+				for (auto& cue : mCues)
+					if (cue->mPending.exchange(false))
+						loadCue(*cue);
+
+			auto state = mWriteState.load(std::memory_order_acquire);
+			if ((state >> EpochShift) != mProducerEpoch)
+			{
+				mProducerEpoch = state >> EpochShift;
+				mFilePosition = mEpochFrame.load(std::memory_order_relaxed);
+				mFileSeekNeeded = true;
+				mEndReached = false;
+			}
+			if (mEndReached)
+				return;
+
+			auto written = state & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_acquire);
+			auto frames = std::min<unsigned int>(mCapacity - (written - consumed), ChunkSize);
+			if (frames == 0)
+				return;
+
+			if (mFileSeekNeeded)
+			{
+				mFile->seek(mFilePosition);
+				mFileSeekNeeded = false;
+			}
+
+			// Read into the free part of the ring, which may wrap around its end
+			auto index = written & (mCapacity - 1);
+			auto first = std::min<unsigned int>(frames, mCapacity - index);
+			bool endReached = false;
+			auto count = readFile(&mRing[index * mChannelCount], first, endReached);
+			if (count == first && !endReached && frames > first)
+				count += readFile(&mRing[0], frames - first, endReached);
+
+			// Publish the frames, unless the audio thread has started a new epoch meanwhile
+			auto next = state + count;
+			if (!mWriteState.compare_exchange_strong(state, next, std::memory_order_release, std::memory_order_relaxed))
+			{
+				mFileSeekNeeded = true;
+				return;
+			}
+			if (endReached)
+			{
+				mEndReached = true;
+				mEnd.store(next, std::memory_order_release);
+			}
+		}
+
+
+		void AudioFileStream::loadCue(Cue& cue)
+		{
+			auto filePosition = mFilePosition;
+			mFilePosition = cue.mFrame.load();
+			mFile->seek(mFilePosition);
+			bool endReached = false;
+			cue.mFrameCount = readFile(cue.mData.data(), mReadAhead, endReached);
+			cue.mReady.store(true, std::memory_order_release);
+
+			mFilePosition = filePosition;
+			mFileSeekNeeded = true;
+		}
+
+
+		unsigned int AudioFileStream::readFile(SampleValue* destination, unsigned int frames, bool& endReached)
+		{
+			unsigned int result = 0;
+			while (result < frames)
+			{
+				auto requested = frames - result;
+				auto count = mFile->read(destination + size_t(result) * mChannelCount, requested * mChannelCount) / mChannelCount;
+				result += count;
+				mFilePosition += count;
+				if (count < requested)
+				{
+					if (mLooping && mFilePosition > 0)
+					{
+						mFile->seek(0);
+						mFilePosition = 0;
+					}
+					else {
+						endReached = true;
+						break;
+					}
+				}
+			}
+			return result;
+		}
+
+	}
+
+}
@@ -0,0 +1,188 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Audio includes
+#include <audio/resource/audiofileio.h>
+#include <audio/service/streamingservice.h>
+#include <audio/utility/safeptr.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Stream of interleaved frames from an audio file, filled ahead of playback by the I/O threads of the @StreamingService.
+		 * The frames are kept in a ring buffer that is lock free between the I/O thread that fills it and the audio thread that consumes it.
+		 *
+		 * Seeking is done by the audio thread and is immediate, the frames after the new position arrive with the next refill.
+		 * For positions that have to start without delay, cues can be set up front: the first frames after a cue are preloaded in memory,
+		 * so cue() can play them while the ring buffer refills behind them.
+		 *
+		 * Methods marked as audio thread methods should only be called by the single consumer of the stream.
+		 */
+		class NAPAPI AudioFileStream : public Stream
+		{
+		public:
+			/**
+			 * Constructor, use StreamingService::createStream() to create a stream that is filled.
+			 * @param file The audio file, opened for reading. Should not be used by anything else while the stream exists.
+			 * @param readAhead Number of frames read ahead of the playback position, also the length of the preloaded cue heads.
+			 * @param cueCount Number of cues that can be set.
+			 */
+			AudioFileStream(SafePtr<AudioFileDescriptor> file, unsigned int readAhead, int cueCount);
+
+			/**
+			 * @return Number of channels of the stream
+			 */
+			int getChannelCount() const { return mChannelCount; }
+
+			/**
+			 * @return Sample rate of the audio file
+			 */
+			float getSampleRate() const { return mFile->getSampleRate(); }
+
+			/**
+			 * @param looping Whether the stream continues from the start of the file after reaching its end.
+			 */
+			void setLooping(bool looping) { mLooping = looping; }
+
+			/**
+			 * @return Whether the stream continues from the start of the file after reaching its end.
+			 */
+			bool isLooping() const { return mLooping; }
+
+			/**
+			 * Sets a cue. The frames after the cue are preloaded by the I/O threads.
+			 * Cues are meant to be set before they are played, changing a cue while its preloaded frames are playing is not supported.
+			 * @param index Index of the cue, smaller than the cue count.
+			 * @param frame Frame in the file the cue points to.
+			 */
+			void setCue(int index, DiscreteTimeValue frame);
+
+			/**
+			 * @return The number of times the audio thread needed frames that had not been read from disk yet.
+			 */
+			int getUnderrunCount() const { return mUnderrunCount.load(); }
+
+			/**
+			 * Audio thread method.
+			 * @return Number of frames that can be read.
+			 */
+			unsigned int getAvailable() const;
+
+			/**
+			 * Audio thread method. Reads a sample without consuming it.
+			 * @param frame Frame relative to the read position, smaller than getAvailable().
+			 * @param channel Channel of the sample
+			 * @return The sample
+			 */
+			SampleValue getSample(unsigned int frame, int channel) const;
+
+			/**
+			 * Audio thread method. Advances the read position.
+			 * @param frames Number of frames, at most getAvailable().
+			 */
+			void consume(unsigned int frames);
+
+			/**
+			 * Audio thread method. Continues the stream at another position in the file.
+			 * @param frame Frame in the file
+			 */
+			void seek(DiscreteTimeValue frame);
+
+			/**
+			 * Audio thread method. Continues the stream at a cue, starting with its preloaded frames.
+			 * When the cue has not been preloaded yet this is the same as seeking to the cue.
+			 * @param index Index of the cue
+			 */
+			void cue(int index);
+
+			/**
+			 * Audio thread method.
+			 * @return Whether the stream does not loop and all frames up to the end of the file have been read from disk.
+			 */
+			bool isEndReached() const;
+
+			/**
+			 * Audio thread method. Counts an underrun, to be called when playback needed more frames than were available.
+			 */
+			void reportUnderrun() { mUnderrunCount++; }
+
+			/**
+			 * Audio thread method. Informs the I/O threads how fast the stream is consumed, so the streams closest to running dry are refilled first.
+			 * @param framesPerSecond Number of frames consumed per second
+			 */
+			void setConsumptionRate(float framesPerSecond) { mConsumptionRate = framesPerSecond; }
+
+		private:
+			// Frames after a cue that are preloaded in memory
+			struct Cue
+			{
+				std::atomic<DiscreteTimeValue> mFrame = { 0 };
+				std::vector<SampleValue> mData;
+				unsigned int mFrameCount = 0;
+				std::atomic<bool> mPending = { false }; // Set when the frames have to be loaded
+				std::atomic<bool> mReady = { false };
+			};
+
+			// The write state packs the seek epoch in the upper bits and the number of frames written in the lower bits,
+			// so the I/O thread can publish frames and detect a seek that happened meanwhile with one compare and swap.
+			static constexpr int EpochShift = 48;
+			static constexpr uint64_t FrameMask = (uint64_t(1) << EpochShift) - 1;
+			static constexpr uint64_t NoEnd = ~uint64_t(0);
+			static constexpr unsigned int ChunkSize = 4096; // Maximum number of frames read by one refill
+
+			// Fills the stream before it is served, so playback can start right away
+			void prepare() override;
+
+			// I/O thread methods, called by the service one at a time
+			bool needsRefill() const override;
+			double getTimeToUnderrun() const override;
+			void refill() override;
+			void loadCue(Cue& cue);
+			unsigned int readFile(SampleValue* destination, unsigned int frames, bool& endReached);
+
+			// Audio thread
+			void startEpoch(DiscreteTimeValue frame);
+
+			SafePtr<AudioFileDescriptor> mFile = nullptr;
+			int mChannelCount = 1;
+			unsigned int mCapacity = 0;                   // Size of the ring buffer in frames, a power of two
+			unsigned int mReadAhead = 0;
+			std::vector<SampleValue> mRing;               // Interleaved frames
+			std::vector<std::unique_ptr<Cue>> mCues;
+			std::atomic<bool> mCuesPending = { false };
+			std::atomic<bool> mLooping = { false };
+
+			// Shared between the audio thread and the I/O thread
+			std::atomic<uint64_t> mWriteState = { 0 };    // Epoch and frames written
+			std::atomic<uint64_t> mConsumed = { 0 };      // Frames consumed, written by the audio thread
+			std::atomic<uint64_t> mEnd = { NoEnd };       // Epoch and frames written when the end of the file was reached
+			std::atomic<DiscreteTimeValue> mEpochFrame = { 0 }; // Frame in the file where the current epoch starts
+			std::atomic<float> mConsumptionRate = { 44100.f };
+			std::atomic<int> mUnderrunCount = { 0 };
+
+			// Audio thread
+			const Cue* mHead = nullptr;                   // Cue whose preloaded frames are played before the ring buffer
+			unsigned int mHeadPosition = 0;
+
+			// I/O thread
+			uint64_t mProducerEpoch = 0;
+			DiscreteTimeValue mFilePosition = 0;
+			bool mFileSeekNeeded = true;
+			bool mEndReached = false;
+		};
+
+	}
+
+}
@@ -0,0 +1,203 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "samplestream.h"
+
+// Std includes
+#include <algorithm>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		SampleStream::SampleStream(int channelCount, unsigned int readAhead)
+		{
+			mChannelCount = std::max(channelCount, 1);
+
+			// Leave room for the frames that are being filled while the read ahead frames are played
+			mCapacity = 1;
+			while (mCapacity < 2 * std::max(readAhead, 64u))
+				mCapacity *= 2;
+			mRing.resize(size_t(mCapacity) * mChannelCount, 0.f);
+		}
+
+
+		void SampleStream::read(const Region& region, int channel, int64_t first, int count, float* destination)
+		{
+			auto buffer = region.mBuffer;
+			if (buffer == nullptr || channel >= buffer->getChannelCount())
+			{
+				std::fill(destination, destination + count, 0.f);
+				return;
+			}
+
+			struct Source
+			{
+				const MappedSampleBuffer& mBuffer;
+				int mChannel;
+				void read(int64_t first, int count, float* destination) const { mBuffer.read(mChannel, first, count, destination); }
+				float getSample(DiscreteTimeValue frame) const { return mBuffer.getSample(mChannel, frame); }
+			};
+			region.read(Source { *buffer, channel }, buffer->getSize(), first, count, destination);
+		}
+
+
+		DiscreteTimeValue SampleStream::getLength(const Region& region)
+		{
+			return region.getLength(region.mBuffer != nullptr ? region.mBuffer->getSize() : 0);
+		}
+
+
+		DiscreteTimeValue SampleStream::getLinearLength(const Region& region)
+		{
+			return region.getLinearLength(region.mBuffer != nullptr ? region.mBuffer->getSize() : 0);
+		}
+
+
+		void SampleStream::play(const Region& region, DiscreteTimeValue first)
+		{
+			mEnd.store(NoEnd, std::memory_order_relaxed);
+			first &= FrameMask;
+			mConsumed.store(first, std::memory_order_release);
+
+			// Publish the region before the epoch that belongs to it
+			auto sequence = mRegionSequence.load(std::memory_order_relaxed);
+			mRegionSequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			mRegionBuffer.store(region.mBuffer, std::memory_order_relaxed);
+			mRegionStart.store(region.mStart, std::memory_order_relaxed);
+			mRegionLoop.store(region.mLoop, std::memory_order_relaxed);
+			mRegionLoopStart.store(region.mLoopStart, std::memory_order_relaxed);
+			mRegionLoopEnd.store(region.mLoopEnd, std::memory_order_relaxed);
+			mRegionCrossFade.store(region.mCrossFade, std::memory_order_relaxed);
+			mRegionSequence.store(sequence + 2, std::memory_order_release);
+
+			// Frames that the I/O thread publishes for the previous epoch are rejected by the compare and swap
+			auto state = mWriteState.load(std::memory_order_relaxed);
+			uint64_t next;
+			do {
+				next = ((state >> EpochShift) + 1) << EpochShift | first;
+			} while (!mWriteState.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+		}
+
+
+		void SampleStream::stop()
+		{
+			play(Region(), 0);
+		}
+
+
+		void SampleStream::consume(DiscreteTimeValue frame)
+		{
+			auto consumed = mConsumed.load(std::memory_order_relaxed);
+			frame = std::min(frame, getWritten());
+			if (frame > consumed)
+				mConsumed.store(frame, std::memory_order_release);
+		}
+
+
+		bool SampleStream::isEndReached() const
+		{
+			auto end = mEnd.load(std::memory_order_acquire);
+			auto state = mWriteState.load(std::memory_order_acquire);
+			return end != NoEnd && (end >> EpochShift) == (state >> EpochShift);
+		}
+
+
+		bool SampleStream::needsRefill() const
+		{
+			auto state = mWriteState.load(std::memory_order_acquire);
+			if ((state >> EpochShift) != mProducerEpoch)
+				return true;
+			if (mFilled)
+				return false;
+
+			auto written = state & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_acquire);
+			if (consumed > written)
+				return false;
+			return mCapacity - (written - consumed) >= std::min(mCapacity / 4, ChunkSize);
+		}
+
+
+		double SampleStream::getTimeToUnderrun() const
+		{
+			auto written = mWriteState.load(std::memory_order_acquire) & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_acquire);
+			return double(written - consumed) / std::max(mConsumptionRate.load(), 1.f);
+		}
+
+
+		bool SampleStream::loadRegion(uint64_t epoch)
+		{
+			auto sequence = mRegionSequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+				return false;
+
+			Region region;
+			region.mBuffer = mRegionBuffer.load(std::memory_order_relaxed);
+			region.mStart = mRegionStart.load(std::memory_order_relaxed);
+			region.mLoop = mRegionLoop.load(std::memory_order_relaxed);
+			region.mLoopStart = mRegionLoopStart.load(std::memory_order_relaxed);
+			region.mLoopEnd = mRegionLoopEnd.load(std::memory_order_relaxed);
+			region.mCrossFade = mRegionCrossFade.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// A region that was published for a later epoch is read again once that epoch has started
+			if (mRegionSequence.load(std::memory_order_relaxed) != sequence || (mWriteState.load(std::memory_order_acquire) >> EpochShift) != epoch)
+				return false;
+			mRegion = region;
+			return true;
+		}
+
+
+		void SampleStream::refill()
+		{
+			auto state = mWriteState.load(std::memory_order_acquire);
+			if ((state >> EpochShift) != mProducerEpoch)
+			{
+				if (!loadRegion(state >> EpochShift))
+					return;
+				mProducerEpoch = state >> EpochShift;
+				mLength = getLength(mRegion);
+				mFilled = mRegion.mBuffer == nullptr;
+			}
+			if (mFilled)
+				return;
+
+			auto written = state & FrameMask;
+			auto consumed = mConsumed.load(std::memory_order_acquire);
+			if (consumed > written)
+				return;
+			auto frames = std::min<uint64_t>(mCapacity - (written - consumed), ChunkSize);
+			if (mLength != Endless)
+				frames = std::min<uint64_t>(frames, mLength > written ? mLength - written : 0);
+
+			// Fill the free part of the ring, which may wrap around its end
+			auto index = written & (mCapacity - 1);
+			auto first = std::min<uint64_t>(frames, mCapacity - index);
+			for (auto channel = 0; channel < mChannelCount; ++channel)
+			{
+				auto ring = &mRing[size_t(channel) * mCapacity];
+				read(mRegion, channel, written, first, ring + index);
+				if (frames > first)
+					read(mRegion, channel, written + first, frames - first, ring);
+			}
+
+			// Publish the frames, unless the audio thread has started a new region meanwhile
+			auto next = state + frames;
+			if (!mWriteState.compare_exchange_strong(state, next, std::memory_order_release, std::memory_order_relaxed))
+				return;
+			if (mLength != Endless && written + frames >= mLength)
+			{
+				mFilled = true;
+				mEnd.store(next, std::memory_order_release);
+			}
+		}
+
+	}
+
+}
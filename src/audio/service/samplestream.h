@@ -0,0 +1,179 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <vector>
+
+// Audio includes
+#include <audio/service/streamingservice.h>
+#include <audio/utility/mappedsamplebuffer.h>
+#include <audio/utility/sampleloop.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Stream slot of a sampler voice, filled ahead of playback by the I/O threads of the @StreamingService from a @MappedSampleBuffer.
+		 * The slot can be pointed at a new region of any buffer every time the voice starts, without allocating or waiting.
+		 *
+		 * A region is played as one continuous stream of frames, counted from the start of the region: a looped region is unrolled by the
+		 * I/O thread, including the equal power crossfade from the end of the loop into its start. The first frames of the stream can be
+		 * played from the mapping directly while the I/O thread fills the frames behind them, see play().
+		 *
+		 * Methods marked as audio thread methods should only be called by the single consumer of the stream.
+		 */
+		class NAPAPI SampleStream : public Stream
+		{
+		public:
+			/**
+			 * Section of a buffer that is streamed.
+			 */
+			struct Region : public SampleLoop
+			{
+				const MappedSampleBuffer* mBuffer = nullptr; ///< The buffer, has to stay alive while the region streams.
+			};
+
+			static constexpr DiscreteTimeValue Endless = SampleLoop::Endless; ///< Length of a region that loops
+
+			/**
+			 * Constructor, use StreamingService::createStream() to create a stream that is filled.
+			 * @param channelCount Number of channels that are streamed
+			 * @param readAhead Number of frames read ahead of the playback position.
+			 */
+			SampleStream(int channelCount, unsigned int readAhead);
+
+			/**
+			 * @return Number of channels of the stream
+			 */
+			int getChannelCount() const { return mChannelCount; }
+
+			/**
+			 * @return The number of times playback was faded out because frames had not been read from disk yet.
+			 */
+			int getUnderrunCount() const { return mUnderrunCount.load(); }
+
+			/**
+			 * Reads the frames of a region, as they are streamed. Frames after the end of a region that does not loop are silent.
+			 * This reads from the mapping, on the audio thread it should only be called for frames that are resident.
+			 * @param region The region
+			 * @param channel The channel, frames of channels the buffer does not have are silent.
+			 * @param first The first frame, relative to the start of the region.
+			 * @param count The number of frames
+			 * @param destination Receives the frames
+			 */
+			static void read(const Region& region, int channel, int64_t first, int count, float* destination);
+
+			/**
+			 * @param region The region
+			 * @return The number of frames in the region, or Endless for a region that loops.
+			 */
+			static DiscreteTimeValue getLength(const Region& region);
+
+			/**
+			 * @param region The region
+			 * @return The number of frames before the region first reaches the crossfade of its loop, or its length when it does not loop.
+			 */
+			static DiscreteTimeValue getLinearLength(const Region& region);
+
+			/**
+			 * Audio thread method. Starts streaming a region, what was streamed before is discarded.
+			 * @param region The region
+			 * @param first The first frame that is streamed, relative to the start of the region. The frames before it are not streamed, they are played from the mapping.
+			 */
+			void play(const Region& region, DiscreteTimeValue first);
+
+			/**
+			 * Audio thread method. Stops streaming.
+			 */
+			void stop();
+
+			/**
+			 * Audio thread method.
+			 * @return The frame up to which the stream has been filled, relative to the start of the region.
+			 */
+			DiscreteTimeValue getWritten() const { return mWriteState.load(std::memory_order_acquire) & FrameMask; }
+
+			/**
+			 * Audio thread method. Reads a sample that has been streamed.
+			 * @param frame Frame relative to the start of the region, between the consumed position and getWritten().
+			 * @param channel Channel of the sample
+			 * @return The sample
+			 */
+			SampleValue getSample(DiscreteTimeValue frame, int channel) const { return mRing[size_t(channel) * mCapacity + (frame & (mCapacity - 1))]; }
+
+			/**
+			 * Audio thread method. Releases the frames before a position, so the I/O thread can fill their space.
+			 * @param frame Frame relative to the start of the region.
+			 */
+			void consume(DiscreteTimeValue frame);
+
+			/**
+			 * Audio thread method.
+			 * @return Whether all frames of a region that does not loop have been streamed.
+			 */
+			bool isEndReached() const;
+
+			/**
+			 * Audio thread method. Counts an underrun.
+			 */
+			void reportUnderrun() { mUnderrunCount++; }
+
+			/**
+			 * Audio thread method. Informs the I/O threads how fast the stream is consumed, so the streams closest to running dry are refilled first.
+			 * @param framesPerSecond Number of frames consumed per second
+			 */
+			void setConsumptionRate(float framesPerSecond) { mConsumptionRate = framesPerSecond; }
+
+		private:
+			// The write state packs the play epoch in the upper bits and the frame up to which the stream is filled in the lower bits,
+			// so the I/O thread can publish frames and detect a new region that started meanwhile with one compare and swap.
+			static constexpr int EpochShift = 48;
+			static constexpr uint64_t FrameMask = (uint64_t(1) << EpochShift) - 1;
+			static constexpr uint64_t NoEnd = ~uint64_t(0);
+			static constexpr unsigned int ChunkSize = 4096; // Maximum number of frames filled by one refill
+
+			// I/O thread methods, called by the service one at a time
+			bool needsRefill() const override;
+			double getTimeToUnderrun() const override;
+			void refill() override;
+
+			// Reads the region of the current epoch, returns false when it is being replaced
+			bool loadRegion(uint64_t epoch);
+
+			int mChannelCount = 1;
+			unsigned int mCapacity = 0;                    // Size of the ring buffer in frames, a power of two
+			std::vector<SampleValue> mRing;                // Planar, mCapacity frames per channel
+
+			// Region of the current epoch, written by the audio thread and guarded by a sequence counter that is odd while it is written
+			std::atomic<uint32_t> mRegionSequence = { 0 };
+			std::atomic<const MappedSampleBuffer*> mRegionBuffer = { nullptr };
+			std::atomic<DiscreteTimeValue> mRegionStart = { 0 };
+			std::atomic<bool> mRegionLoop = { false };
+			std::atomic<DiscreteTimeValue> mRegionLoopStart = { 0 };
+			std::atomic<DiscreteTimeValue> mRegionLoopEnd = { 0 };
+			std::atomic<DiscreteTimeValue> mRegionCrossFade = { 0 };
+
+			// Shared between the audio thread and the I/O thread
+			std::atomic<uint64_t> mWriteState = { 0 };     // Epoch and frame up to which the stream is filled
+			std::atomic<uint64_t> mConsumed = { 0 };       // Frame before which everything has been consumed, written by the audio thread
+			std::atomic<uint64_t> mEnd = { NoEnd };        // Epoch and frame up to which the stream was filled when the end of the region was reached
+			std::atomic<float> mConsumptionRate = { 44100.f };
+			std::atomic<int> mUnderrunCount = { 0 };
+
+			// I/O thread
+			uint64_t mProducerEpoch = 0;
+			Region mRegion;
+			DiscreteTimeValue mLength = 0;
+			bool mFilled = true;                           // Whether the region has been streamed completely, or there is no region
+		};
+
+	}
+
+}
@@ -0,0 +1,143 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "streamingservice.h"
+
+// Std includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+
+// Audio includes
+#include <audio/core/audionodemanager.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		void Stream::wake()
+		{
+			if (mService != nullptr)
+				mService->wake();
+		}
+
+
+		// Services that are held by at least one node, keyed by node manager
+		static std::mutex sharedServicesMutex;
+		static std::map<NodeManager*, std::weak_ptr<StreamingService>> sharedServices;
+
+
+		std::shared_ptr<StreamingService> StreamingService::get(NodeManager& nodeManager)
+		{
+			std::lock_guard<std::mutex> lock(sharedServicesMutex);
+			auto& weak = sharedServices[&nodeManager];
+			auto result = weak.lock();
+			if (result == nullptr)
+			{
+				// Disk access and page faults do not scale with cores, a few threads keep enough reads in flight
+				result = std::make_shared<StreamingService>(std::min(std::max(int(std::thread::hardware_concurrency()) / 2, 1), 4));
+				weak = result;
+			}
+
+			// Forget services of node managers that are gone
+			for (auto it = sharedServices.begin(); it != sharedServices.end();)
+				it = it->second.expired() ? sharedServices.erase(it) : std::next(it);
+
+			return result;
+		}
+
+
+		StreamingService::StreamingService(int threadCount)
+		{
+			for (auto i = 0; i < std::max(threadCount, 1); ++i)
+				mThreads.emplace_back([this](){ run(); });
+		}
+
+
+		StreamingService::~StreamingService()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				mRunning = false;
+			}
+			mCondition.notify_all();
+			for (auto& thread : mThreads)
+				thread.join();
+		}
+
+
+		void StreamingService::addStream(std::shared_ptr<Stream> stream)
+		{
+			stream->mService = this;
+			stream->prepare();
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStreams.emplace_back(stream);
+		}
+
+
+		unsigned int StreamingService::getReadAhead(TimeValue latency, ControllerValue maxSpeed, float sampleRate)
+		{
+			return std::ceil(std::max(latency, float(PollInterval)) * 0.001f * std::max(maxSpeed, 1.f) * sampleRate);
+		}
+
+
+		int StreamingService::getStreamCount()
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			return std::count_if(mStreams.begin(), mStreams.end(), [](auto& stream){ return !stream.expired(); });
+		}
+
+
+		void StreamingService::run()
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			while (mRunning)
+			{
+				if (mQueue.empty())
+					schedule();
+				if (mQueue.empty())
+				{
+					mCondition.wait_for(lock, std::chrono::milliseconds(PollInterval));
+					continue;
+				}
+
+				// Skip streams that are being refilled by another thread, or that have been released by their owner meanwhile
+				auto stream = mQueue.top().mStream;
+				mQueue.pop();
+				if (stream->mBusy || stream.use_count() == 1)
+					continue;
+
+				stream->mBusy = true;
+				lock.unlock();
+				stream->refill();
+				lock.lock();
+				stream->mBusy = false;
+			}
+		}
+
+
+		void StreamingService::schedule()
+		{
+			auto it = mStreams.begin();
+			while (it != mStreams.end())
+			{
+				auto stream = it->lock();
+				if (stream == nullptr)
+				{
+					it = mStreams.erase(it);
+					continue;
+				}
+				if (!stream->mBusy && stream->needsRefill())
+					mQueue.push({ stream->getTimeToUnderrun(), stream });
+				++it;
+			}
+		}
+
+	}
+
+}
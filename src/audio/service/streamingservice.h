@@ -0,0 +1,169 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Audio includes
+#include <audio/utility/audiotypes.h>
+
+// Nap includes
+#include <utility/dllexport.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Forward declarations
+		class NodeManager;
+		class StreamingService;
+
+		/**
+		 * Base class of the streams that are filled ahead of playback by the I/O threads of the @StreamingService, such as @AudioFileStream and @SampleStream.
+		 * A stream keeps its frames in a ring buffer that is lock free between the I/O thread that fills it and the audio thread that consumes it,
+		 * the service only decides which stream is refilled next.
+		 */
+		class NAPAPI Stream
+		{
+			friend class StreamingService;
+
+		public:
+			virtual ~Stream() = default;
+
+		protected:
+			/**
+			 * Called by the service when the stream is created, before the I/O threads know about it.
+			 */
+			virtual void prepare() { }
+
+			/**
+			 * I/O thread method, called by the service for one stream at a time.
+			 * @return Whether the ring buffer has room for new frames.
+			 */
+			virtual bool needsRefill() const = 0;
+
+			/**
+			 * I/O thread method, called by the service for one stream at a time.
+			 * @return Time in seconds before the audio thread runs out of frames, streams that run out first are refilled first.
+			 */
+			virtual double getTimeToUnderrun() const = 0;
+
+			/**
+			 * I/O thread method, called by the service for one stream at a time. Fills the ring buffer by at most one chunk.
+			 */
+			virtual void refill() = 0;
+
+			/**
+			 * Lets the I/O threads check the streams right away, instead of after the poll interval.
+			 */
+			void wake();
+
+		private:
+			StreamingService* mService = nullptr; // The service that fills the stream
+			bool mBusy = false;                   // Guarded by the mutex of the service, set while an I/O thread refills the stream
+		};
+
+
+		/**
+		 * Fills the @Stream objects of a node manager ahead of playback, with a small fixed pool of I/O threads that is shared by all kinds of streams.
+		 * Whenever a thread is free it refills the stream that will run out of frames first, one chunk at a time, so hundreds of streams can be served by few threads.
+		 * Streams that have room for new frames are picked up within a few milliseconds, the audio thread never has to signal the service.
+		 * The service is shared by all nodes of the node manager, its threads stop when the last node that holds it is destroyed.
+		 */
+		class NAPAPI StreamingService
+		{
+		public:
+			static constexpr int PollInterval = 2; ///< Maximum time in ms before an idle I/O thread checks the streams again.
+
+			/**
+			 * Returns the service that is shared by all nodes of a node manager, starting it when no node holds it.
+			 * Holders should release their streams before the service, its destructor joins the I/O threads.
+			 * @param nodeManager The node manager
+			 * @return The service
+			 */
+			static std::shared_ptr<StreamingService> get(NodeManager& nodeManager);
+
+			/**
+			 * Starts the I/O threads.
+			 * @param threadCount Number of I/O threads
+			 */
+			StreamingService(int threadCount);
+
+			/**
+			 * Stops the I/O threads.
+			 */
+			~StreamingService();
+
+			/**
+			 * Creates a stream that is filled by this service.
+			 * @tparam T The type of the stream, derived from @Stream.
+			 * @param args The arguments of the constructor of the stream
+			 * @return The stream
+			 */
+			template <typename T, typename... Args>
+			std::shared_ptr<T> createStream(Args&&... args)
+			{
+				auto stream = std::make_shared<T>(std::forward<Args>(args)...);
+				addStream(stream);
+				return stream;
+			}
+
+			/**
+			 * Calculates how many frames a stream needs to read ahead.
+			 * @param latency Time in ms the frames that are read ahead have to last, which has to cover the worst case disk latency.
+			 * @param maxSpeed Maximum playback speed, as a multiple of the sample rate of the stream.
+			 * @param sampleRate Sample rate of the stream
+			 * @return Number of frames
+			 */
+			static unsigned int getReadAhead(TimeValue latency, ControllerValue maxSpeed, float sampleRate);
+
+			/**
+			 * Lets the I/O threads check the streams right away, instead of after the poll interval.
+			 */
+			void wake() { mCondition.notify_all(); }
+
+			/**
+			 * @return Number of I/O threads
+			 */
+			int getThreadCount() const { return mThreads.size(); }
+
+			/**
+			 * @return Number of streams that are served
+			 */
+			int getStreamCount();
+
+		private:
+			// A stream that needs a refill, ordered by the time until it runs out of frames
+			struct Job
+			{
+				double mTimeToUnderrun = 0.;
+				std::shared_ptr<Stream> mStream = nullptr;
+				bool operator<(const Job& other) const { return mTimeToUnderrun > other.mTimeToUnderrun; }
+			};
+
+			void addStream(std::shared_ptr<Stream> stream);
+			void run();
+			void schedule();
+
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			std::vector<std::weak_ptr<Stream>> mStreams;
+			std::priority_queue<Job> mQueue;
+			std::vector<std::thread> mThreads;
+			bool mRunning = true;
+		};
+
+	}
+
+}
@@ -6,6 +6,7 @@
 
 #include <cassert>
 #include <audio/utility/audiotypes.h>
+#include <audio/utility/delayline.h>
 
 #include <atomic>
 
@@ -18,6 +19,7 @@ namespace nap
         /**
          * Allpass filter object.
          * Call the process() method in order to process a single input sample.
+         * Implemented in canonical form, with a single delay line.
          */
 		class AllPass
 		{
@@ -26,20 +28,20 @@ namespace nap
 
 			/**
 			 * Constructor
-			 * @param maxDelay Size of the delay lines (and therefore maximum delay) in samples.
+			 * @param memory The arena the delay line is allocated from.
+			 * @param maxDelay Maximum delay in samples.
 			 */
-			AllPass(int maxDelay) { reset(maxDelay); }
+			AllPass(DelayMemory& memory, int maxDelay) { reset(memory, maxDelay); }
 
 			/**
-			 * Reset the buffers to zero.
+			 * Allocates the delay line and clears it.
              * Should only be called from the audio thread.
-			 * @param maxDelay Size of the delay lines (and therefore maximum delay) in samples.
+			 * @param memory The arena the delay line is allocated from.
+			 * @param maxDelay Maximum delay in samples.
 			 */
-			void reset(int maxDelay)
+			void reset(DelayMemory& memory, int maxDelay)
 			{
-				mInputBuffer.resize(maxDelay, 0.f);
-				mOutputBuffer.resize(maxDelay, 0.f);
-				mBufferIndex = 0;
+				mDelayLine.allocate(memory, maxDelay);
 			}
 
 			/**
@@ -49,16 +51,11 @@ namespace nap
 			 */
 			SampleValue process(SampleValue input)
 			{
-				int readIndex = mBufferIndex - mDelay;
-				if (readIndex < 0)
-					readIndex += mInputBuffer.size();
-				SampleValue output = -mGain * input + mInputBuffer[readIndex] + mGain * mOutputBuffer[readIndex];
-				mInputBuffer[mBufferIndex] = input;
-				mOutputBuffer[mBufferIndex] = output;
-				mBufferIndex++;
-				if (mBufferIndex >= mInputBuffer.size())
-					mBufferIndex = 0;
-				return output;
+				SampleValue gain = mGain;
+				SampleValue delayed = mDelayLine.read(mDelay - 1);
+				SampleValue state = input + gain * delayed;
+				mDelayLine.write(state);
+				return delayed - gain * state;
 			}
 
 			/**
@@ -71,14 +68,12 @@ namespace nap
 			 * Sets the delay time in samples of the allpass filter
 			 * @param value Delay time in samples
 			 */
-			void setDelay(int value) { assert(value <= mInputBuffer.size()); mDelay = value; }
+			void setDelay(int value) { assert(value <= mDelayLine.getMaxDelay() + 1); mDelay = value; }
 
 		private:
 			std::atomic<ControllerValue> mGain = { 1.f };
-			std::atomic<int> mDelay = { 0 };
-			SampleBuffer mInputBuffer;
-			SampleBuffer mOutputBuffer;
-			int mBufferIndex = 0;
+			std::atomic<int> mDelay = { 1 };
+			DelayLine<SampleValue> mDelayLine;
 		};
 
 	}
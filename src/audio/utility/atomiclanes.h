@@ -0,0 +1,71 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <cstring>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Publishes a float or a float vector (float4, float8, float16) from the control thread to the audio thread without locking.
+		 * std::atomic of a 32 or 64 byte vector is not lock free and hides a mutex, so every lane is stored in its own std::atomic<float> instead.
+		 * Lanes are loaded and stored individually: a load racing a store can return some lanes of the old and some of the new value, which is harmless for parameters that are independent per lane.
+		 * @tparam T float, or a vector type that consists of floats only.
+		 */
+		template <typename T>
+		class AtomicLanes
+		{
+			static_assert(sizeof(T) % sizeof(float) == 0, "AtomicLanes requires a type made of floats");
+
+		public:
+			AtomicLanes() : AtomicLanes(T(0.f)) { }
+			AtomicLanes(const T& value) { store(value); }
+
+			AtomicLanes(const AtomicLanes&) = delete;
+			AtomicLanes& operator=(const AtomicLanes&) = delete;
+
+			/**
+			 * @param value The new value, stored lane by lane.
+			 */
+			void store(const T& value)
+			{
+				float lanes[LaneCount];
+				std::memcpy(lanes, &value, sizeof(T));
+				for (auto i = 0; i < LaneCount; ++i)
+					mLanes[i].store(lanes[i], std::memory_order_relaxed);
+			}
+
+			/**
+			 * @return The value, loaded lane by lane.
+			 */
+			T load() const
+			{
+				float lanes[LaneCount];
+				for (auto i = 0; i < LaneCount; ++i)
+					lanes[i] = mLanes[i].load(std::memory_order_relaxed);
+				T value;
+				std::memcpy(&value, lanes, sizeof(T));
+				return value;
+			}
+
+			AtomicLanes& operator=(const T& value) { store(value); return *this; }
+			operator T() const { return load(); }
+
+		private:
+			static constexpr int LaneCount = sizeof(T) / sizeof(float);
+			static_assert(std::atomic<float>::is_always_lock_free, "AtomicLanes requires lock free float atomics");
+
+			std::atomic<float> mLanes[LaneCount];
+		};
+
+	}
+
+}
@@ -0,0 +1,53 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "biquad.h"
+
+// Audio includes
+#include <audio/utility/simddispatch.h>
+
+namespace nap
+{
+    namespace audio
+    {
+
+        template class BiquadFilter<float16>;
+
+
+        template <>
+        void BiquadFilter<float8>::processSum(const float* input, float* output, int count, const float8& mix)
+        {
+            // Process sample by sample as long as the coefficients are moving
+            auto i = 0;
+            for (; i < count && isRamping(); ++i)
+                output[i] = sumVec(process(float8(input[i])) * mix);
+
+            if (i == count)
+                return;
+
+            // Hand the rest of the block with static coefficients to the kernel
+            const float8 values[6] = { a0.getValue(), a1.getValue(), a2.getValue(), b1.getValue(), b2.getValue(), gain.getValue() * mix };
+            float coefficients[48];
+            for (auto coefficient = 0; coefficient < 6; ++coefficient)
+                for (auto lane = 0; lane < 8; ++lane)
+                    coefficients[coefficient * 8 + lane] = values[coefficient][lane];
+
+            float state[16];
+            for (auto lane = 0; lane < 8; ++lane)
+            {
+                state[lane] = h1[lane];
+                state[8 + lane] = h2[lane];
+            }
+
+            getSimdKernels().biquadBankSum8(input + i, output + i, count - i, coefficients, state);
+
+            for (auto lane = 0; lane < 8; ++lane)
+            {
+                h1[lane] = state[lane];
+                h2[lane] = state[8 + lane];
+            }
+        }
+
+    }
+}
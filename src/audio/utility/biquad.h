@@ -8,6 +8,7 @@
 #include <audio/utility/linearsmoothedvalue.h>
 
 #include <audio/utility/vectorextension.h>
+#include <audio/utility/fastmath.h>
 
 namespace nap
 {
@@ -15,8 +16,8 @@ namespace nap
     {
         
         /**
-         * Helper object to calculate a multiple of 4 or 8 biquad filters simultaneously with SSE or AVX vector extensions using @float4 or @float8.
-         * @tparam real Should be float, @float4 or @float8.
+         * Helper object to calculate a multiple of 4, 8 or 16 biquad filters simultaneously with SSE, AVX or AVX-512 vector extensions using @float4, @float8 or @float16.
+         * @tparam real Should be float, @float4, @float8 or @float16.
          */
         template <typename real>
         class NAPAPI BiquadFilter
@@ -41,6 +42,14 @@ namespace nap
                 gain.setValue(_gain);
             }
             
+            /**
+             * @return true when any of the coefficients is still being smoothed towards a new value.
+             */
+            bool isRamping() const
+            {
+                return a0.isRamping() || a1.isRamping() || a2.isRamping() || b1.isRamping() || b2.isRamping() || gain.isRamping();
+            }
+
             /**
              * Process one input sample for all the filters simultaneously.
              * @param input sample value
@@ -56,6 +65,17 @@ namespace nap
                 return result * gain.getNextValue();
             }
 
+            /**
+             * Processes a block of mono input through all the filters and writes the sum of the filter outputs, each multiplied by its lane in mix, to output.
+             * Input and output are allowed to be the same buffer.
+             * For float8 the block is processed by the @SimdKernels selected for the host CPU once the coefficients have stopped ramping.
+             */
+            void processSum(const float* input, float* output, int count, const real& mix)
+            {
+                for (auto i = 0; i < count; ++i)
+                    output[i] = sumVec(process(real(input[i])) * mix);
+            }
+
         private:
             LinearSmoothedValue<real> a0;
             LinearSmoothedValue<real> a1;
@@ -66,6 +86,10 @@ namespace nap
             real h1;
             real h2;
         };
+
+
+        template <>
+        NAPAPI void BiquadFilter<float8>::processSum(const float* input, float* output, int count, const float8& mix);
         
     }
 }
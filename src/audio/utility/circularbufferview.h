@@ -0,0 +1,170 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+// Audio includes
+#include <audio/utility/audiotypes.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Write position of a circular buffer, published by its single writer as a sequence lock.
+		 * Before writing a block the writer publishes the position up to which it is about to write, and after the block the position up to which it has written.
+		 * A reader that checks the first one after copying samples knows whether any of them may have been overwritten during the copy.
+		 */
+		class NAPAPI CircularBufferPosition
+		{
+		public:
+			/**
+			 * @return The number of samples written since construction. The next sample will be written at this position.
+			 */
+			DiscreteTimeValue getWritePosition() const { return mWritten.load(std::memory_order_acquire); }
+
+			/**
+			 * Called by the writer before writing a block of samples.
+			 * @param count Number of samples in the block
+			 * @return The write position of the first sample of the block
+			 */
+			DiscreteTimeValue beginWrite(unsigned int count)
+			{
+				auto position = mWritten.load(std::memory_order_relaxed);
+				mWriting.store(position + count, std::memory_order_relaxed);
+				// Publish the end of the block before any of its samples
+				std::atomic_thread_fence(std::memory_order_release);
+				return position;
+			}
+
+			/**
+			 * Called by the writer after writing the block announced by beginWrite().
+			 */
+			void endWrite() { mWritten.store(mWriting.load(std::memory_order_relaxed), std::memory_order_release); }
+
+			/**
+			 * Called by a reader after copying samples.
+			 * @return The position up to which the writer has written or is writing.
+			 */
+			DiscreteTimeValue getWritingPosition() const
+			{
+				// Make sure the copy is complete before reading the position, so an overwrite during the copy is noticed
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return mWriting.load(std::memory_order_relaxed);
+			}
+
+		private:
+			std::atomic<DiscreteTimeValue> mWritten = { 0 };
+			std::atomic<DiscreteTimeValue> mWriting = { 0 };
+		};
+
+
+		/**
+		 * Read access to one channel of a circular buffer that is written by the audio thread, see @CircularBufferNode and @MultichannelCircularBufferNode.
+		 * The view refers to the memory and the write position of the buffer, so it is only valid as long as the buffer exists.
+		 * Positions are counted in samples written since construction of the buffer, so they double as a sequence number to detect overruns.
+		 */
+		class NAPAPI CircularBufferView
+		{
+		public:
+			CircularBufferView() = default;
+
+			/**
+			 * @param data Samples of the channel
+			 * @param size Number of samples, a power of two.
+			 * @param writePosition The write position of the buffer
+			 */
+			CircularBufferView(const SampleValue* data, unsigned int size, const CircularBufferPosition& writePosition) :
+				mData(data), mMask(size - 1), mWritePosition(&writePosition)
+			{
+				assert((size & mMask) == 0);
+			}
+
+			/**
+			 * Reads a sample from the circular buffer at an absolute position, regardless of the current write position.
+			 * @param absolutePosition Absolute discrete sample position in the buffer, regardless of the current write position.
+			 * @return Value of the sample at the specified position.
+			 */
+			const SampleValue& getSample(DiscreteTimeValue absolutePosition) const { return mData[absolutePosition & mMask]; }
+
+			/**
+			 * Translates a position relative to the current write position to an absolute position.
+			 * @param relativePosition Position relative to the current write position.
+			 * @return Absolute position in the circular buffer.
+			 */
+			DiscreteTimeValue getAbsolutePosition(unsigned int relativePosition) const { return (getWritePosition() - relativePosition) & mMask; }
+
+			/**
+			 * @return The number of samples written to the buffer since construction. The next sample will be written at this position.
+			 */
+			DiscreteTimeValue getWritePosition() const { return mWritePosition->getWritePosition(); }
+
+			/**
+			 * @return The size of the buffer in samples.
+			 */
+			unsigned int getSize() const { return mMask + 1; }
+
+			/**
+			 * Copies a contiguous range of samples, safe to call from any thread.
+			 * Samples that have not been written yet should not be requested.
+			 * The samples are valid if the returned position is at most fromPosition + getSize(), otherwise the oldest samples may have been overwritten while reading.
+			 * @param destination Receives count samples
+			 * @param count Number of samples to read, at most the size of the buffer.
+			 * @param fromPosition Write position of the first sample to read.
+			 * @return The position up to which the writer had written, or was writing, after the samples were copied.
+			 */
+			DiscreteTimeValue read(SampleValue* destination, unsigned int count, DiscreteTimeValue fromPosition) const
+			{
+				assert(count <= getSize());
+				auto readIndex = fromPosition & mMask;
+				auto first = std::min<DiscreteTimeValue>(count, getSize() - readIndex);
+				std::memcpy(destination, mData + readIndex, first * sizeof(SampleValue));
+				std::memcpy(destination + first, mData, (count - first) * sizeof(SampleValue));
+				return mWritePosition->getWritingPosition();
+			}
+
+		private:
+			const SampleValue* mData = nullptr;
+			unsigned int mMask = 0;
+			const CircularBufferPosition* mWritePosition = nullptr;
+		};
+
+
+		/**
+		 * Writes a block of samples into the memory of a circular buffer, used by the nodes that own circular buffers between CircularBufferPosition::beginWrite() and endWrite().
+		 * When the buffer is smaller than the block only the last samples of the block are kept.
+		 * @param data Samples of the circular buffer
+		 * @param size Number of samples of the circular buffer, a power of two.
+		 * @param writePosition Write position of the first sample of the block
+		 * @param input The samples to write, or nullptr to write silence.
+		 * @param count Number of samples in the block
+		 */
+		inline void writeCircularBuffer(SampleValue* data, unsigned int size, DiscreteTimeValue writePosition, const SampleValue* input, unsigned int count)
+		{
+			auto skip = count - std::min(count, size);
+			count -= skip;
+			auto writeIndex = (writePosition + skip) & (size - 1);
+			auto first = std::min<DiscreteTimeValue>(count, size - writeIndex);
+			if (input == nullptr)
+			{
+				std::fill(data + writeIndex, data + writeIndex + first, 0.f);
+				std::fill(data, data + (count - first), 0.f);
+			}
+			else {
+				std::memcpy(data + writeIndex, input + skip, first * sizeof(SampleValue));
+				std::memcpy(data, input + skip + first, (count - first) * sizeof(SampleValue));
+			}
+		}
+
+	}
+
+}
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <audio/utility/audiotypes.h>
+#include <audio/utility/delayline.h>
 
 namespace nap
 {
@@ -19,14 +20,14 @@ namespace nap
 		{
 		public:
 		    /**
-		     * Reset the delay lines by flushing them with zero's
+		     * Allocates the delay line and clears it.
              * Should only be called from the audio thread.
-		     * @param maxDelay Size of the delay lines in samples, therefore the maximum delay time in samples
+		     * @param memory The arena the delay line is allocated from.
+		     * @param maxDelay Maximum delay time in samples
 		     */
-			void reset(int maxDelay)
+			void reset(DelayMemory& memory, int maxDelay)
 			{
-				mBuffer.resize(maxDelay, 0.f);
-				mBufferIndex = 0;
+				mDelayLine.allocate(memory, maxDelay);
 			}
 
 			/**
@@ -36,25 +37,15 @@ namespace nap
 			 */
 			SampleValue process(SampleValue input)
 			{
-				int readIndex = mBufferIndex - mDelay;
-				if (readIndex < 0)
-					readIndex += mBuffer.size();
-
-				mBuffer[mBufferIndex] = input;
-				SampleValue result = mGain * input + mFeedforward * mBuffer[readIndex];
-
-				mBufferIndex++;
-				if (mBufferIndex >= mBuffer.size())
-					mBufferIndex = 0;
-
-				return result;
+				mDelayLine.write(input);
+				return mGain * input + mFeedforward * mDelayLine.read(mDelay);
 			}
 
 			/**
 			 * Set delay time
 			 * @param delay Discrete delay time in samples
 			 */
-			void setDelay(int delay) { assert(delay < mBuffer.size()); mDelay = delay; }
+			void setDelay(int delay) { assert(delay <= mDelayLine.getMaxDelay()); mDelay = delay; }
 
 			/**
 			 * Sets the gain multiplier of the filter
@@ -69,8 +60,7 @@ namespace nap
 			void setFeedforward(ControllerValue value) { mFeedforward = value; }
 
 		private:
-			SampleBuffer mBuffer;
-			int mBufferIndex = 0;
+			DelayLine<SampleValue> mDelayLine;
 			std::atomic<int> mDelay = 0;
 			std::atomic<ControllerValue> mGain = 1.f;
 			std::atomic<ControllerValue> mFeedforward = 1.f;
@@ -0,0 +1,76 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "compressedsamplebuffer.h"
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+
+// Audio includes
+#include <audio/utility/sampleloop.h>
+#include <audio/utility/simddispatch.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		void CompressedSampleBuffer::resize(int channelCount, DiscreteTimeValue size, float sampleRate, SampleFormat format)
+		{
+			mChannelCount = std::max(channelCount, 0);
+			mSize = size;
+			mSampleRate = sampleRate;
+			mSampleFormat = format;
+			mChannelStride = (size_t(size) * getSampleSize() + 1) & ~size_t(1);
+			mData.assign(mChannelStride * mChannelCount, 0);
+		}
+
+
+		void CompressedSampleBuffer::write(int channel, int64_t first, const float* source, int count, int stride)
+		{
+			// Frames before the start and after the end are skipped
+			auto range = clampFrames(first, count, mSize);
+			if (range.mEnd == range.mBegin)
+				return;
+			source += int64_t(range.mBegin) * stride;
+			count = range.mEnd - range.mBegin;
+
+			auto destination = &mData[size_t(channel) * mChannelStride + (first + range.mBegin) * getSampleSize()];
+			if (mSampleFormat == SampleFormat::PCM16)
+			{
+				auto samples = reinterpret_cast<int16_t*>(destination);
+				for (auto i = 0; i < count; ++i)
+					samples[i] = int16_t(std::lround(std::clamp(source[size_t(i) * stride], -1.f, 1.f) * 32767.f));
+			}
+			else {
+				for (auto i = 0; i < count; ++i)
+				{
+					auto sample = int32_t(std::lround(std::clamp(source[size_t(i) * stride], -1.f, 1.f) * 8388607.f));
+					destination[3 * i] = uint8_t(sample);
+					destination[3 * i + 1] = uint8_t(sample >> 8);
+					destination[3 * i + 2] = uint8_t(sample >> 16);
+				}
+			}
+		}
+
+
+		void CompressedSampleBuffer::read(int channel, int64_t first, int count, float* destination) const
+		{
+			// Frames before the start and after the end are silent
+			auto range = clampFrames(first, count, mSize, destination);
+			if (range.mEnd == range.mBegin)
+				return;
+
+			auto source = &mData[size_t(channel) * mChannelStride + (first + range.mBegin) * getSampleSize()];
+			if (mSampleFormat == SampleFormat::PCM16)
+				getSimdKernels().decodePCM16(reinterpret_cast<const int16_t*>(source), destination + range.mBegin, range.mEnd - range.mBegin);
+			else
+				getSimdKernels().decodePCM24(source, destination + range.mBegin, range.mEnd - range.mBegin);
+		}
+
+	}
+
+}
@@ -0,0 +1,132 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <cstdint>
+#include <vector>
+
+// Nap includes
+#include <utility/dllexport.h>
+
+// Audio includes
+#include <audio/utility/audiotypes.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Multichannel sample buffer in memory that stores its samples as 16 or 24 bit integers instead of 32 bit floats.
+		 * It takes a half or three quarters of the memory of a @MultiSampleBuffer, and as much less memory bandwidth while playing.
+		 * Samples are converted to floats while they are read, read() converts blocks of samples with the SIMD kernels of the host CPU.
+		 * Writing encodes and is meant for loading, reading can be done from the audio thread.
+		 */
+		class NAPAPI CompressedSampleBuffer
+		{
+		public:
+			/**
+			 * Encoding of the samples.
+			 */
+			enum class SampleFormat { PCM16, PCM24 };
+
+			CompressedSampleBuffer() = default;
+
+			/**
+			 * Constructor, allocates a silent buffer.
+			 * @param channelCount Number of channels
+			 * @param size Number of frames per channel
+			 * @param sampleRate Sample rate of the samples
+			 * @param format Encoding of the samples
+			 */
+			CompressedSampleBuffer(int channelCount, DiscreteTimeValue size, float sampleRate, SampleFormat format) { resize(channelCount, size, sampleRate, format); }
+
+			/**
+			 * Reallocates the buffer, all samples are silent afterwards.
+			 * @param channelCount Number of channels
+			 * @param size Number of frames per channel
+			 * @param sampleRate Sample rate of the samples
+			 * @param format Encoding of the samples
+			 */
+			void resize(int channelCount, DiscreteTimeValue size, float sampleRate, SampleFormat format);
+
+			/**
+			 * Encodes samples into a channel, they are clipped between -1 and 1.
+			 * @param channel Index of the channel
+			 * @param first First frame to write, can be negative. Frames before the start or after the end of the buffer are skipped.
+			 * @param source Samples to encode
+			 * @param count Number of samples to encode
+			 * @param stride Distance between two samples in source, the channel count to write a channel of interleaved frames.
+			 */
+			void write(int channel, int64_t first, const float* source, int count, int stride = 1);
+
+			/**
+			 * Decodes a range of frames of a channel. Frames before the start or after the end of the buffer are read as silence.
+			 * @param channel Index of the channel
+			 * @param first First frame to read, can be negative.
+			 * @param count Number of frames to read
+			 * @param destination Receives count samples
+			 */
+			void read(int channel, int64_t first, int count, float* destination) const;
+
+			/**
+			 * Decodes a single sample. Prefer read() for ranges of samples.
+			 * @param channel Index of the channel
+			 * @param frame Index of the frame, has to be within the buffer.
+			 * @return The sample
+			 */
+			float getSample(int channel, DiscreteTimeValue frame) const
+			{
+				auto sample = &mData[size_t(channel) * mChannelStride + frame * getSampleSize()];
+				if (mSampleFormat == SampleFormat::PCM16)
+					return *reinterpret_cast<const int16_t*>(sample) * (1.f / 32768.f);
+				const uint32_t bytes = uint32_t(sample[0]) << 8 | uint32_t(sample[1]) << 16 | uint32_t(sample[2]) << 24;
+				return (int32_t(bytes) >> 8) * (1.f / 8388608.f);
+			}
+
+			/**
+			 * @return Number of channels
+			 */
+			int getChannelCount() const { return mChannelCount; }
+
+			/**
+			 * @return Number of frames per channel
+			 */
+			DiscreteTimeValue getSize() const { return mSize; }
+
+			/**
+			 * @return Sample rate of the samples
+			 */
+			float getSampleRate() const { return mSampleRate; }
+
+			/**
+			 * @return Encoding of the samples
+			 */
+			SampleFormat getSampleFormat() const { return mSampleFormat; }
+
+			/**
+			 * @return Size of an encoded sample in bytes
+			 */
+			int getSampleSize() const { return mSampleFormat == SampleFormat::PCM16 ? 2 : 3; }
+
+			/**
+			 * @return Memory taken by the samples in bytes
+			 */
+			size_t getMemorySize() const { return mData.size(); }
+
+		private:
+			std::vector<uint8_t> mData;     // The channels one after another
+			size_t mChannelStride = 0;      // Bytes per channel, rounded up so every channel starts 16 bit aligned
+			int mChannelCount = 0;
+			DiscreteTimeValue mSize = 0;
+			float mSampleRate = 44100.f;
+			SampleFormat mSampleFormat = SampleFormat::PCM16;
+		};
+
+	}
+
+}
@@ -0,0 +1,254 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+#include <audio/utility/audiotypes.h>
+#include <audio/utility/delaymemory.h>
+#include <audio/utility/vectorextension.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace nap
+{
+	namespace audio
+	{
+
+		/**
+		 * Delay line that is the core of all delay based utilities: delays, allpass and comb filters and string models.
+		 * The line is allocated from a @DelayMemory arena, with its size rounded up to a power of 2 so positions wrap with a mask.
+		 * Samples can be written and read one at a time or as blocks, and read at fractional delay times with linear, cubic Lagrange or Thiran allpass interpolation.
+		 * With a vector element type the lanes can also be read at different delay times, so every lane can hold an independent delay.
+		 *
+		 * The line counts the samples written since the last clear(), saturating at the size of the line.
+		 * Reads further back than that return zero, so clear() is O(1) and a newly allocated line does not have to be flushed.
+		 *
+		 * All read methods are called before writing the current sample: read(0) returns the most recently written sample.
+		 * @tparam real Should be float, @float4, @float8 or @float16.
+		 */
+		template <typename real>
+		class NAPAPI DelayLine
+		{
+		public:
+			DelayLine() = default;
+
+			/**
+			 * Constructor
+			 * @param memory The arena the delay line is allocated from
+			 * @param maxDelay Maximum delay time in samples
+			 */
+			DelayLine(DelayMemory& memory, unsigned int maxDelay) { allocate(memory, maxDelay); }
+
+			/**
+			 * Allocates a new delay line and clears it.
+			 * The previous delay line is returned to its arena, so this should not be called while processing.
+			 * @param memory The arena the delay line is allocated from
+			 * @param maxDelay Maximum delay time in samples, for all readers including the interpolating ones.
+			 */
+			void allocate(DelayMemory& memory, unsigned int maxDelay)
+			{
+				unsigned int size = 1;
+				while (size <= maxDelay + 2)
+					size *= 2;
+				mBlock = memory.allocate(size * sizeof(real));
+				mBuffer = mBlock.template data<real>();
+				mMask = size - 1;
+				mWriteIndex = 0;
+				clear();
+			}
+
+			/**
+			 * Write a sample to the delay line at the current write position
+			 * @param sample input value
+			 */
+			void write(const real& sample)
+			{
+				mBuffer[mWriteIndex] = sample;
+				mWriteIndex = (mWriteIndex + 1) & mMask;
+				mWritten += mWritten <= mMask;
+			}
+
+			/**
+			 * Writes a block of samples at the current write position, as count calls to write().
+			 * @param source The samples to write
+			 * @param count Number of samples, not more than the size of the delay line.
+			 */
+			void writeBlock(const real* source, unsigned int count)
+			{
+				assert(count <= mMask + 1);
+				auto first = std::min(count, mMask + 1 - mWriteIndex);
+				std::memcpy(mBuffer + mWriteIndex, source, first * sizeof(real));
+				std::memcpy(mBuffer, source + first, (count - first) * sizeof(real));
+				mWriteIndex = (mWriteIndex + count) & mMask;
+				mWritten = std::min(mWritten + count, mMask + 1);
+			}
+
+			/**
+			 * Read a sample from the delay line at @time samples behind the write position.
+			 * Non interpolating.
+			 * @param time Delay time in samples
+			 */
+			real read(unsigned int time) const
+			{
+				return time < mWritten ? mBuffer[(mWriteIndex - time - 1) & mMask] : real(0.f);
+			}
+
+			/**
+			 * Reads a block of count consecutive samples, oldest first, starting at @time samples behind the write position.
+			 * When count is at most time + 1 this equals calling read(time) and write() count times, without the writes.
+			 * @param time Delay time in samples of the first sample in the block
+			 * @param destination Receives the samples
+			 * @param count Number of samples
+			 */
+			void readBlock(unsigned int time, real* destination, unsigned int count) const
+			{
+				assert(count <= mMask + 1);
+
+				// Samples from before the last clear() read as zero
+				unsigned int cleared = time >= mWritten ? std::min(count, time - mWritten + 1) : 0;
+				std::fill(destination, destination + cleared, real(0.f));
+				destination += cleared;
+				count -= cleared;
+				time -= cleared;
+
+				auto readIndex = (mWriteIndex - time - 1) & mMask;
+				auto first = std::min(count, mMask + 1 - readIndex);
+				std::memcpy(destination, mBuffer + readIndex, first * sizeof(real));
+				std::memcpy(destination + first, mBuffer, (count - first) * sizeof(real));
+			}
+
+			/**
+			 * Reads at a fractional delay time with linear interpolation.
+			 * @param sampleTime Delay time in samples
+			 */
+			real readLinear(float sampleTime) const
+			{
+				assert(sampleTime < mMask);
+				unsigned int time = (unsigned int) sampleTime;
+				SampleValue frac = sampleTime - time;
+				const real current = read(time);
+				return current + (read(time + 1) - current) * frac;
+			}
+
+			/**
+			 * Same as readLinear(), kept for code written against VectorDelay.
+			 * @param sampleTime Delay time in samples
+			 */
+			real readInterpolating(float sampleTime) const { return readLinear(sampleTime); }
+
+			/**
+			 * Reads at a fractional delay time with third order Lagrange interpolation over the 4 surrounding samples.
+			 * Less high frequency loss than linear interpolation, at the cost of 4 reads.
+			 * @param sampleTime Delay time in samples, at least 1.
+			 */
+			real readLagrange(float sampleTime) const
+			{
+				assert(sampleTime < mMask - 1);
+				sampleTime = std::max(sampleTime, 1.f);
+				unsigned int time = (unsigned int) sampleTime;
+				SampleValue d = sampleTime - time;
+
+				// Lagrange weights for the samples at time - 1, time, time + 1 and time + 2
+				auto dPlus = d + 1.f;
+				auto dMin1 = d - 1.f;
+				auto dMin2 = d - 2.f;
+				auto c0 = -d * dMin1 * dMin2 * (1.f / 6.f);
+				auto c1 = dPlus * dMin1 * dMin2 * 0.5f;
+				auto c2 = -dPlus * d * dMin2 * 0.5f;
+				auto c3 = dPlus * d * dMin1 * (1.f / 6.f);
+				return read(time - 1) * c0 + read(time) * c1 + read(time + 1) * c2 + read(time + 2) * c3;
+			}
+
+			/**
+			 * Reads at a fractional delay time through a first order Thiran allpass interpolator.
+			 * The magnitude response is flat, which keeps feedback loops like string models from being damped by the interpolation.
+			 * The interpolator has state, so every reader needs its own state variable and the delay time should only change slowly.
+			 * @param sampleTime Delay time in samples, at least 0.5.
+			 * @param state The previous output of this reader, updated by the call.
+			 */
+			real readThiran(float sampleTime, real& state) const
+			{
+				assert(sampleTime < mMask);
+
+				// Keep the fractional part between 0.5 and 1.5, where the allpass delay is most accurate
+				sampleTime = std::max(sampleTime, 0.5f);
+				unsigned int time = (unsigned int) (sampleTime - 0.5f);
+				SampleValue d = sampleTime - time;
+				SampleValue eta = (1.f - d) / (1.f + d);
+				state = (read(time) - state) * eta + read(time + 1);
+				return state;
+			}
+
+			/**
+			 * Same as readLinear(), with a separate delay time for every lane of a vector element type.
+			 * @param sampleTimes Delay time in samples per lane
+			 */
+			real readLinearLanes(const real& sampleTimes) const
+			{
+				real current, next;
+				auto frac = gatherLanes(sampleTimes, current, next);
+				return current + (next - current) * frac;
+			}
+
+			/**
+			 * Same as readThiran(), with a separate delay time for every lane of a vector element type.
+			 * @param sampleTimes Delay time in samples per lane, at least 0.5.
+			 * @param state The previous output of this reader per lane, updated by the call.
+			 */
+			real readThiranLanes(const real& sampleTimes, real& state) const
+			{
+				const real half(0.5f);
+				const real one(1.f);
+				real current, next;
+				auto d = gatherLanes(maxVec(sampleTimes, half) - half, current, next) + half;
+				auto eta = (one - d) / (one + d);
+				state = (current - state) * eta + next;
+				return state;
+			}
+
+			/**
+			 * Clears the delay line in constant time: all samples written so far read as zero.
+			 */
+			void clear() { mWritten = 0; }
+
+			/**
+			 * @return the maximum delay in samples that can be read with all readers.
+			 */
+			unsigned int getMaxDelay() const { return mMask - 2; }
+
+			/**
+			 * Operator to read from the delay line without interpolation
+			 * @param index Delay time in samples
+			 */
+			inline real operator[](unsigned int index) const { return read(index); }
+
+		private:
+			// Reads every lane at the integer part of its delay time and one sample further back, returns the fractional parts
+			real gatherLanes(const real& sampleTimes, real& current, real& next) const
+			{
+				constexpr int laneCount = sizeof(real) / sizeof(float);
+				auto data = reinterpret_cast<const float*>(mBuffer);
+				real frac;
+				for (auto lane = 0; lane < laneCount; ++lane)
+				{
+					assert(sampleTimes[lane] < mMask);
+					unsigned int time = (unsigned int) sampleTimes[lane];
+					frac[lane] = sampleTimes[lane] - time;
+					current[lane] = time < mWritten ? data[((mWriteIndex - time - 1) & mMask) * laneCount + lane] : 0.f;
+					next[lane] = time + 1 < mWritten ? data[((mWriteIndex - time - 2) & mMask) * laneCount + lane] : 0.f;
+				}
+				return frac;
+			}
+
+			DelayMemory::Block mBlock;
+			real* mBuffer = nullptr;
+			unsigned int mMask = 0;
+			unsigned int mWriteIndex = 0;
+			unsigned int mWritten = 0; // Samples written since the last clear, at most the size of the line
+		};
+
+	}
+}
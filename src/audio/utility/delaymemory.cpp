@@ -0,0 +1,126 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "delaymemory.h"
+
+// Std includes
+#include <algorithm>
+#include <cstdint>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Arenas that are in use by at least one node, keyed by node manager
+		static std::mutex sharedDelayMemoryMutex;
+		static std::map<NodeManager*, std::weak_ptr<DelayMemory>> sharedDelayMemory;
+
+
+		static size_t align(size_t value)
+		{
+			return (value + DelayMemory::Alignment - 1) & ~(DelayMemory::Alignment - 1);
+		}
+
+
+		DelayMemory::Block& DelayMemory::Block::operator=(Block&& other)
+		{
+			if (this != &other)
+			{
+				release();
+				mMemory = std::move(other.mMemory);
+				mData = other.mData;
+				mSize = other.mSize;
+				other.mData = nullptr;
+				other.mSize = 0;
+			}
+			return *this;
+		}
+
+
+		void DelayMemory::Block::release()
+		{
+			if (mMemory != nullptr)
+				mMemory->release(mData, mSize);
+			mMemory = nullptr;
+			mData = nullptr;
+			mSize = 0;
+		}
+
+
+		std::shared_ptr<DelayMemory> DelayMemory::get(NodeManager& nodeManager)
+		{
+			std::lock_guard<std::mutex> lock(sharedDelayMemoryMutex);
+			auto& weak = sharedDelayMemory[&nodeManager];
+			auto result = weak.lock();
+			if (result == nullptr)
+			{
+				result = std::make_shared<DelayMemory>();
+				weak = result;
+			}
+
+			// Forget arenas of node managers that are gone
+			for (auto it = sharedDelayMemory.begin(); it != sharedDelayMemory.end();)
+				it = it->second.expired() ? sharedDelayMemory.erase(it) : std::next(it);
+
+			return result;
+		}
+
+
+		DelayMemory::Block DelayMemory::allocate(size_t size)
+		{
+			size = align(std::max<size_t>(size, 1));
+			Block result;
+			result.mMemory = shared_from_this();
+			result.mSize = size;
+
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			// Reuse the smallest released block that fits, as long as it does not waste more than half of it
+			auto freeBlock = mFreeBlocks.lower_bound(size);
+			if (freeBlock != mFreeBlocks.end() && freeBlock->first <= size * 2)
+			{
+				result.mData = freeBlock->second;
+				result.mSize = freeBlock->first;
+				mFreeBlocks.erase(freeBlock);
+			}
+			else {
+				auto chunk = std::find_if(mChunks.begin(), mChunks.end(), [size](const Chunk& chunk) { return chunk.mSize - chunk.mUsed >= size; });
+				if (chunk == mChunks.end())
+				{
+					Chunk newChunk;
+					newChunk.mSize = std::max(size, ChunkSize);
+					newChunk.mMemory = std::make_unique<char[]>(newChunk.mSize + Alignment);
+					auto address = reinterpret_cast<std::uintptr_t>(newChunk.mMemory.get());
+					newChunk.mData = newChunk.mMemory.get() + (align(address) - address);
+					mReservedSize += newChunk.mSize;
+					mChunks.emplace_back(std::move(newChunk));
+					chunk = mChunks.end() - 1;
+				}
+				result.mData = chunk->mData + chunk->mUsed;
+				chunk->mUsed += size;
+			}
+
+			mSize += result.mSize;
+			return result;
+		}
+
+
+		void DelayMemory::release(char* data, size_t size)
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mFreeBlocks.emplace(size, data);
+			mSize -= size;
+		}
+
+
+		size_t getDelayMemorySize(NodeManager& nodeManager)
+		{
+			return DelayMemory::get(nodeManager)->getSize();
+		}
+
+	}
+
+}
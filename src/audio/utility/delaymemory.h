@@ -0,0 +1,130 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Nap includes
+#include <utility/dllexport.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Forward declarations
+		class NodeManager;
+
+		/**
+		 * Arena that holds the memory of all delay lines processed by one @NodeManager.
+		 * Memory is handed out in cache line aligned blocks from large chunks, so the delay lines of a patch lie close together instead of scattered over the heap.
+		 * Blocks that are released are kept and handed out again to the next request that fits, chunks are only freed together with the arena.
+		 * Allocating and releasing is thread safe. It takes a lock, so it should not happen on every buffer.
+		 */
+		class NAPAPI DelayMemory : public std::enable_shared_from_this<DelayMemory>
+		{
+		public:
+			static constexpr size_t Alignment = 64; ///< Alignment in bytes of every block, one cache line.
+			static constexpr size_t ChunkSize = 1 << 20; ///< Size in bytes of the chunks blocks are taken from. Larger blocks get a chunk of their own.
+
+			/**
+			 * A block of delay memory. Returns the memory to the arena on destruction.
+			 * The arena stays alive as long as any of its blocks does.
+			 */
+			class NAPAPI Block
+			{
+				friend class DelayMemory;
+
+			public:
+				Block() = default;
+				Block(Block&& other) { *this = std::move(other); }
+				Block& operator=(Block&& other);
+				~Block() { release(); }
+
+				Block(const Block&) = delete;
+				Block& operator=(const Block&) = delete;
+
+				/**
+				 * @return The memory of the block, interpreted as an array of T.
+				 */
+				template <typename T>
+				T* data() const { return reinterpret_cast<T*>(mData); }
+
+				/**
+				 * @return Size of the block in bytes.
+				 */
+				size_t getSize() const { return mSize; }
+
+				/**
+				 * Returns the memory to the arena, leaving the block empty.
+				 */
+				void release();
+
+			private:
+				std::shared_ptr<DelayMemory> mMemory = nullptr;
+				char* mData = nullptr;
+				size_t mSize = 0;
+			};
+
+			DelayMemory() = default;
+
+			/**
+			 * @param nodeManager The node manager
+			 * @return The delay memory arena shared by all nodes of the node manager. Created on first use.
+			 */
+			static std::shared_ptr<DelayMemory> get(NodeManager& nodeManager);
+
+			/**
+			 * Allocates a block. The contents are not initialized.
+			 * @param size Size in bytes, rounded up to a multiple of the alignment.
+			 * @return The block
+			 */
+			Block allocate(size_t size);
+
+			/**
+			 * @return The number of bytes in blocks that are in use.
+			 */
+			size_t getSize() const { return mSize.load(); }
+
+			/**
+			 * @return The number of bytes reserved by the arena, including blocks that have been released and unused chunk space.
+			 */
+			size_t getReservedSize() const { return mReservedSize.load(); }
+
+		private:
+			struct Chunk
+			{
+				std::unique_ptr<char[]> mMemory;
+				char* mData = nullptr; // mMemory rounded up to the alignment
+				size_t mSize = 0;
+				size_t mUsed = 0;
+			};
+
+			void release(char* data, size_t size);
+
+			std::mutex mMutex;
+			std::vector<Chunk> mChunks;
+			std::multimap<size_t, char*> mFreeBlocks; // Released blocks by size
+			std::atomic<size_t> mSize = { 0 };
+			std::atomic<size_t> mReservedSize = { 0 };
+		};
+
+
+		/**
+		 * @param nodeManager The node manager
+		 * @return The number of bytes of delay memory in use by the nodes of the node manager.
+		 */
+		NAPAPI size_t getDelayMemorySize(NodeManager& nodeManager);
+
+	}
+
+}
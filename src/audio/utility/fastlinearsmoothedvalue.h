@@ -7,6 +7,9 @@
 // Nap includes
 #include <nap/signalslot.h>
 
+// Audio includes
+#include <audio/utility/atomiclanes.h>
+
 namespace nap
 {
     
@@ -57,9 +60,9 @@ namespace nap
              */
             void update()
             {
-                if (mNewDestination != mDestination)
+                if (mNewDestination.load() != mDestination)
                 {
-                    mDestination = mNewDestination;
+                    mDestination = mNewDestination.load();
                     mStepCounter = mStepCount;
                     if (mStepCounter == 0)
                         mValue = mDestination;
@@ -98,16 +101,16 @@ namespace nap
             /**
              * @return The destination of the current ramp. If the destination has been reached this value equals the current value.
              */
-            inline T getDestination() const { return mNewDestination; }
+            inline T getDestination() const { return mNewDestination.load(); }
             
             /**
              * Should only be called from the audio thread.
              * @return True when currently playing a ramp.
              */
-            inline bool isRamping() const { return mStepCounter > 0 || mDestination != mNewDestination; }
+            inline bool isRamping() const { return mStepCounter > 0 || mDestination != mNewDestination.load(); }
             
         private:
-            std::atomic<T> mNewDestination = 0;
+            AtomicLanes<T> mNewDestination;
             
             T mValue; // Value that is being controlled by this object.
             T mIncrement; // Increment value per step of the current ramp when mode is linear.
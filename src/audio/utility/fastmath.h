@@ -0,0 +1,171 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Audio includes
+#include <audio/utility/vectorextension.h>
+
+namespace nap
+{
+
+	/**
+	 * Polynomial approximations of transcendental functions.
+	 * Every function is a template that works on float, float4, float8 and float16, so the same code can be used in per-sample loops and on SIMD vectors.
+	 * The vector versions are also exported as sinVec(), cosVec(), tanVec(), expVec(), exp2Vec(), log2Vec() and powVec(), which shares the x >= 0 domain of fastPow().
+	 * Error bounds are measured in float precision against the double precision libm functions.
+	 * Inputs are not checked for NaN or infinity.
+	 */
+
+	// Scalar equivalents of the vector primitives in vectorextension.h
+
+	inline float minVec(const float a, const float b)
+	{
+		return a < b ? a : b;
+	}
+
+	inline float maxVec(const float a, const float b)
+	{
+		return a > b ? a : b;
+	}
+
+	inline float floorVec(const float value)
+	{
+		return std::floor(value);
+	}
+
+	inline float sumVec(const float value)
+	{
+		return value;
+	}
+
+	inline float scalePow2Vec(const float value, const float exponent)
+	{
+		const uint32_t bits = uint32_t(int32_t(exponent) + 127) << 23;
+		float scale;
+		std::memcpy(&scale, &bits, sizeof(float));
+		return value * scale;
+	}
+
+	inline float splitExponentVec(const float value, float& exponent)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(float));
+		exponent = float(int32_t(bits >> 23) - 127);
+		bits = (bits & 0x007FFFFF) | 0x3F800000;
+		float mantissa;
+		std::memcpy(&mantissa, &bits, sizeof(float));
+		return mantissa;
+	}
+
+
+	/**
+	 * 2^x. Relative error below 2.5e-7 for x within [-126, 127]. Input outside this range is clamped.
+	 */
+	template <typename T>
+	inline T fastExp2(const T x)
+	{
+		const T clamped = minVec(maxVec(x, T(-126.f)), T(127.f));
+		const T exponent = floorVec(clamped + T(0.5f));
+		const T f = clamped - exponent; // within [-0.5, 0.5]
+		T p = T(1.5461444696e-04f);
+		p = p * f + T(1.3400428177e-03f);
+		p = p * f + T(9.6180566785e-03f);
+		p = p * f + T(5.5503272267e-02f);
+		p = p * f + T(2.4022650922e-01f);
+		p = p * f + T(6.9314720670e-01f);
+		p = p * f + T(1.f);
+		return scalePow2Vec(p, exponent);
+	}
+
+
+	/**
+	 * e^x. Relative error below 2.5e-7 + |x| * 6e-8 (the rounding of x * log2(e)) for x within [-87, 88].
+	 */
+	template <typename T>
+	inline T fastExp(const T x)
+	{
+		return fastExp2(x * 1.44269504089f);
+	}
+
+
+	/**
+	 * log2(x) for positive, normalized x. Absolute error below 1.5e-7 + |log2(x)| * 6e-8.
+	 */
+	template <typename T>
+	inline T fastLog2(const T x)
+	{
+		T exponent;
+		const T mantissa = splitExponentVec(x, exponent); // within [1, 2)
+		const T s = (mantissa - T(1.f)) / (mantissa + T(1.f)); // within [0, 1/3)
+		const T s2 = s * s;
+		T p = T(4.0623087218e-01f);
+		p = p * s2 + T(4.0345194393e-01f);
+		p = p * s2 + T(5.7743285053e-01f);
+		p = p * s2 + T(9.6179171626e-01f);
+		p = p * s2 + T(2.8853900929e+00f);
+		return exponent + p * s;
+	}
+
+
+	/**
+	 * x^y for x >= 0, computed as 2^(y * log2(x)). Relative error below 3e-7 + |y| * 2e-7 + |y * log2(x)| * 1e-7.
+	 * x = 0 is treated as 2^-127, so the result is small but not exactly 0.
+	 * Negative x is outside the domain: the sign bit would be read as part of the exponent, so it is asserted against in debug builds.
+	 * Use std::pow() for negative bases with integer exponents.
+	 */
+	template <typename T>
+	inline T fastPow(const T x, const T y)
+	{
+		assert(sumVec(minVec(x, T(0.f))) == 0.f);
+		return fastExp2(y * fastLog2(x));
+	}
+
+
+	/**
+	 * sin(x). Absolute error below 1.5e-7 + |x| * 1e-7 (the rounding of the range reduction).
+	 */
+	template <typename T>
+	inline T fastSin(const T x)
+	{
+		// Reduce to turns within [-0.5, 0.5], then fold to a quarter wave within [-0.25, 0.25] using sin(pi - a) = sin(a)
+		T turns = x * 0.159154943092f;
+		turns = turns - floorVec(turns + T(0.5f));
+		const T u = minVec(maxVec(turns, T(-0.25f)), T(0.25f)) * 2.f - turns;
+		const T u2 = u * u;
+		T p = T(3.9759827086e+01f);
+		p = p * u2 + T(-7.6581172644e+01f);
+		p = p * u2 + T(8.1602476369e+01f);
+		p = p * u2 + T(-4.1341680613e+01f);
+		p = p * u2 + T(6.2831852802e+00f);
+		return p * u;
+	}
+
+
+	/**
+	 * cos(x). Absolute error below 1.5e-7 + |x| * 1e-7.
+	 */
+	template <typename T>
+	inline T fastCos(const T x)
+	{
+		return fastSin(x + T(1.57079632679f));
+	}
+
+
+	/**
+	 * tan(x), computed as fastSin(x) / fastCos(x). Relative error below (1.5e-7 + |x| * 1e-7) / |cos(x)|, so the error grows towards the poles.
+	 */
+	template <typename T>
+	inline T fastTan(const T x)
+	{
+		return fastSin(x) / fastCos(x);
+	}
+
+}
@@ -0,0 +1,64 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "fft.h"
+
+// Std includes
+#include <cassert>
+#include <cmath>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		void fft(std::vector<std::complex<float>>& data, bool inverse)
+		{
+			const auto size = data.size();
+			assert((size & (size - 1)) == 0);
+			if (size < 2)
+				return;
+
+			// Bit reversed reordering
+			for (size_t i = 1, j = 0; i < size; ++i)
+			{
+				auto bit = size >> 1;
+				for (; j & bit; bit >>= 1)
+					j ^= bit;
+				j ^= bit;
+				if (i < j)
+					std::swap(data[i], data[j]);
+			}
+
+			// Twiddle factors for the largest stage, the smaller stages use every n-th factor
+			const double sign = inverse ? 1.0 : -1.0;
+			const double twoPi = 6.283185307179586;
+			std::vector<std::complex<float>> twiddles(size / 2);
+			for (size_t k = 0; k < size / 2; ++k)
+			{
+				const double angle = sign * twoPi * k / size;
+				twiddles[k] = std::complex<float>(std::cos(angle), std::sin(angle));
+			}
+
+			for (size_t length = 2; length <= size; length <<= 1)
+			{
+				const auto half = length / 2;
+				const auto stride = size / length;
+				for (size_t start = 0; start < size; start += length)
+				{
+					for (size_t k = 0; k < half; ++k)
+					{
+						const auto even = data[start + k];
+						const auto odd = data[start + k + half] * twiddles[k * stride];
+						data[start + k] = even + odd;
+						data[start + k + half] = even - odd;
+					}
+				}
+			}
+		}
+
+	}
+
+}
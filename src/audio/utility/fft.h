@@ -0,0 +1,30 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <complex>
+#include <vector>
+
+// Nap includes
+#include <utility/dllexport.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * In place radix 2 fast fourier transform.
+		 * The transform is not normalized: a forward transform followed by an inverse transform multiplies the data by its size.
+		 * @param data Complex data, the size has to be a power of two.
+		 * @param inverse True for the inverse transform, which uses e^(+i...) twiddle factors.
+		 */
+		NAPAPI void fft(std::vector<std::complex<float>>& data, bool inverse = false);
+
+	}
+
+}
@@ -4,8 +4,9 @@
 
 #pragma once
 
+#include <audio/utility/atomiclanes.h>
 #include <audio/utility/onepole.h>
-#include <audio/utility/vectordelay.h>
+#include <audio/utility/delayline.h>
 #include <audio/utility/fastlinearsmoothedvalue.h>
 
 #include <audio/utility/audiofunctions.h>
@@ -29,14 +30,12 @@ namespace nap
 			/**
 			 * Reset the filter
              * Should only be called from the audio thread.
-			 * @param maxDelay New size of the delay line, therefore the maximum delay value in samples
+			 * @param memory The arena the delay line is allocated from
+			 * @param maxDelay The maximum delay value in samples
 			 */
-			void reset(int maxDelay)
+			void reset(DelayMemory& memory, int maxDelay)
 			{
-				int size = 2048;
-				while (size < maxDelay)
-					size *= 2;
-				mDelay = std::make_unique<VectorDelay<real>>(size);
+				mDelay.allocate(memory, maxDelay);
 			}
 
 			/**
@@ -48,9 +47,9 @@ namespace nap
 			real processPositive(const real& input)
 			{
 				mTime.update();
-				real value = mDelay->readInterpolating(mTime.getNextValue()) * mFeedback;
+				real value = mDelay.readLinear(mTime.getNextValue()) * mFeedback.load();
 				value = mDampingFilter.process(value);
-				mDelay->write(input + value);
+				mDelay.write(input + value);
 				return value;
 			}
 
@@ -63,9 +62,9 @@ namespace nap
 			real processNegative(const real& input)
 			{
 				mTime.update();
-				auto value = mDelay->readInterpolating(mTime.getNextValue()) * mFeedback;
+				auto value = mDelay.readLinear(mTime.getNextValue()) * mFeedback.load();
 				value = mDampingFilter.process(value);
-				mDelay->write(input - value);
+				mDelay.write(input - value);
 				return value;
 			}
 
@@ -76,7 +75,7 @@ namespace nap
 			 */
 			void setDelayTime(real sampleTime, int stepCount)
 			{
-				assert(sampleTime <= mDelay->getMaxDelay());
+				assert(sampleTime <= mDelay.getMaxDelay());
 				mTime.setStepCount(stepCount);
 				mTime.setValue(sampleTime);
 			}
@@ -101,12 +100,12 @@ namespace nap
 			/**
 			 * Sets the values in the delay line to zero.
 			 */
-			void flush() { mDelay->clear(); }
+			void flush() { mDelay.clear(); }
 
 		private:
 			OnePoleLowPass<real> mDampingFilter;
-			std::unique_ptr<VectorDelay<real>> mDelay = nullptr;
-			std::atomic<real> mFeedback = { 0.f };
+			DelayLine<real> mDelay;
+			AtomicLanes<real> mFeedback = { real(0.f) };
 			FastLinearSmoothedValue<real> mTime = { 0.f, 44 };
 		};
 
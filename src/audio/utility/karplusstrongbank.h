@@ -0,0 +1,160 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+#include <audio/utility/audiotypes.h>
+#include <audio/utility/delayline.h>
+#include <audio/utility/vectorextension.h>
+
+#include <mathutils.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Bank of Karplus Strong strings, one string in every lane of a vector type, sharing one @DelayLine.
+		 * Every string has its own delay time, feedback and damping, and can be plucked: a burst of filtered noise, one period long, is injected into the feedback loop.
+		 * The fractional part of the delay time is realized with a Thiran allpass, which keeps the tuning of high strings without damping them.
+		 * All methods are to be called from the audio thread.
+		 * @tparam real Should be @float4, @float8 or @float16.
+		 */
+		template <typename real>
+		class KarplusStrongBank
+		{
+		public:
+			static constexpr int LaneCount = sizeof(real) / sizeof(float); ///< Number of strings in the bank
+
+			KarplusStrongBank() = default;
+
+			/**
+			 * Allocates the delay line and silences all strings.
+			 * @param memory The arena the delay line is allocated from
+			 * @param maxDelay The maximum delay time, the period of the lowest pitch, in samples
+			 */
+			void reset(DelayMemory& memory, int maxDelay)
+			{
+				mDelay.allocate(memory, maxDelay);
+				mMaxDelay = maxDelay;
+				mDampingState = real(0.f);
+				mInterpolationState = real(0.f);
+				mBurstState = real(0.f);
+				for (auto lane = 0; lane < LaneCount; ++lane)
+					mBurstRemaining[lane] = 0;
+				mBurstCount = 0;
+			}
+
+			/**
+			 * Sets the delay time of a string. The delay time glides to the new value over the next processed block.
+			 * @param lane Index of the string
+			 * @param sampleTime The period of the string in samples, clamped to the maximum delay time.
+			 */
+			void setDelayTime(int lane, float sampleTime) { mTargetTime[lane] = std::min(std::max(sampleTime - 1.f, 0.5f), float(mMaxDelay)); }
+
+			/**
+			 * @param lane Index of the string
+			 * @param feedback Gain of the feedback loop, smaller than 1.
+			 */
+			void setFeedback(int lane, float feedback) { mFeedback[lane] = feedback; }
+
+			/**
+			 * Sets the cutoff frequency of the onepole lowpass in the feedback loop of a string.
+			 * @param lane Index of the string
+			 * @param cutoffFrequency Cutoff frequency in Hz
+			 * @param sampleRate The sample rate the bank runs on
+			 */
+			void setDamping(int lane, float cutoffFrequency, float sampleRate) { mDampingCoefficient[lane] = onePoleCoefficient(cutoffFrequency, sampleRate); }
+
+			/**
+			 * Plucks a string: injects a burst of noise, one period of the string long, into its feedback loop.
+			 * A glide of the delay time of the string in progress jumps to its destination.
+			 * @param lane Index of the string
+			 * @param amplitude Peak amplitude of the burst
+			 * @param brightness Between 0 and 1, the cutoff of the lowpass filter on the burst as a fraction of the Nyquist frequency.
+			 */
+			void pluck(int lane, float amplitude, float brightness)
+			{
+				if (mBurstRemaining[lane] == 0)
+					mBurstCount++;
+				mTime[lane] = mTargetTime[lane];
+				mBurstRemaining[lane] = int(mTargetTime[lane]) + 1;
+				mBurstAmplitude[lane] = amplitude;
+				mBurstCoefficient[lane] = onePoleCoefficient(0.5f * std::min(std::max(brightness, 0.01f), 1.f), 1.f);
+			}
+
+			/**
+			 * Processes a block of samples.
+			 * @param input Shared excitation signal for all strings, can be nullptr.
+			 * @param output Receives the sum of all strings.
+			 * @param count Number of samples
+			 */
+			void process(const float* input, float* output, int count)
+			{
+				const real timeStep = (mTargetTime - mTime) * (1.f / count);
+				for (auto i = 0; i < count; ++i)
+				{
+					mTime = mTime + timeStep;
+					auto value = mDelay.readThiranLanes(mTime, mInterpolationState) * mFeedback;
+					mDampingState = mDampingState + (value - mDampingState) * mDampingCoefficient;
+					value = mDampingState;
+
+					auto excitation = real(input != nullptr ? input[i] : 0.f);
+					if (mBurstCount > 0)
+						excitation = excitation + nextBurst();
+
+					mDelay.write(excitation + value);
+					output[i] = sumVec(value);
+				}
+				mTime = mTargetTime;
+			}
+
+		private:
+			static float onePoleCoefficient(float cutoffFrequency, float sampleRate)
+			{
+				return 1.f - std::exp(-math::PIX2 * cutoffFrequency / sampleRate);
+			}
+
+			// Filtered noise of the strings that are being plucked
+			real nextBurst()
+			{
+				real noise(0.f);
+				for (auto lane = 0; lane < LaneCount; ++lane)
+				{
+					if (mBurstRemaining[lane] == 0)
+						continue;
+					mSeed = mSeed * 1664525u + 1013904223u;
+					noise[lane] = (int32_t(mSeed) * (1.f / 2147483648.f)) * mBurstAmplitude[lane];
+					if (--mBurstRemaining[lane] == 0)
+						mBurstCount--;
+				}
+				mBurstState = mBurstState + (noise - mBurstState) * mBurstCoefficient;
+				return mBurstState;
+			}
+
+			DelayLine<real> mDelay;
+			int mMaxDelay = 0;
+			real mTime = real(0.5f); // Delay time of the delay line per lane, one sample shorter than the period of the string
+			real mTargetTime = real(0.5f);
+			real mFeedback = real(0.f);
+			real mDampingCoefficient = real(1.f);
+			real mDampingState = real(0.f);
+			real mInterpolationState = real(0.f);
+
+			real mBurstAmplitude = real(0.f);
+			real mBurstCoefficient = real(1.f);
+			real mBurstState = real(0.f);
+			int mBurstRemaining[LaneCount] = { };
+			int mBurstCount = 0; // Number of strings with a burst in progress
+			uint32_t mSeed = 22222;
+		};
+
+	}
+
+}
@@ -0,0 +1,312 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "mappedsamplebuffer.h"
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Platform includes
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Audio includes
+#include <audio/utility/sampleloop.h>
+#include <audio/utility/simddispatch.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		static size_t alignUp(size_t size, size_t alignment)
+		{
+			return (size + alignment - 1) / alignment * alignment;
+		}
+
+
+		static size_t getPageSize()
+		{
+#ifdef _WIN32
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			return info.dwPageSize;
+#else
+			return sysconf(_SC_PAGESIZE);
+#endif
+		}
+
+
+		MappedSampleBuffer::~MappedSampleBuffer()
+		{
+			close();
+		}
+
+
+		bool MappedSampleBuffer::open(const std::string& path, utility::ErrorState& errorState)
+		{
+			if (!map(path, 0, false, errorState))
+				return false;
+
+			Header header;
+			if (mMappedSize < sizeof(Header))
+			{
+				close();
+				errorState.fail("Sample file %s is too small", path.c_str());
+				return false;
+			}
+			std::memcpy(&header, mData, sizeof(Header));
+			if (header.mIdentifier != FileIdentifier || header.mVersion != FileVersion || header.mSampleFormat > uint32_t(SampleFormat::PCM16))
+			{
+				close();
+				errorState.fail("%s is not a sample file, or was created by another version", path.c_str());
+				return false;
+			}
+
+			auto format = static_cast<SampleFormat>(header.mSampleFormat);
+			auto stride = header.mChannelStride;
+			if (header.mChannelCount == 0 || stride % Alignment != 0 || stride < header.mFrameCount * getSampleSize(format) || mMappedSize < Alignment + stride * header.mChannelCount)
+			{
+				close();
+				errorState.fail("Sample file %s is damaged", path.c_str());
+				return false;
+			}
+
+			mSampleFormat = format;
+			mSize = header.mFrameCount;
+			mSampleRate = header.mSampleRate;
+			for (auto channel = 0; channel < int(header.mChannelCount); ++channel)
+				mChannels.emplace_back(static_cast<const char*>(mData) + Alignment + stride * channel);
+			return true;
+		}
+
+
+		void MappedSampleBuffer::close()
+		{
+			if (mData != nullptr)
+			{
+#ifdef _WIN32
+				UnmapViewOfFile(mData);
+#else
+				munmap(mData, mMappedSize);
+#endif
+			}
+			mData = nullptr;
+			mMappedSize = 0;
+			mChannels.clear();
+			mSize = 0;
+		}
+
+
+		bool MappedSampleBuffer::prefault(DiscreteTimeValue first, DiscreteTimeValue frameCount, bool lock)
+		{
+			first = std::min(first, mSize);
+			frameCount = std::min(frameCount, mSize - first);
+			if (frameCount == 0)
+				return true;
+
+			// The channels are aligned in the file, but the page size of the system can be larger than that alignment
+			auto pageSize = getPageSize();
+			bool locked = true;
+			for (auto data : mChannels)
+			{
+				auto sampleSize = getSampleSize(mSampleFormat);
+				auto begin = (reinterpret_cast<uintptr_t>(data) + first * sampleSize) / pageSize * pageSize;
+				auto end = reinterpret_cast<uintptr_t>(data) + (first + frameCount) * sampleSize;
+				auto size = alignUp(end - begin, pageSize);
+				auto address = reinterpret_cast<char*>(begin);
+
+				// Ask for all pages at once so the reads are queued together, then touch every page to wait until it is resident
+#ifdef _WIN32
+				WIN32_MEMORY_RANGE_ENTRY range = { address, size };
+				PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+				madvise(address, size, MADV_WILLNEED);
+#endif
+				volatile char sum = 0;
+				for (size_t offset = 0; offset < size; offset += pageSize)
+					sum += address[offset];
+
+				if (lock)
+				{
+#ifdef _WIN32
+					locked &= VirtualLock(address, size) != 0;
+#else
+					locked &= mlock(address, size) == 0;
+#endif
+				}
+			}
+			return locked;
+		}
+
+
+		void MappedSampleBuffer::read(int channel, int64_t first, int count, float* destination) const
+		{
+			// Frames before the start and after the end are silent
+			auto range = clampFrames(first, count, mSize, destination);
+			if (mSampleFormat == SampleFormat::Float32)
+				std::memcpy(destination + range.mBegin, static_cast<const float*>(mChannels[channel]) + first + range.mBegin, (range.mEnd - range.mBegin) * sizeof(float));
+			else
+				getSimdKernels().decodePCM16(static_cast<const int16_t*>(mChannels[channel]) + first + range.mBegin, destination + range.mBegin, range.mEnd - range.mBegin);
+		}
+
+
+		bool MappedSampleBuffer::create(const std::string& path, int channelCount, DiscreteTimeValue frameCount, float sampleRate, SampleFormat format, const SourceReader& source, utility::ErrorState& errorState)
+		{
+			static_assert(sizeof(Header) <= Alignment, "The header has to fit before the first channel");
+			if (channelCount <= 0)
+			{
+				errorState.fail("Can not create sample file %s without channels", path.c_str());
+				return false;
+			}
+
+			Header header;
+			header.mChannelCount = channelCount;
+			header.mSampleFormat = uint32_t(format);
+			header.mSampleRate = sampleRate;
+			header.mChannelStride = alignUp(frameCount * getSampleSize(format), Alignment);
+
+			// The file is written under a temporary name and replaces the file at the path when it is complete, so a mapping of the previous file that is still playing stays intact
+			auto temporaryPath = path + ".tmp";
+			MappedSampleBuffer file;
+			if (!file.map(temporaryPath, Alignment + header.mChannelStride * channelCount, true, errorState))
+				return false;
+
+			// Deinterleave the source into the channels one chunk at a time
+			const int chunkSize = 4096;
+			std::vector<float> chunk(size_t(chunkSize) * channelCount);
+			auto data = static_cast<char*>(file.mData);
+			DiscreteTimeValue position = 0;
+			while (position < frameCount)
+			{
+				int count = std::min<DiscreteTimeValue>(frameCount - position, chunkSize);
+				count = std::min(source(chunk.data(), count), count);
+				if (count <= 0)
+					break;
+
+				for (auto channel = 0; channel < channelCount; ++channel)
+				{
+					auto destination = data + Alignment + header.mChannelStride * channel;
+					if (format == SampleFormat::Float32)
+					{
+						auto samples = reinterpret_cast<float*>(destination) + position;
+						for (auto i = 0; i < count; ++i)
+							samples[i] = chunk[size_t(i) * channelCount + channel];
+					}
+					else {
+						auto samples = reinterpret_cast<int16_t*>(destination) + position;
+						for (auto i = 0; i < count; ++i)
+							samples[i] = std::lround(std::clamp(chunk[size_t(i) * channelCount + channel], -1.f, 1.f) * 32767.f);
+					}
+				}
+				position += count;
+			}
+
+			// A source that ends early leaves silence, the header records the frames that were read
+			header.mFrameCount = position;
+			std::memcpy(data, &header, sizeof(Header));
+			file.close();
+
+#ifdef _WIN32
+			// Windows can not replace or remove a file that is still mapped, but it can move it aside because sample files are opened with FILE_SHARE_DELETE.
+			// The previous file is deleted as soon as its last mapping is closed.
+			auto previousPath = path + "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetTickCount64()) + ".old";
+			if (MoveFileA(path.c_str(), previousPath.c_str()))
+				DeleteFileA(previousPath.c_str());
+#endif
+			if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+			{
+				std::remove(temporaryPath.c_str());
+				errorState.fail("Failed to replace sample file %s", path.c_str());
+				return false;
+			}
+			return true;
+		}
+
+
+		bool MappedSampleBuffer::map(const std::string& path, size_t size, bool writable, utility::ErrorState& errorState)
+		{
+			close();
+
+#ifdef _WIN32
+			auto file = CreateFileA(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				errorState.fail("Failed to open sample file %s", path.c_str());
+				return false;
+			}
+			if (!writable)
+			{
+				LARGE_INTEGER fileSize;
+				size = GetFileSizeEx(file, &fileSize) ? size_t(fileSize.QuadPart) : 0;
+			}
+			if (size == 0)
+			{
+				CloseHandle(file);
+				errorState.fail("Sample file %s is empty", path.c_str());
+				return false;
+			}
+
+			// The view keeps the file mapped after the handles are closed
+			auto mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, DWORD(uint64_t(size) >> 32), DWORD(size & 0xffffffff), nullptr);
+			CloseHandle(file);
+			auto data = mapping != nullptr ? MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size) : nullptr;
+			if (mapping != nullptr)
+				CloseHandle(mapping);
+			if (data == nullptr)
+			{
+				errorState.fail("Failed to map sample file %s", path.c_str());
+				return false;
+			}
+#else
+			auto file = ::open(path.c_str(), writable ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+			if (file < 0)
+			{
+				errorState.fail("Failed to open sample file %s", path.c_str());
+				return false;
+			}
+			bool sized;
+			if (writable)
+				sized = ftruncate(file, size) == 0;
+			else {
+				struct stat status;
+				sized = fstat(file, &status) == 0;
+				size = sized ? status.st_size : 0;
+			}
+			if (!sized || size == 0)
+			{
+				::close(file);
+				errorState.fail("Sample file %s is empty or can not be resized", path.c_str());
+				return false;
+			}
+
+			// The mapping stays valid after the file is closed
+			auto data = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+			::close(file);
+			if (data == MAP_FAILED)
+			{
+				errorState.fail("Failed to map sample file %s", path.c_str());
+				return false;
+			}
+#endif
+
+			mData = data;
+			mMappedSize = size;
+			return true;
+		}
+
+	}
+
+}
@@ -0,0 +1,191 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Nap includes
+#include <utility/dllexport.h>
+#include <utility/errorstate.h>
+
+// Audio includes
+#include <audio/utility/audiotypes.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Multichannel sample buffer that is memory mapped from a pre-converted sample file instead of being read into memory.
+		 * Opening a file only maps it, so large sample libraries are available right away and only take physical memory for the pages that are played.
+		 *
+		 * The file stores the channels one after another, every channel starting on a page boundary, as 32 bit floats or 16 bit integers.
+		 * Float channels are read straight from the mapping, 16 bit channels are converted while reading.
+		 * A page that is not resident is read from disk by the thread that touches it, so prefault() the part of every sample that has to start without delay.
+		 */
+		class NAPAPI MappedSampleBuffer
+		{
+		public:
+			/**
+			 * Encoding of the samples in the file.
+			 */
+			enum class SampleFormat { Float32, PCM16 };
+
+			/**
+			 * Reads interleaved frames from the source of a file that is created.
+			 * Receives the destination and the maximum number of frames, returns the number of frames that were read, 0 at the end of the source.
+			 */
+			using SourceReader = std::function<int(float* destination, int frameCount)>;
+
+			MappedSampleBuffer() = default;
+			~MappedSampleBuffer();
+
+			MappedSampleBuffer(const MappedSampleBuffer&) = delete;
+			MappedSampleBuffer& operator=(const MappedSampleBuffer&) = delete;
+
+			/**
+			 * Maps a sample file for reading. Unmaps the file that was mapped before.
+			 * @param path Path to a file created with create().
+			 * @param errorState Contains the error when the file can not be mapped.
+			 * @return True on success
+			 */
+			bool open(const std::string& path, utility::ErrorState& errorState);
+
+			/**
+			 * Unmaps the file.
+			 */
+			void close();
+
+			/**
+			 * Reads the first frames of every channel into physical memory, so they can be played without waiting for the disk.
+			 * The rest of the file is read on demand when it is played.
+			 * @param frameCount Number of frames at the start of every channel.
+			 * @param lock Whether to lock the frames in memory so they are not paged out again. This is a best effort that depends on the memory lock limit of the process.
+			 * @return False when locking was requested but failed, the frames are read either way.
+			 */
+			bool prefault(DiscreteTimeValue frameCount, bool lock = false) { return prefault(0, frameCount, lock); }
+
+			/**
+			 * Reads a section of every channel into physical memory, for example the start of a sample that does not start at the first frame.
+			 * @param first The first frame of the section.
+			 * @param frameCount Number of frames in the section.
+			 * @param lock Whether to lock the frames in memory so they are not paged out again.
+			 * @return False when locking was requested but failed, the frames are read either way.
+			 */
+			bool prefault(DiscreteTimeValue first, DiscreteTimeValue frameCount, bool lock);
+
+			/**
+			 * @return Whether a file is mapped.
+			 */
+			bool isValid() const { return mData != nullptr; }
+
+			/**
+			 * @return The number of channels.
+			 */
+			int getChannelCount() const { return mChannels.size(); }
+
+			/**
+			 * @return The number of frames per channel.
+			 */
+			DiscreteTimeValue getSize() const { return mSize; }
+
+			/**
+			 * @return The sample rate of the file.
+			 */
+			float getSampleRate() const { return mSampleRate; }
+
+			/**
+			 * @return The encoding of the samples.
+			 */
+			SampleFormat getSampleFormat() const { return mSampleFormat; }
+
+			/**
+			 * @param channel The channel
+			 * @return The samples of a channel in a 32 bit float file, nullptr for other sample formats.
+			 */
+			const float* getFloatChannel(int channel) const { return mSampleFormat == SampleFormat::Float32 ? static_cast<const float*>(mChannels[channel]) : nullptr; }
+
+			/**
+			 * @param channel The channel
+			 * @return The samples of a channel in a 16 bit file, nullptr for other sample formats.
+			 */
+			const int16_t* getPCM16Channel(int channel) const { return mSampleFormat == SampleFormat::PCM16 ? static_cast<const int16_t*>(mChannels[channel]) : nullptr; }
+
+			/**
+			 * @param channel The channel
+			 * @param frame The frame, smaller than getSize().
+			 * @return The sample at the frame.
+			 */
+			SampleValue getSample(int channel, DiscreteTimeValue frame) const
+			{
+				if (mSampleFormat == SampleFormat::Float32)
+					return static_cast<const float*>(mChannels[channel])[frame];
+				return static_cast<const int16_t*>(mChannels[channel])[frame] * (1.f / 32768.f);
+			}
+
+			/**
+			 * Reads samples of one channel as floats. Frames outside the buffer are read as silence.
+			 * @param channel The channel
+			 * @param first The first frame, can be negative.
+			 * @param count The number of frames.
+			 * @param destination Receives the samples.
+			 */
+			void read(int channel, int64_t first, int count, float* destination) const;
+
+			/**
+			 * Creates a sample file from interleaved frames, for example decoded from an audio file.
+			 * The file is written through a mapping and can be opened as soon as this returns.
+			 * @param path Path of the file, overwritten when it exists.
+			 * @param channelCount Number of channels of the source.
+			 * @param frameCount Number of frames of the source.
+			 * @param sampleRate Sample rate of the source.
+			 * @param format Encoding of the samples in the file.
+			 * @param source Reads the frames of the source.
+			 * @param errorState Contains the error when the file can not be written.
+			 * @return True on success
+			 */
+			static bool create(const std::string& path, int channelCount, DiscreteTimeValue frameCount, float sampleRate, SampleFormat format, const SourceReader& source, utility::ErrorState& errorState);
+
+		private:
+			static constexpr uint32_t FileIdentifier = 0x4e41504d; // "NAPM"
+			static constexpr uint32_t FileVersion = 1;
+			static constexpr size_t Alignment = 4096; // Alignment in bytes of the header and the channels in the file
+
+			// Layout of the start of the file
+			struct Header
+			{
+				uint32_t mIdentifier = FileIdentifier;
+				uint32_t mVersion = FileVersion;
+				uint32_t mChannelCount = 0;
+				uint32_t mSampleFormat = 0;
+				uint64_t mFrameCount = 0;
+				float mSampleRate = 0.f;
+				uint32_t mReserved = 0;
+				uint64_t mChannelStride = 0; // Distance in bytes between the starts of the channels
+			};
+
+			static size_t getSampleSize(SampleFormat format) { return format == SampleFormat::Float32 ? sizeof(float) : sizeof(int16_t); }
+
+			// Maps a file for reading, or creates a file of the given size and maps it for writing
+			bool map(const std::string& path, size_t size, bool writable, utility::ErrorState& errorState);
+
+			void* mData = nullptr;
+			size_t mMappedSize = 0;
+			std::vector<const void*> mChannels;
+			DiscreteTimeValue mSize = 0;
+			float mSampleRate = 0.f;
+			SampleFormat mSampleFormat = SampleFormat::Float32;
+		};
+
+	}
+
+}
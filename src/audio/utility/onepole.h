@@ -6,10 +6,9 @@
 
 #include <audio/utility/audiotypes.h>
 #include <mathutils.h>
+#include <audio/utility/atomiclanes.h>
 #include <audio/utility/vectorextension.h>
 
-#include <atomic>
-
 namespace nap
 {
 
@@ -18,7 +17,7 @@ namespace nap
 
 	    /**
 	     * One pole lowpass filter algorithm
-	     * @tparam real Can be float, float4 or float8 to enable SIMD processing
+	     * @tparam real Can be float, float4, float8 or float16 to enable SIMD processing
 	     */
 		template <typename real>
 		class OnePoleLowPass
@@ -33,7 +32,7 @@ namespace nap
 			 */
 			real process(const real& input)
 			{
-				auto value = output + cf * (input - output);
+				auto value = output + cf.load() * (input - output);
 				output = value;
 				return output;
 			}
@@ -46,12 +45,12 @@ namespace nap
 			void setCutoffFrequency(float cutoffFrequency, float sampleRate)
 			{
 				real c = real(cutoffFrequency / sampleRate);
-				cf = 1 - powVec(real(math::E), real(-math::PIX2) * c);
+				cf = real(1.f) - powVec(real(math::E), real(-math::PIX2) * c);
 			}
 
 		private:
-			std::atomic<real> cf = { 0.f };
-			real output = { 0.f };
+			AtomicLanes<real> cf = { real(0.f) };
+			real output = real(0.f);
 		};
 
 
@@ -72,7 +71,7 @@ namespace nap
              */
 			real process(const real& input)
 			{
-				output = a0 * input + a1 * previousInput + b1 * output;
+				output = a0.load() * input + a1.load() * previousInput + b1.load() * output;
 				previousInput = input;
 				return output;
 			}
@@ -84,7 +83,7 @@ namespace nap
 			 */
 			void setCutoffFrequency(ControllerValue cutoffFrequency, float sampleRate)
 			{
-				real c = cutoffFrequency / sampleRate;
+				real c = real(cutoffFrequency / sampleRate);
 				real x = powVec(real(math::E), real(-math::M2_PI) * c);
 				real one = real(1.f);
 				real two = real(2.f);
@@ -94,9 +93,9 @@ namespace nap
 			}
 
 		private:
-			std::atomic<real> a0 = { 1.0 };
-			std::atomic<real> a1 = { 0.f };
-			std::atomic<real> b1 = { 0.f };
+			AtomicLanes<real> a0 = { real(1.f) };
+			AtomicLanes<real> a1 = { real(0.f) };
+			AtomicLanes<real> b1 = { real(0.f) };
 			real output = { 0.f };
 			real previousInput = { 0.f };
 		};
@@ -0,0 +1,147 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "polyphaseresampler.h"
+
+// Std includes
+#include <memory>
+#include <mutex>
+
+// Nap includes
+#include <mathutils.h>
+#include <rtti/rtti.h>
+
+RTTI_BEGIN_ENUM(nap::audio::PolyphaseResampler::Quality)
+	RTTI_ENUM_VALUE(nap::audio::PolyphaseResampler::Quality::Linear, "Linear"),
+	RTTI_ENUM_VALUE(nap::audio::PolyphaseResampler::Quality::Low, "Low"),
+	RTTI_ENUM_VALUE(nap::audio::PolyphaseResampler::Quality::Medium, "Medium"),
+	RTTI_ENUM_VALUE(nap::audio::PolyphaseResampler::Quality::High, "High")
+RTTI_END_ENUM
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		// Zeroth order modified Bessel function of the first kind, for the Kaiser window
+		static double besselI0(double x)
+		{
+			double result = 1.0;
+			double term = 1.0;
+			for (auto k = 1; k < 50; ++k)
+			{
+				term *= (0.5 * x / k) * (0.5 * x / k);
+				result += term;
+				if (term < result * 1e-12)
+					break;
+			}
+			return result;
+		}
+
+
+		PolyphaseResampler::PolyphaseResampler(Quality quality) : mQuality(quality), mKernels(&getSimdKernels())
+		{
+			if (mQuality != Quality::Linear)
+				for (auto band = 0; band < BandCount; ++band)
+					mTables[band] = &getTable(mQuality, band);
+		}
+
+
+		const PolyphaseResampler::Table& PolyphaseResampler::getTable(Quality quality, int band)
+		{
+			static std::mutex mutex;
+			static std::unique_ptr<Table> tables[4][BandCount];
+
+			std::lock_guard<std::mutex> lock(mutex);
+			auto& table = tables[int(quality)][band];
+			if (table != nullptr)
+				return *table;
+
+			// Base kernel length, cutoff as a fraction of the Nyquist frequency and Kaiser window shape per quality
+			int baseTapCount = 8;
+			double cutoff = 0.85;
+			double beta = 5.0;
+			if (quality == Quality::Medium)
+			{
+				baseTapCount = 16;
+				cutoff = 0.9;
+				beta = 7.0;
+			}
+			else if (quality == Quality::High)
+			{
+				baseTapCount = 32;
+				cutoff = 0.95;
+				beta = 9.0;
+			}
+
+			// The band covers speeds up to 2 to the power of band / 2, the kernel stretches with the speed
+			auto maxSpeed = std::pow(2.0, 0.5 * band);
+			cutoff /= maxSpeed;
+
+			table = std::make_unique<Table>();
+			table->mTapCount = (int(std::ceil(baseTapCount * maxSpeed)) + 7) / 8 * 8;
+			auto tapCount = table->mTapCount;
+			auto half = tapCount / 2;
+			table->mCoefficients.resize(size_t(PhaseCount + 1) * tapCount);
+			auto windowNormalization = 1.0 / besselI0(beta);
+
+			// Tap j of phase p weighs the input sample at j - half + 1 relative to the integer part of the position, with a fraction of p / PhaseCount
+			for (auto phase = 0; phase <= PhaseCount; ++phase)
+			{
+				auto row = &table->mCoefficients[size_t(phase) * tapCount];
+				auto fraction = double(phase) / PhaseCount;
+				double sum = 0.0;
+				for (auto tap = 0; tap < tapCount; ++tap)
+				{
+					auto distance = tap - half + 1 - fraction;
+					auto x = cutoff * distance;
+					auto sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(math::PI * x) / (math::PI * x);
+					auto w = distance / half;
+					auto window = std::abs(w) >= 1.0 ? 0.0 : besselI0(beta * std::sqrt(1.0 - w * w)) * windowNormalization;
+					row[tap] = float(cutoff * sinc * window);
+					sum += row[tap];
+				}
+
+				// Unity gain at DC for every phase
+				for (auto tap = 0; tap < tapCount; ++tap)
+					row[tap] = float(row[tap] / sum);
+			}
+
+			return *table;
+		}
+
+
+		void PolyphaseResampler::render(const float* input, double position, double speed, float* output, int count) const
+		{
+			if (mQuality == Quality::Linear)
+			{
+				for (auto i = 0; i < count; ++i)
+				{
+					auto samplePosition = position + speed * i;
+					auto index = int(samplePosition);
+					auto fraction = float(samplePosition - index);
+					output[i] = input[index] + (input[index + 1] - input[index]) * fraction;
+				}
+				return;
+			}
+
+			const auto& table = *mTables[getBand(speed)];
+			const auto tapCount = table.mTapCount;
+			const auto half = tapCount / 2;
+			const auto kernel = mKernels->polyphase;
+			for (auto i = 0; i < count; ++i)
+			{
+				auto samplePosition = position + speed * i;
+				auto index = int(samplePosition);
+				auto phase = float(samplePosition - index) * PhaseCount;
+				auto phaseIndex = std::min(int(phase), PhaseCount - 1);
+				auto coefficients = &table.mCoefficients[size_t(phaseIndex) * tapCount];
+				output[i] = kernel(input + index - half + 1, coefficients, coefficients + tapCount, phase - phaseIndex, tapCount);
+			}
+		}
+
+	}
+
+}
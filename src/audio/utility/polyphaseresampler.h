@@ -0,0 +1,130 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Audio includes
+#include <audio/utility/audiotypes.h>
+#include <audio/utility/simddispatch.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Band limited interpolation of a signal at fractional positions, used to play material at a different speed or sample rate.
+		 * The windowed sinc kernel is precomputed in tables of PhaseCount phases, the two phases around a position are evaluated with the
+		 * polyphase kernel of @SimdKernels and interpolated.
+		 * When the signal is played faster than its original speed the cutoff of the kernel is lowered to prevent aliasing.
+		 * For that there is a table per speed band, with a kernel that is longer by the same factor as the cutoff is lower.
+		 * The tables are shared by all resamplers of the same quality and are computed once, by the constructor.
+		 */
+		class NAPAPI PolyphaseResampler
+		{
+		public:
+			/**
+			 * Length of the kernel and steepness of its cutoff.
+			 */
+			enum class Quality
+			{
+				Linear, ///< Two point linear interpolation, no anti aliasing
+				Low,    ///< 8 point kernel
+				Medium, ///< 16 point kernel
+				High    ///< 32 point kernel
+			};
+
+			static constexpr int PhaseCount = 256;  ///< Number of phases in every table
+			static constexpr int BandCount = 5;     ///< Number of speed bands, the fastest covers speeds up to 4. Faster speeds alias.
+			static constexpr int ScratchSize = 1024; ///< Minimum size of the scratch buffer passed to process().
+
+			/**
+			 * Constructor, computes the tables for the quality if they do not exist yet.
+			 * @param quality The quality
+			 */
+			PolyphaseResampler(Quality quality = Quality::Medium);
+
+			/**
+			 * @return The quality
+			 */
+			Quality getQuality() const { return mQuality; }
+
+			/**
+			 * @param speed Number of input samples per output sample, negative when playing backwards.
+			 * @return Number of samples read before the integer part and after the next sample of a position, at the given speed.
+			 */
+			int getPadding(double speed) const { return mQuality == Quality::Linear ? 0 : mTables[getBand(speed)]->mTapCount / 2; }
+
+			/**
+			 * @return The padding at the fastest speed band, the most input ever read around a position.
+			 */
+			int getMaxPadding() const { return getPadding(0.5 * (1 << BandCount)); }
+
+			/**
+			 * Renders count output samples reading at position, position + speed, position + 2 * speed, and so on.
+			 * The input is requested through reader in contiguous chunks that fit in the scratch buffer:
+			 * reader(float* destination, int64_t first, int count) should write the input samples from first up to first + count to destination.
+			 * First can be negative when reading around the start of the input.
+			 * The positions requested range from getPadding() before the lowest position to getPadding() + 1 after the highest position.
+			 * @param reader Callable that supplies the input
+			 * @param position Position of the first output sample in the input, in samples.
+			 * @param speed Number of input samples per output sample, negative when playing backwards.
+			 * @param output Receives count samples
+			 * @param count Number of output samples
+			 * @param scratch Buffer of at least ScratchSize samples
+			 */
+			template <typename Reader>
+			void process(const Reader& reader, double position, double speed, float* output, int count, float* scratch) const;
+
+		private:
+			// Coefficients of all phases of one speed band: PhaseCount + 1 rows of mTapCount coefficients
+			struct Table
+			{
+				int mTapCount = 0;
+				std::vector<float> mCoefficients;
+			};
+
+			static const Table& getTable(Quality quality, int band);
+
+			int getBand(double speed) const { return std::min(int(std::ceil(2.0 * std::log2(std::max(std::abs(speed), 1.0)))), BandCount - 1); }
+
+			// Renders from contiguous input, position is relative to input
+			void render(const float* input, double position, double speed, float* output, int count) const;
+
+			Quality mQuality = Quality::Medium;
+			const Table* mTables[BandCount] = { };
+			const SimdKernels* mKernels = nullptr;
+		};
+
+
+		template <typename Reader>
+		void PolyphaseResampler::process(const Reader& reader, double position, double speed, float* output, int count, float* scratch) const
+		{
+			const auto padding = getPadding(speed);
+			const auto margin = 2 * padding + 3;
+			auto i = 0;
+			while (i < count)
+			{
+				// Split the block so the input it reads fits in the scratch buffer
+				auto chunk = int(std::min<double>(count - i, (ScratchSize - margin) / std::max(std::abs(speed), 0.001) + 1.0));
+				auto end = position + speed * (chunk - 1);
+				auto first = int64_t(std::floor(std::min(position, end))) - padding;
+				auto last = int64_t(std::floor(std::max(position, end))) + padding + 1;
+				reader(scratch, first, int(last - first + 1));
+				render(scratch, position - first, speed, output + i, chunk);
+				position += speed * chunk;
+				i += chunk;
+			}
+		}
+
+	}
+
+}
@@ -0,0 +1,168 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Nap includes
+#include <mathutils.h>
+
+// Audio includes
+#include <audio/utility/audiotypes.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * The part of a block of frames that lies within a sample, as offsets into the block.
+		 */
+		struct FrameRange
+		{
+			int mBegin = 0; ///< Offset of the first frame within the sample
+			int mEnd = 0;   ///< Offset of the frame after the last frame within the sample, not before mBegin.
+		};
+
+		/**
+		 * Clamps a block of frames to the frames of a sample, used by readers and writers that skip or silence the frames outside the sample.
+		 * @param first First frame of the block, may lie before the start of the sample.
+		 * @param count Number of frames in the block
+		 * @param size Number of frames of the sample
+		 * @param destination When not null, the frames of the block outside the sample are set to silence.
+		 * @return The part of the block within the sample
+		 */
+		inline FrameRange clampFrames(int64_t first, int count, DiscreteTimeValue size, float* destination = nullptr)
+		{
+			FrameRange range;
+			range.mBegin = int(std::clamp<int64_t>(-first, 0, count));
+			range.mEnd = int(std::clamp<int64_t>(int64_t(size) - first, range.mBegin, count));
+			if (destination != nullptr)
+			{
+				std::fill(destination, destination + range.mBegin, 0.f);
+				std::fill(destination + range.mEnd, destination + count, 0.f);
+			}
+			return range;
+		}
+
+
+		/**
+		 * Playback section of a sample: it starts at a frame and either plays to the end of the sample or repeats the section between two loop points.
+		 * A looping section is played as one continuous run of frames, counted from the start: up to the loop end, and after that the loop over and over again.
+		 * Every repetition starts with an equal power crossfade from the last frames before the loop end into the first frames of the loop,
+		 * so the loop points are sample accurate and the seam has no gap and no change in loudness.
+		 */
+		struct SampleLoop
+		{
+			static constexpr DiscreteTimeValue Endless = ~DiscreteTimeValue(0); ///< Length of a section that loops
+
+			DiscreteTimeValue mStart = 0;                ///< First frame
+			bool mLoop = false;                          ///< Whether the section between the loop points repeats. Otherwise the section ends at the end of the sample.
+			DiscreteTimeValue mLoopStart = 0;            ///< First frame of the loop
+			DiscreteTimeValue mLoopEnd = 0;              ///< Frame after the end of the loop, after the start and the loop start.
+			DiscreteTimeValue mCrossFade = 0;            ///< Length of the crossfade, the last frames before the loop end fade into the first frames of the loop.
+
+			/**
+			 * @return Whether the section repeats: it loops and the loop is longer than its crossfade.
+			 */
+			bool isLooping() const { return mLoop && mLoopEnd > mLoopStart + mCrossFade; }
+
+			/**
+			 * @param size Number of frames of the sample
+			 * @return The number of frames in the section, or Endless when it loops.
+			 */
+			DiscreteTimeValue getLength(DiscreteTimeValue size) const
+			{
+				if (isLooping())
+					return Endless;
+				return size > mStart ? size - mStart : 0;
+			}
+
+			/**
+			 * @param size Number of frames of the sample
+			 * @return The number of frames before the section first reaches the crossfade of its loop, or its length when it does not loop.
+			 */
+			DiscreteTimeValue getLinearLength(DiscreteTimeValue size) const
+			{
+				if (!isLooping())
+					return getLength(size);
+				auto fadeStart = mLoopEnd - mCrossFade;
+				return fadeStart > mStart ? fadeStart - mStart : 0;
+			}
+
+			/**
+			 * Reads frames of the section from a channel of a sample.
+			 * The source provides read(int64_t first, int count, float* destination), which reads silence outside the sample,
+			 * and getSample(DiscreteTimeValue frame) for frames within the sample.
+			 * @param source The channel to read from
+			 * @param size Number of frames of the sample
+			 * @param first The first frame, relative to the start of the section.
+			 * @param count The number of frames
+			 * @param destination Receives the frames
+			 */
+			template <typename Source>
+			void read(const Source& source, DiscreteTimeValue size, int64_t first, int count, float* destination) const
+			{
+				const int64_t start = mStart;
+				const int64_t loopStart = mLoopStart;
+				const int64_t crossFade = mCrossFade;
+				const int64_t fadeStart = int64_t(mLoopEnd) - crossFade;
+				const int64_t period = fadeStart - loopStart;
+				const bool loop = isLooping();
+
+				auto i = 0;
+				while (i < count)
+				{
+					// Up to the first crossfade, or without a loop, the section is the sample itself
+					auto frame = start + first + i;
+					if (!loop || frame < fadeStart)
+					{
+						auto n = loop ? int(std::min<int64_t>(count - i, fadeStart - frame)) : count - i;
+						source.read(frame, n, destination + i);
+						i += n;
+						continue;
+					}
+
+					// After that the section repeats the loop, every repetition starts with the crossfade from the end of the loop into its start
+					auto offset = (frame - fadeStart) % period;
+					if (offset < crossFade)
+					{
+						auto n = int(std::min<int64_t>(count - i, crossFade - offset));
+
+						// The gains of the equal power curve are rotated from frame to frame, so only the start of the run and the step need std::cos and std::sin
+						const double step = math::PI * 0.5 / crossFade;
+						const double stepCos = std::cos(step);
+						const double stepSin = std::sin(step);
+						double fadeOut = std::cos((offset + 0.5) * step);
+						double fadeIn = std::sin((offset + 0.5) * step);
+						for (auto j = 0; j < n; ++j)
+						{
+							DiscreteTimeValue out = fadeStart + offset + j;
+							DiscreteTimeValue in = loopStart + offset + j;
+							auto outSample = out < size ? source.getSample(out) : 0.f;
+							auto inSample = in < size ? source.getSample(in) : 0.f;
+							destination[i + j] = outSample * fadeOut + inSample * fadeIn;
+							auto nextFadeOut = fadeOut * stepCos - fadeIn * stepSin;
+							fadeIn = fadeIn * stepCos + fadeOut * stepSin;
+							fadeOut = nextFadeOut;
+						}
+						i += n;
+					}
+					else {
+						auto n = int(std::min<int64_t>(count - i, period - offset));
+						source.read(loopStart + offset, n, destination + i);
+						i += n;
+					}
+				}
+			}
+		};
+
+	}
+
+}
@@ -0,0 +1,568 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "simddispatch.h"
+
+// Std includes
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define NAP_SIMD_X86
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#endif
+
+// Functions marked with these attributes are compiled for the given instruction set, independent of the compiler flags of this translation unit.
+// MSVC compiles every intrinsic without extra flags.
+#if defined(NAP_SIMD_X86) && !defined(_MSC_VER)
+	#define NAP_TARGET_SSE2 __attribute__((target("sse2")))
+	#define NAP_TARGET_AVX2 __attribute__((target("avx2,fma")))
+	#define NAP_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+	#define NAP_TARGET_SSE2
+	#define NAP_TARGET_AVX2
+	#define NAP_TARGET_AVX512
+#endif
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+// --- Generic --- //
+
+		static void biquadBankSum8Generic(const float* input, float* output, int count, const float* coefficients, float* state)
+		{
+			float h1[8], h2[8];
+			for (auto lane = 0; lane < 8; ++lane)
+			{
+				h1[lane] = state[lane];
+				h2[lane] = state[8 + lane];
+			}
+
+			for (auto i = 0; i < count; ++i)
+			{
+				const float value = input[i];
+				float sum = 0.f;
+				for (auto lane = 0; lane < 8; ++lane)
+				{
+					const float result = value * coefficients[lane] + h1[lane];
+					h1[lane] = value * coefficients[8 + lane] + h2[lane] - coefficients[24 + lane] * result;
+					h2[lane] = value * coefficients[16 + lane] - coefficients[32 + lane] * result;
+					sum += result * coefficients[40 + lane];
+				}
+				output[i] = sum;
+			}
+
+			for (auto lane = 0; lane < 8; ++lane)
+			{
+				state[lane] = h1[lane];
+				state[8 + lane] = h2[lane];
+			}
+		}
+
+
+		static void mixGeneric(float* destination, const float* source, float gain, int count)
+		{
+			for (auto i = 0; i < count; ++i)
+				destination[i] += source[i] * gain;
+		}
+
+
+		static void waveTableGeneric(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count)
+		{
+			for (auto i = 0; i < count; ++i)
+			{
+				const int index = int(phase[i]);
+				const float fraction = phase[i] - index;
+				const float value1 = table[index & tableMask];
+				const float value2 = table[(index + 1) & tableMask];
+				output[i] = (value1 + (value2 - value1) * fraction) * amplitude[i];
+			}
+		}
+
+
+		static void waveTableCubicGeneric(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count)
+		{
+			for (auto i = 0; i < count; ++i)
+			{
+				const int index = int(phase[i]);
+				const float fraction = phase[i] - index;
+				const float previous = table[(index - 1) & tableMask];
+				const float value1 = table[index & tableMask];
+				const float value2 = table[(index + 1) & tableMask];
+				const float next = table[(index + 2) & tableMask];
+				const float c1 = 0.5f * (value2 - previous);
+				const float c2 = previous - 2.5f * value1 + 2.f * value2 - 0.5f * next;
+				const float c3 = 0.5f * (next - previous) + 1.5f * (value1 - value2);
+				output[i] = (((c3 * fraction + c2) * fraction + c1) * fraction + value1) * amplitude[i];
+			}
+		}
+
+
+		static float polyphaseGeneric(const float* input, const float* coefficients1, const float* coefficients2, float fraction, int count)
+		{
+			float sum1 = 0.f;
+			float sum2 = 0.f;
+			for (auto i = 0; i < count; ++i)
+			{
+				sum1 += input[i] * coefficients1[i];
+				sum2 += input[i] * coefficients2[i];
+			}
+			return sum1 + (sum2 - sum1) * fraction;
+		}
+
+
+		static void decodePCM16Generic(const int16_t* input, float* output, int count)
+		{
+			for (auto i = 0; i < count; ++i)
+				output[i] = input[i] * (1.f / 32768.f);
+		}
+
+
+		static void decodePCM24Generic(const uint8_t* input, float* output, int count)
+		{
+			for (auto i = 0; i < count; ++i)
+			{
+				// Assemble the sample in the upper 3 bytes, the arithmetic shift extends the sign
+				const uint32_t bytes = uint32_t(input[3 * i]) << 8 | uint32_t(input[3 * i + 1]) << 16 | uint32_t(input[3 * i + 2]) << 24;
+				output[i] = (int32_t(bytes) >> 8) * (1.f / 8388608.f);
+			}
+		}
+
+
+#ifdef NAP_SIMD_X86
+
+// --- SSE2 --- //
+
+		NAP_TARGET_SSE2 static void biquadBankSum8SSE2(const float* input, float* output, int count, const float* coefficients, float* state)
+		{
+			// The 8 lanes are processed as two halves of 4
+			__m128 a0[2], a1[2], a2[2], b1[2], b2[2], gain[2], h1[2], h2[2];
+			for (auto half = 0; half < 2; ++half)
+			{
+				a0[half] = _mm_loadu_ps(coefficients + 4 * half);
+				a1[half] = _mm_loadu_ps(coefficients + 8 + 4 * half);
+				a2[half] = _mm_loadu_ps(coefficients + 16 + 4 * half);
+				b1[half] = _mm_loadu_ps(coefficients + 24 + 4 * half);
+				b2[half] = _mm_loadu_ps(coefficients + 32 + 4 * half);
+				gain[half] = _mm_loadu_ps(coefficients + 40 + 4 * half);
+				h1[half] = _mm_loadu_ps(state + 4 * half);
+				h2[half] = _mm_loadu_ps(state + 8 + 4 * half);
+			}
+
+			for (auto i = 0; i < count; ++i)
+			{
+				const __m128 value = _mm_set1_ps(input[i]);
+				__m128 sum = _mm_setzero_ps();
+				for (auto half = 0; half < 2; ++half)
+				{
+					const __m128 result = _mm_add_ps(_mm_mul_ps(value, a0[half]), h1[half]);
+					h1[half] = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(value, a1[half]), h2[half]), _mm_mul_ps(b1[half], result));
+					h2[half] = _mm_sub_ps(_mm_mul_ps(value, a2[half]), _mm_mul_ps(b2[half], result));
+					sum = _mm_add_ps(sum, _mm_mul_ps(result, gain[half]));
+				}
+				sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+				sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+				output[i] = _mm_cvtss_f32(sum);
+			}
+
+			for (auto half = 0; half < 2; ++half)
+			{
+				_mm_storeu_ps(state + 4 * half, h1[half]);
+				_mm_storeu_ps(state + 8 + 4 * half, h2[half]);
+			}
+		}
+
+
+		NAP_TARGET_SSE2 static void mixSSE2(float* destination, const float* source, float gain, int count)
+		{
+			const __m128 gainVector = _mm_set1_ps(gain);
+			auto i = 0;
+			for (; i + 4 <= count; i += 4)
+				_mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), _mm_mul_ps(_mm_loadu_ps(source + i), gainVector)));
+			for (; i < count; ++i)
+				destination[i] += source[i] * gain;
+		}
+
+
+		NAP_TARGET_SSE2 static float polyphaseSSE2(const float* input, const float* coefficients1, const float* coefficients2, float fraction, int count)
+		{
+			__m128 sum1 = _mm_setzero_ps();
+			__m128 sum2 = _mm_setzero_ps();
+			for (auto i = 0; i < count; i += 4)
+			{
+				const __m128 value = _mm_loadu_ps(input + i);
+				sum1 = _mm_add_ps(sum1, _mm_mul_ps(value, _mm_loadu_ps(coefficients1 + i)));
+				sum2 = _mm_add_ps(sum2, _mm_mul_ps(value, _mm_loadu_ps(coefficients2 + i)));
+			}
+			__m128 sum = _mm_add_ps(sum1, _mm_mul_ps(_mm_sub_ps(sum2, sum1), _mm_set1_ps(fraction)));
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+			return _mm_cvtss_f32(sum);
+		}
+
+
+		NAP_TARGET_SSE2 static void decodePCM16SSE2(const int16_t* input, float* output, int count)
+		{
+			const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+			auto i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				// Unpacking a value with itself and shifting back extends the sign
+				const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+				const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+				const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+				_mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+				_mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+			}
+			decodePCM16Generic(input + i, output + i, count - i);
+		}
+
+
+// --- AVX2 --- //
+
+		NAP_TARGET_AVX2 static void biquadBankSum8AVX2(const float* input, float* output, int count, const float* coefficients, float* state)
+		{
+			const __m256 a0 = _mm256_loadu_ps(coefficients);
+			const __m256 a1 = _mm256_loadu_ps(coefficients + 8);
+			const __m256 a2 = _mm256_loadu_ps(coefficients + 16);
+			const __m256 b1 = _mm256_loadu_ps(coefficients + 24);
+			const __m256 b2 = _mm256_loadu_ps(coefficients + 32);
+			const __m256 gain = _mm256_loadu_ps(coefficients + 40);
+			__m256 h1 = _mm256_loadu_ps(state);
+			__m256 h2 = _mm256_loadu_ps(state + 8);
+
+			for (auto i = 0; i < count; ++i)
+			{
+				const __m256 value = _mm256_set1_ps(input[i]);
+				const __m256 result = _mm256_fmadd_ps(value, a0, h1);
+				h1 = _mm256_fnmadd_ps(b1, result, _mm256_fmadd_ps(value, a1, h2));
+				h2 = _mm256_fnmadd_ps(b2, result, _mm256_mul_ps(value, a2));
+				const __m256 weighted = _mm256_mul_ps(result, gain);
+				__m128 sum = _mm_add_ps(_mm256_castps256_ps128(weighted), _mm256_extractf128_ps(weighted, 1));
+				sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+				sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+				output[i] = _mm_cvtss_f32(sum);
+			}
+
+			_mm256_storeu_ps(state, h1);
+			_mm256_storeu_ps(state + 8, h2);
+		}
+
+
+		NAP_TARGET_AVX2 static void mixAVX2(float* destination, const float* source, float gain, int count)
+		{
+			const __m256 gainVector = _mm256_set1_ps(gain);
+			auto i = 0;
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(destination + i, _mm256_fmadd_ps(_mm256_loadu_ps(source + i), gainVector, _mm256_loadu_ps(destination + i)));
+			for (; i < count; ++i)
+				destination[i] += source[i] * gain;
+		}
+
+
+		NAP_TARGET_AVX2 static void waveTableAVX2(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count)
+		{
+			const __m256i mask = _mm256_set1_epi32(tableMask);
+			const __m256i one = _mm256_set1_epi32(1);
+			auto i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 position = _mm256_loadu_ps(phase + i);
+				const __m256 floor = _mm256_floor_ps(position);
+				const __m256 fraction = _mm256_sub_ps(position, floor);
+				const __m256i index = _mm256_and_si256(_mm256_cvttps_epi32(floor), mask);
+				const __m256i next = _mm256_and_si256(_mm256_add_epi32(index, one), mask);
+				const __m256 value1 = _mm256_i32gather_ps(table, index, 4);
+				const __m256 value2 = _mm256_i32gather_ps(table, next, 4);
+				const __m256 value = _mm256_fmadd_ps(_mm256_sub_ps(value2, value1), fraction, value1);
+				_mm256_storeu_ps(output + i, _mm256_mul_ps(value, _mm256_loadu_ps(amplitude + i)));
+			}
+			waveTableGeneric(table, tableMask, phase + i, amplitude + i, output + i, count - i);
+		}
+
+
+		NAP_TARGET_AVX2 static void waveTableCubicAVX2(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count)
+		{
+			const __m256i mask = _mm256_set1_epi32(tableMask);
+			const __m256i one = _mm256_set1_epi32(1);
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 oneAndHalf = _mm256_set1_ps(1.5f);
+			const __m256 two = _mm256_set1_ps(2.f);
+			const __m256 twoAndHalf = _mm256_set1_ps(2.5f);
+			auto i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 position = _mm256_loadu_ps(phase + i);
+				const __m256 floor = _mm256_floor_ps(position);
+				const __m256 fraction = _mm256_sub_ps(position, floor);
+				const __m256i index = _mm256_cvttps_epi32(floor);
+				const __m256i index1 = _mm256_and_si256(index, mask);
+				const __m256i index0 = _mm256_and_si256(_mm256_sub_epi32(index, one), mask);
+				const __m256i index2 = _mm256_and_si256(_mm256_add_epi32(index, one), mask);
+				const __m256i index3 = _mm256_and_si256(_mm256_add_epi32(index2, one), mask);
+				const __m256 previous = _mm256_i32gather_ps(table, index0, 4);
+				const __m256 value1 = _mm256_i32gather_ps(table, index1, 4);
+				const __m256 value2 = _mm256_i32gather_ps(table, index2, 4);
+				const __m256 next = _mm256_i32gather_ps(table, index3, 4);
+				const __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(value2, previous));
+				const __m256 c2 = _mm256_fnmadd_ps(half, next, _mm256_fmadd_ps(two, value2, _mm256_fnmadd_ps(twoAndHalf, value1, previous)));
+				const __m256 c3 = _mm256_fmadd_ps(half, _mm256_sub_ps(next, previous), _mm256_mul_ps(oneAndHalf, _mm256_sub_ps(value1, value2)));
+				const __m256 value = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_fmadd_ps(c3, fraction, c2), fraction, c1), fraction, value1);
+				_mm256_storeu_ps(output + i, _mm256_mul_ps(value, _mm256_loadu_ps(amplitude + i)));
+			}
+			waveTableCubicGeneric(table, tableMask, phase + i, amplitude + i, output + i, count - i);
+		}
+
+
+		NAP_TARGET_AVX2 static float polyphaseAVX2(const float* input, const float* coefficients1, const float* coefficients2, float fraction, int count)
+		{
+			__m256 sum1 = _mm256_setzero_ps();
+			__m256 sum2 = _mm256_setzero_ps();
+			for (auto i = 0; i < count; i += 8)
+			{
+				const __m256 value = _mm256_loadu_ps(input + i);
+				sum1 = _mm256_fmadd_ps(value, _mm256_loadu_ps(coefficients1 + i), sum1);
+				sum2 = _mm256_fmadd_ps(value, _mm256_loadu_ps(coefficients2 + i), sum2);
+			}
+			const __m256 interpolated = _mm256_fmadd_ps(_mm256_sub_ps(sum2, sum1), _mm256_set1_ps(fraction), sum1);
+			__m128 sum = _mm_add_ps(_mm256_castps256_ps128(interpolated), _mm256_extractf128_ps(interpolated, 1));
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+			return _mm_cvtss_f32(sum);
+		}
+
+
+		NAP_TARGET_AVX2 static void decodePCM16AVX2(const int16_t* input, float* output, int count)
+		{
+			const __m256 scale = _mm256_set1_ps(1.f / 32768.f);
+			auto i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+				_mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+			}
+			decodePCM16Generic(input + i, output + i, count - i);
+		}
+
+
+		NAP_TARGET_AVX2 static void decodePCM24AVX2(const uint8_t* input, float* output, int count)
+		{
+			// 8 samples take 24 bytes: the upper lane gets bytes 12 to 27, so both lanes hold 4 samples at byte 0, 3, 6 and 9.
+			// Every sample is shuffled into the upper 3 bytes of its 32 bit lane, the arithmetic shift extends the sign.
+			const __m256i permute = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+			const __m256i shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+													 -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+			const __m256 scale = _mm256_set1_ps(1.f / 8388608.f);
+			auto i = 0;
+
+			// Every load reads 32 bytes, stop while they are all part of the input
+			for (; i + 11 <= count; i += 8)
+			{
+				__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + 3 * i));
+				bytes = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(bytes, permute), shuffle);
+				_mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(bytes, 8)), scale));
+			}
+			decodePCM24Generic(input + 3 * i, output + i, count - i);
+		}
+
+
+// --- AVX-512 --- //
+
+		NAP_TARGET_AVX512 static void mixAVX512(float* destination, const float* source, float gain, int count)
+		{
+			const __m512 gainVector = _mm512_set1_ps(gain);
+			auto i = 0;
+			for (; i + 16 <= count; i += 16)
+				_mm512_storeu_ps(destination + i, _mm512_fmadd_ps(_mm512_loadu_ps(source + i), gainVector, _mm512_loadu_ps(destination + i)));
+			mixAVX2(destination + i, source + i, gain, count - i);
+		}
+
+
+		NAP_TARGET_AVX512 static void waveTableAVX512(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count)
+		{
+			const __m512i mask = _mm512_set1_epi32(tableMask);
+			const __m512i one = _mm512_set1_epi32(1);
+			auto i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m512 position = _mm512_loadu_ps(phase + i);
+				const __m512 floor = _mm512_roundscale_ps(position, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+				const __m512 fraction = _mm512_sub_ps(position, floor);
+				const __m512i index = _mm512_and_epi32(_mm512_cvttps_epi32(floor), mask);
+				const __m512i next = _mm512_and_epi32(_mm512_add_epi32(index, one), mask);
+				const __m512 value1 = _mm512_i32gather_ps(index, table, 4);
+				const __m512 value2 = _mm512_i32gather_ps(next, table, 4);
+				const __m512 value = _mm512_fmadd_ps(_mm512_sub_ps(value2, value1), fraction, value1);
+				_mm512_storeu_ps(output + i, _mm512_mul_ps(value, _mm512_loadu_ps(amplitude + i)));
+			}
+			waveTableAVX2(table, tableMask, phase + i, amplitude + i, output + i, count - i);
+		}
+
+
+		NAP_TARGET_AVX512 static void waveTableCubicAVX512(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count)
+		{
+			const __m512i mask = _mm512_set1_epi32(tableMask);
+			const __m512i one = _mm512_set1_epi32(1);
+			const __m512 half = _mm512_set1_ps(0.5f);
+			const __m512 oneAndHalf = _mm512_set1_ps(1.5f);
+			const __m512 two = _mm512_set1_ps(2.f);
+			const __m512 twoAndHalf = _mm512_set1_ps(2.5f);
+			auto i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m512 position = _mm512_loadu_ps(phase + i);
+				const __m512 floor = _mm512_roundscale_ps(position, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+				const __m512 fraction = _mm512_sub_ps(position, floor);
+				const __m512i index = _mm512_cvttps_epi32(floor);
+				const __m512i index1 = _mm512_and_epi32(index, mask);
+				const __m512i index0 = _mm512_and_epi32(_mm512_sub_epi32(index, one), mask);
+				const __m512i index2 = _mm512_and_epi32(_mm512_add_epi32(index, one), mask);
+				const __m512i index3 = _mm512_and_epi32(_mm512_add_epi32(index2, one), mask);
+				const __m512 previous = _mm512_i32gather_ps(index0, table, 4);
+				const __m512 value1 = _mm512_i32gather_ps(index1, table, 4);
+				const __m512 value2 = _mm512_i32gather_ps(index2, table, 4);
+				const __m512 next = _mm512_i32gather_ps(index3, table, 4);
+				const __m512 c1 = _mm512_mul_ps(half, _mm512_sub_ps(value2, previous));
+				const __m512 c2 = _mm512_fnmadd_ps(half, next, _mm512_fmadd_ps(two, value2, _mm512_fnmadd_ps(twoAndHalf, value1, previous)));
+				const __m512 c3 = _mm512_fmadd_ps(half, _mm512_sub_ps(next, previous), _mm512_mul_ps(oneAndHalf, _mm512_sub_ps(value1, value2)));
+				const __m512 value = _mm512_fmadd_ps(_mm512_fmadd_ps(_mm512_fmadd_ps(c3, fraction, c2), fraction, c1), fraction, value1);
+				_mm512_storeu_ps(output + i, _mm512_mul_ps(value, _mm512_loadu_ps(amplitude + i)));
+			}
+			waveTableCubicAVX2(table, tableMask, phase + i, amplitude + i, output + i, count - i);
+		}
+
+
+		NAP_TARGET_AVX512 static void decodePCM16AVX512(const int16_t* input, float* output, int count)
+		{
+			const __m512 scale = _mm512_set1_ps(1.f / 32768.f);
+			auto i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m512i samples = _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)));
+				_mm512_storeu_ps(output + i, _mm512_mul_ps(_mm512_cvtepi32_ps(samples), scale));
+			}
+			decodePCM16AVX2(input + i, output + i, count - i);
+		}
+
+#endif // NAP_SIMD_X86
+
+
+// --- Detection --- //
+
+		SimdLevel detectSimdLevel()
+		{
+#if defined(NAP_SIMD_X86) && defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			const int maxLeaf = info[0];
+			__cpuid(info, 1);
+			const bool sse2 = (info[3] & (1 << 26)) != 0;
+			const bool fma = (info[2] & (1 << 12)) != 0;
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+
+			// Check that the operating system saves the AVX (YMM) and AVX-512 (opmask, ZMM) registers
+			const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+			const bool avxState = (xcr0 & 0x6) == 0x6;
+			const bool avx512State = (xcr0 & 0xe6) == 0xe6;
+
+			bool avx2 = false;
+			bool avx512 = false;
+			if (maxLeaf >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+				avx512 = (info[1] & (1 << 16)) != 0;
+			}
+
+			if (avx512 && avx2 && fma && avx512State)
+				return SimdLevel::AVX512;
+			if (avx2 && fma && avxState)
+				return SimdLevel::AVX2;
+			if (sse2)
+				return SimdLevel::SSE2;
+			return SimdLevel::Generic;
+#elif defined(NAP_SIMD_X86)
+			// The builtins also verify that the operating system saves the extended registers
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				return SimdLevel::AVX512;
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				return SimdLevel::AVX2;
+			if (__builtin_cpu_supports("sse2"))
+				return SimdLevel::SSE2;
+			return SimdLevel::Generic;
+#else
+			return SimdLevel::Generic;
+#endif
+		}
+
+
+		static SimdKernels createSimdKernels()
+		{
+			SimdKernels kernels;
+			kernels.biquadBankSum8 = &biquadBankSum8Generic;
+			kernels.mix = &mixGeneric;
+			kernels.waveTable = &waveTableGeneric;
+			kernels.waveTableCubic = &waveTableCubicGeneric;
+			kernels.polyphase = &polyphaseGeneric;
+			kernels.decodePCM16 = &decodePCM16Generic;
+			kernels.decodePCM24 = &decodePCM24Generic;
+			kernels.level = detectSimdLevel();
+
+#ifdef NAP_SIMD_X86
+			switch (kernels.level)
+			{
+				case SimdLevel::AVX512:
+					// float8 filter banks do not get wider with AVX-512, they share the AVX2 kernel
+					kernels.biquadBankSum8 = &biquadBankSum8AVX2;
+					kernels.mix = &mixAVX512;
+					kernels.waveTable = &waveTableAVX512;
+					kernels.waveTableCubic = &waveTableCubicAVX512;
+					// The kernels of the resampler are too short to gain from 16 lanes
+					kernels.polyphase = &polyphaseAVX2;
+					kernels.decodePCM16 = &decodePCM16AVX512;
+					// Packed 24 bit samples need byte shuffles across the full register, which AVX-512F lacks
+					kernels.decodePCM24 = &decodePCM24AVX2;
+					break;
+				case SimdLevel::AVX2:
+					kernels.biquadBankSum8 = &biquadBankSum8AVX2;
+					kernels.mix = &mixAVX2;
+					kernels.waveTable = &waveTableAVX2;
+					kernels.waveTableCubic = &waveTableCubicAVX2;
+					kernels.polyphase = &polyphaseAVX2;
+					kernels.decodePCM16 = &decodePCM16AVX2;
+					kernels.decodePCM24 = &decodePCM24AVX2;
+					break;
+				case SimdLevel::SSE2:
+					// Without gather instructions the wavetable lookup gains nothing over the generic version
+					// and without byte shuffles neither does the 24 bit decoder
+					kernels.biquadBankSum8 = &biquadBankSum8SSE2;
+					kernels.mix = &mixSSE2;
+					kernels.polyphase = &polyphaseSSE2;
+					kernels.decodePCM16 = &decodePCM16SSE2;
+					break;
+				case SimdLevel::Generic:
+					break;
+			}
+#endif
+
+			return kernels;
+		}
+
+
+		const SimdKernels& getSimdKernels()
+		{
+			static const SimdKernels kernels = createSimdKernels();
+			return kernels;
+		}
+
+	}
+
+}
@@ -0,0 +1,90 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+// Std includes
+#include <cstdint>
+
+// Nap includes
+#include <utility/dllexport.h>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Instruction set levels that have a dedicated kernel implementation.
+		 * Generic is plain C++ and is used on non x86 hosts.
+		 */
+		enum class SimdLevel { Generic, SSE2, AVX2, AVX512 };
+
+
+		/**
+		 * Table of function pointers to the hot DSP kernels, compiled for every instruction set in @SimdLevel.
+		 * The table is filled once, on first use, with the fastest variant the host CPU supports.
+		 * This way one binary runs at full speed on every x86 machine, independent of the compile time vector extension settings.
+		 */
+		struct NAPAPI SimdKernels
+		{
+			/**
+			 * Runs count samples of mono input through a bank of 8 parallel biquad filters and writes the sum of the 8 filter outputs to output.
+			 * Input and output are allowed to be the same buffer.
+			 * @param coefficients 48 values: 8 lanes of a0, a1, a2, b1, b2 and output gain.
+			 * @param state 16 values: 8 lanes of the h1 and h2 filter states. Updated by the call.
+			 */
+			void (*biquadBankSum8)(const float* input, float* output, int count, const float* coefficients, float* state) = nullptr;
+
+			/**
+			 * Adds source multiplied by gain to destination.
+			 */
+			void (*mix)(float* destination, const float* source, float gain, int count) = nullptr;
+
+			/**
+			 * Linearly interpolating wavetable lookup: output[i] = table(phase[i]) * amplitude[i].
+			 * The table size has to be a power of two, tableMask is the size minus one.
+			 * Phase values have to be non negative, positions at or beyond the end of the table wrap around with the mask.
+			 */
+			void (*waveTable)(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count) = nullptr;
+
+			/**
+			 * Same as waveTable, using 4 point cubic Hermite interpolation.
+			 */
+			void (*waveTableCubic)(const float* table, int tableMask, const float* phase, const float* amplitude, float* output, int count) = nullptr;
+
+			/**
+			 * Polyphase filter tap: the inner products of input with two rows of coefficients, linearly interpolated by fraction.
+			 * Used by the @PolyphaseResampler. Count has to be a multiple of 8.
+			 */
+			float (*polyphase)(const float* input, const float* coefficients1, const float* coefficients2, float fraction, int count) = nullptr;
+
+			/**
+			 * Converts 16 bit signed integer samples to floats between -1 and 1.
+			 */
+			void (*decodePCM16)(const int16_t* input, float* output, int count) = nullptr;
+
+			/**
+			 * Converts packed little endian 24 bit signed integer samples, 3 bytes per sample, to floats between -1 and 1.
+			 */
+			void (*decodePCM24)(const uint8_t* input, float* output, int count) = nullptr;
+
+			SimdLevel level = SimdLevel::Generic; ///< The instruction set the kernels in this table are compiled for.
+		};
+
+
+		/**
+		 * @return The highest @SimdLevel supported by both the host CPU and the operating system.
+		 */
+		NAPAPI SimdLevel detectSimdLevel();
+
+		/**
+		 * @return The kernel table for the host CPU. Detection runs on the first call, which is thread safe.
+		 */
+		NAPAPI const SimdKernels& getSimdKernels();
+
+	}
+
+}
@@ -5,8 +5,8 @@
 #pragma once
 
 #include <audio/utility/audiotypes.h>
-#include <audio/utility/delay.h>
-#include <memory>
+#include <audio/utility/delayline.h>
+#include <atomic>
 
 namespace nap
 {
@@ -23,16 +23,14 @@ namespace nap
 			SingleDelay() = default;
 
 			/**
-			 * Flushes the delay line
+			 * Allocates and flushes the delay line
              * Should only be called from the audio thread.
-			 * @param maxDelay Size of the delay line, also maximum delay time in samples.
+			 * @param memory The arena the delay line is allocated from.
+			 * @param maxDelay Maximum delay time in samples.
 			 */
-			void reset(int maxDelay)
+			void reset(DelayMemory& memory, int maxDelay)
 			{
-				int size = 2048;
-				while (size < maxDelay)
-					size *= 2;
-				mDelay = std::make_unique<Delay>(size);
+				mDelay.allocate(memory, maxDelay);
 			}
 
 			/**
@@ -41,7 +39,7 @@ namespace nap
 			 */
 			void setDelay(ControllerValue sampleTime)
 			{
-				assert(mTime <= mDelay->getMaxDelay());
+				assert(sampleTime <= mDelay.getMaxDelay());
 				mTime = sampleTime;
 			}
 
@@ -52,8 +50,8 @@ namespace nap
 			 */
 			SampleValue process(SampleValue input)
 			{
-				mDelay->write(input);
-				return mDelay->read(mTime);
+				mDelay.write(input);
+				return mDelay.read(mTime);
 			}
 
 			/**
@@ -63,12 +61,12 @@ namespace nap
 			 */
 			SampleValue processInterpolating(SampleValue input)
 			{
-				mDelay->write(input);
-				return mDelay->readInterpolating(mTime);
+				mDelay.write(input);
+				return mDelay.readLinear(mTime);
 			}
 
 		private:
-			std::unique_ptr<Delay> mDelay = nullptr;
+			DelayLine<SampleValue> mDelay;
 			std::atomic<ControllerValue> mTime = 0.f;
 		};
 
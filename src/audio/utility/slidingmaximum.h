@@ -0,0 +1,86 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#pragma once
+
+#include <audio/utility/audiotypes.h>
+#include <vector>
+
+namespace nap
+{
+
+	namespace audio
+	{
+
+		/**
+		 * Maximum over a sliding window of the most recent samples, using a monotonic deque.
+		 * The deque holds the samples that can still become the maximum, in decreasing order, so every sample is pushed and popped at most once: O(1) per sample regardless of the window size.
+		 * The deque lives in a ring buffer that is allocated by reset(), process() does not allocate.
+		 */
+		class SlidingMaximum
+		{
+		public:
+			SlidingMaximum() = default;
+
+			/**
+			 * Clears the window and allocates the ring buffer. Not to be called while processing.
+			 * @param windowSize Number of most recent samples the maximum is taken over, at least 1.
+			 */
+			void reset(int windowSize)
+			{
+				mWindowSize = windowSize < 1 ? 1 : windowSize;
+				mValues.assign(mWindowSize, 0.f);
+				mPositions.assign(mWindowSize, 0);
+				mFront = 0;
+				mCount = 0;
+				mPosition = 0;
+			}
+
+			/**
+			 * Adds a sample to the window.
+			 * @param value The new sample
+			 * @return The maximum of the window including the new sample.
+			 */
+			SampleValue process(SampleValue value)
+			{
+				// Drop the oldest entry when it leaves the window
+				if (mCount > 0 && mPositions[mFront] <= mPosition - mWindowSize)
+				{
+					mFront = next(mFront);
+					mCount--;
+				}
+
+				// Drop entries from the back that can never be the maximum again
+				while (mCount > 0 && mValues[index(mCount - 1)] <= value)
+					mCount--;
+
+				auto back = index(mCount);
+				mValues[back] = value;
+				mPositions[back] = mPosition;
+				mCount++;
+				mPosition++;
+
+				return mValues[mFront];
+			}
+
+			/**
+			 * @return The number of samples the maximum is taken over.
+			 */
+			int getWindowSize() const { return mWindowSize; }
+
+		private:
+			int next(int i) const { return i + 1 == mWindowSize ? 0 : i + 1; }
+			int index(int offset) const { auto i = mFront + offset; return i >= mWindowSize ? i - mWindowSize : i; }
+
+			std::vector<SampleValue> mValues;
+			std::vector<long long> mPositions;
+			int mWindowSize = 1;
+			int mFront = 0;
+			int mCount = 0;
+			long long mPosition = 0;
+		};
+
+	}
+
+}
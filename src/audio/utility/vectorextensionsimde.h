@@ -6,6 +6,7 @@
 
 #include <utility/dllexport.h>
 
+#include <audio/utility/simde/x86/avx512.h>
 #include <audio/utility/simde/x86/avx2.h>
 #include <audio/utility/simde/x86/sse2.h>
 
@@ -66,6 +67,11 @@ namespace nap
 			value = simde_mm_loadu_ps(f);
         }
         
+        void store(float * __restrict f) const
+        {
+			simde_mm_storeu_ps(f, value);
+        }
+        
         float4 operator+(const float4 other) const
         {
 			return float4(simde_mm_add_ps(value, other.value));
@@ -151,6 +157,11 @@ namespace nap
 			value = simde_mm256_loadu_ps(f);
         }
         
+        void store(float * __restrict f) const
+        {
+			simde_mm256_storeu_ps(f, value);
+        }
+        
         float8 operator+(const float8 other) const
         {
 			return float8(simde_mm256_add_ps(value, other.value));
@@ -216,15 +227,247 @@ namespace nap
     };
     
     
+	
+	typedef simde__m512 float16_value;
+	
+    struct NAPAPI float16
+    {
+        float16_value value;
+        
+        float16()
+        {
+        }
+        
+        explicit float16(const int in_f)
+        {
+            const float f = (float)in_f;
+			
+			value = simde_mm512_set1_ps(f);
+        }
+        
+        explicit float16(const float f)
+        {
+			value = simde_mm512_set1_ps(f);
+        }
+        
+        explicit float16(const float f1, const float f2, const float f3, const float f4, const float f5, const float f6, const float f7, const float f8, const float f9, const float f10, const float f11, const float f12, const float f13, const float f14, const float f15, const float f16)
+        {
+			value = simde_mm512_set_ps(f16, f15, f14, f13, f12, f11, f10, f9, f8, f7, f6, f5, f4, f3, f2, f1);
+        }
+        
+        explicit float16(const double in_f)
+        {
+            const float f = (float)in_f;
+			
+			value = simde_mm512_set1_ps(f);
+        }
+        
+        explicit float16(float16_value in_value)
+        {
+            value = in_value;
+        }
+        
+        explicit float16(const float * __restrict f)
+        {
+			value = simde_mm512_loadu_ps(f);
+        }
+        
+        void store(float * __restrict f) const
+        {
+			simde_mm512_storeu_ps(f, value);
+        }
+        
+        float16 operator+(const float16 other) const
+        {
+			return float16(simde_mm512_add_ps(value, other.value));
+        }
+        
+        float16 operator-(const float16 other) const
+        {
+			return float16(simde_mm512_sub_ps(value, other.value));
+        }
+        
+        float16 operator*(const float16 other) const
+        {
+			return float16(simde_mm512_mul_ps(value, other.value));
+        }
+        
+        float16 operator/(const float16 other) const
+        {
+			return float16(simde_mm512_div_ps(value, other.value));
+        }
+        
+        float16 operator*(const float other) const
+        {
+            return *this * float16(other);
+        }
+        
+        float16 operator*(const int other) const
+        {
+            return *this * float16(other);
+        }
+        
+        float& operator[](const int index)
+        {
+            return reinterpret_cast<float*>(&value)[index];
+        }
+        
+        bool operator==(const float16 other)
+        {
+			return simde_mm512_cmp_ps_mask(value, other.value, SIMDE_CMP_NEQ_OQ) == 0;
+        }
+        
+        bool operator!=(const float16 other)
+        {
+			return simde_mm512_cmp_ps_mask(value, other.value, SIMDE_CMP_NEQ_OQ) != 0;
+        }
+        
+        const float& operator[](const int index) const
+        {
+            return reinterpret_cast<const float*>(&value)[index];
+        }
+    };
+    
+    
+    // Vector primitives, the scalar equivalents are in fastmath.h
+    
+    inline float4 minVec(const float4 a, const float4 b)
+    {
+        return float4(simde_mm_min_ps(a.value, b.value));
+    }
+    
+    inline float8 minVec(const float8 a, const float8 b)
+    {
+        return float8(simde_mm256_min_ps(a.value, b.value));
+    }
+    
+    inline float16 minVec(const float16 a, const float16 b)
+    {
+        return float16(simde_mm512_min_ps(a.value, b.value));
+    }
+    
+    inline float4 maxVec(const float4 a, const float4 b)
+    {
+        return float4(simde_mm_max_ps(a.value, b.value));
+    }
+    
+    inline float8 maxVec(const float8 a, const float8 b)
+    {
+        return float8(simde_mm256_max_ps(a.value, b.value));
+    }
+    
+    inline float16 maxVec(const float16 a, const float16 b)
+    {
+        return float16(simde_mm512_max_ps(a.value, b.value));
+    }
+    
+    inline float4 floorVec(const float4 value)
+    {
+        return float4(simde_mm_floor_ps(value.value));
+    }
+    
+    inline float8 floorVec(const float8 value)
+    {
+        return float8(simde_mm256_floor_ps(value.value));
+    }
+    
+    inline float16 floorVec(const float16 value)
+    {
+        return float16(simde_mm512_roundscale_ps(value.value, SIMDE_MM_FROUND_TO_NEG_INF));
+    }
+    
+    /**
+     * Returns the sum of all lanes.
+     */
+    inline float sumVec(const float4 value)
+    {
+        const simde__m128 sum = simde_mm_add_ps(value.value, simde_mm_movehl_ps(value.value, value.value));
+        return simde_mm_cvtss_f32(simde_mm_add_ss(sum, simde_mm_shuffle_ps(sum, sum, 1)));
+    }
+    
+    inline float sumVec(const float8 value)
+    {
+        return sumVec(float4(simde_mm_add_ps(simde_mm256_castps256_ps128(value.value), simde_mm256_extractf128_ps(value.value, 1))));
+    }
+    
+    inline float sumVec(const float16 value)
+    {
+        const float4 low = float4(simde_mm512_extractf32x4_ps(value.value, 0)) + float4(simde_mm512_extractf32x4_ps(value.value, 1));
+        const float4 high = float4(simde_mm512_extractf32x4_ps(value.value, 2)) + float4(simde_mm512_extractf32x4_ps(value.value, 3));
+        return sumVec(low + high);
+    }
+    
+    /**
+     * Returns value * 2^exponent. Every lane of exponent has to hold an integral value within [-126, 127].
+     */
+    inline float4 scalePow2Vec(const float4 value, const float4 exponent)
+    {
+        const simde__m128i bits = simde_mm_slli_epi32(simde_mm_add_epi32(simde_mm_cvtps_epi32(exponent.value), simde_mm_set1_epi32(127)), 23);
+        return float4(simde_mm_mul_ps(value.value, simde_mm_castsi128_ps(bits)));
+    }
+    
+    inline float8 scalePow2Vec(const float8 value, const float8 exponent)
+    {
+        const simde__m256i bits = simde_mm256_slli_epi32(simde_mm256_add_epi32(simde_mm256_cvtps_epi32(exponent.value), simde_mm256_set1_epi32(127)), 23);
+        return float8(simde_mm256_mul_ps(value.value, simde_mm256_castsi256_ps(bits)));
+    }
+    
+    inline float16 scalePow2Vec(const float16 value, const float16 exponent)
+    {
+        // Adding 1.5 * 2^23 moves the integral exponent into the low mantissa bits
+        const simde__m512i magic = simde_mm512_castps_si512(simde_mm512_set1_ps(12582912.f));
+        const simde__m512i integer = simde_mm512_sub_epi32(simde_mm512_castps_si512(simde_mm512_add_ps(exponent.value, simde_mm512_set1_ps(12582912.f))), magic);
+        const simde__m512i bits = simde_mm512_slli_epi32(simde_mm512_add_epi32(integer, simde_mm512_set1_epi32(127)), 23);
+        return float16(simde_mm512_mul_ps(value.value, simde_mm512_castsi512_ps(bits)));
+    }
+    
+    /**
+     * Splits every lane of a positive, normalized value into a mantissa within [1, 2), which is returned, and an exponent so that value = mantissa * 2^exponent.
+     */
+    inline float4 splitExponentVec(const float4 value, float4& exponent)
+    {
+        const simde__m128i bits = simde_mm_castps_si128(value.value);
+        exponent = float4(simde_mm_cvtepi32_ps(simde_mm_sub_epi32(simde_mm_srli_epi32(bits, 23), simde_mm_set1_epi32(127))));
+        return float4(simde_mm_castsi128_ps(simde_mm_or_si128(simde_mm_and_si128(bits, simde_mm_set1_epi32(0x007FFFFF)), simde_mm_set1_epi32(0x3F800000))));
+    }
+    
+    inline float8 splitExponentVec(const float8 value, float8& exponent)
+    {
+        const simde__m256i bits = simde_mm256_castps_si256(value.value);
+        exponent = float8(simde_mm256_cvtepi32_ps(simde_mm256_sub_epi32(simde_mm256_srli_epi32(bits, 23), simde_mm256_set1_epi32(127))));
+        return float8(simde_mm256_castsi256_ps(simde_mm256_or_si256(simde_mm256_and_si256(bits, simde_mm256_set1_epi32(0x007FFFFF)), simde_mm256_set1_epi32(0x3F800000))));
+    }
+    
+    inline float16 splitExponentVec(const float16 value, float16& exponent)
+    {
+        const simde__m512i bits = simde_mm512_castps_si512(value.value);
+        exponent = float16(simde_mm512_sub_ps(simde_mm512_cvtepu32_ps(simde_mm512_srli_epi32(bits, 23)), simde_mm512_set1_ps(127.f)));
+        return float16(simde_mm512_castsi512_ps(simde_mm512_or_si512(simde_mm512_and_si512(bits, simde_mm512_set1_epi32(0x007FFFFF)), simde_mm512_set1_epi32(0x3F800000))));
+    }
+    
+    
     float4 NAPAPI tanVec(const float4 value);
     float8 NAPAPI tanVec(const float8 value);
+    float16 NAPAPI tanVec(const float16 value);
     float4 NAPAPI sinVec(const float4 value);
     float8 NAPAPI sinVec(const float8 value);
+    float16 NAPAPI sinVec(const float16 value);
     float4 NAPAPI cosVec(const float4 value);
     float8 NAPAPI cosVec(const float8 value);
+    float16 NAPAPI cosVec(const float16 value);
 	float NAPAPI powVec(const float value, const float power);
     float4 NAPAPI powVec(const float4 value, const float4 power);
     float8 NAPAPI powVec(const float8 value, const float8 power);
+    float16 NAPAPI powVec(const float16 value, const float16 power);
+    float4 NAPAPI expVec(const float4 value);
+    float8 NAPAPI expVec(const float8 value);
+    float16 NAPAPI expVec(const float16 value);
+    float4 NAPAPI exp2Vec(const float4 value);
+    float8 NAPAPI exp2Vec(const float8 value);
+    float16 NAPAPI exp2Vec(const float16 value);
+    float4 NAPAPI log2Vec(const float4 value);
+    float8 NAPAPI log2Vec(const float8 value);
+    float16 NAPAPI log2Vec(const float16 value);
 
 	inline void NAPAPI vectorAdd(float8 * __restrict destination, const float8 * __restrict a, const int vectorSize)
     {